@@ -0,0 +1,379 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+//! A tiny benchmark harness: timing, command line and a machine-readable report. Every result is a line
+//! of the report; JSON lines (the default) or CSV, so that runs of different versions of the library can
+//! be diffed and plotted.
+namespace bench
+{
+    //! Stops the optimiser from throwing away computation of a value; the value is considered read.
+    template <class T>
+    inline void keep(const T& value)
+    {
+#ifdef _MSC_VER
+        static const volatile char* s_sink;
+        s_sink = reinterpret_cast<const volatile char*>(&value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "m"(value) : "memory");
+#endif
+    }
+
+    //! Stops the optimiser from assuming anything about a value; the value is considered written.
+    template <class T>
+    inline void opaque(T& value)
+    {
+#ifdef _MSC_VER
+        static volatile char* s_sink;
+        s_sink = reinterpret_cast<volatile char*>(&value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : "+m"(value) : : "memory");
+#endif
+    }
+
+    //! A cycle counter: the time stamp counter where there is one, nanoseconds otherwise. Only differences of
+    //! values read on the same thread mean anything.
+    inline uint64_t cycles()
+    {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64)) || defined(__i386__) || defined(__x86_64__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    //! Command line options, shared by all benchmarks. Executables with options of their own derive from it
+    //! and override parse_extra and usage_extra.
+    struct options
+    {
+        //! Only benchmarks whose name or type contain this run.
+        std::string filter;
+        //! Copied to every line of the report, e.g. a version of the library.
+        std::string tag;
+        //! Time each measurement is repeated for, at least.
+        double min_time_ms;
+        //! Repetitions of a measurement; the fastest one is reported.
+        unsigned repetitions;
+        bool csv;
+
+        options()
+            : min_time_ms(20)
+            , repetitions(5)
+            , csv(false)
+        {}
+
+        virtual ~options()
+        {}
+
+        //! Returns false (after printing usage) if the arguments are not understood.
+        bool parse(int argc, char* argv[])
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string arg = argv[i];
+                bool has_value = i + 1 < argc;
+                if (arg == "--filter" && has_value)
+                {
+                    filter = argv[++i];
+                }
+                else if (arg == "--tag" && has_value)
+                {
+                    tag = argv[++i];
+                }
+                else if (arg == "--min-time" && has_value)
+                {
+                    min_time_ms = std::atof(argv[++i]);
+                }
+                else if (arg == "--repetitions" && has_value)
+                {
+                    repetitions = std::max(1, std::atoi(argv[++i]));
+                }
+                else if (arg == "--csv")
+                {
+                    csv = true;
+                }
+                else if (!has_value || !parse_extra(arg, argv[i + 1]))
+                {
+                    std::cerr << "usage: " << argv[0] << " [--filter text] [--tag text] [--min-time ms] [--repetitions n] [--csv]" << usage_extra() << std::endl;
+                    return false;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            return true;
+        }
+
+        bool matches(const std::string& name, const std::string& type) const
+        {
+            return filter.empty() || name.find(filter) != std::string::npos || type.find(filter) != std::string::npos;
+        }
+
+    protected:
+        //! Parses an option with a value this class does not know; returns false if it is not understood.
+        virtual bool parse_extra(const std::string& /*arg*/, const char* /*value*/)
+        {
+            return false;
+        }
+
+        //! Usage of options parse_extra understands, e.g. " [--frames n]".
+        virtual std::string usage_extra() const
+        {
+            return std::string();
+        }
+    };
+
+    //! Nanoseconds per iteration: of the fastest repetition, and how much slower the slowest one was.
+    struct timing
+    {
+        double best_ns;
+        double spread_ns;
+    };
+
+    //! Runs func(iterations) (which needs to do that many iterations of something) for long enough to be
+    //! measurable, as many times as there are repetitions.
+    template <class Func>
+    timing time_iterations(const options& opts, Func func)
+    {
+        typedef std::chrono::steady_clock clock;
+
+        // find out how many iterations take min_time
+        size_t iterations = 16;
+        for (;;)
+        {
+            clock::time_point start = clock::now();
+            func(iterations);
+            double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            if (ms >= opts.min_time_ms || iterations >= (size_t(1) << 40))
+            {
+                break;
+            }
+            iterations = ms <= opts.min_time_ms / 16 ? iterations * 16 : static_cast<size_t>(iterations * opts.min_time_ms * 1.2 / ms) + 1;
+        }
+
+        double best = std::numeric_limits<double>::max();
+        double worst = 0;
+        for (unsigned i = 0; i < opts.repetitions; ++i)
+        {
+            clock::time_point start = clock::now();
+            func(iterations);
+            double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            best = std::min(best, ns / iterations);
+            worst = std::max(worst, ns / iterations);
+        }
+        return timing{ best, worst - best };
+    }
+
+    //! A line of the report: named fields, in order. Numbers that do not apply are NaN, reported as null
+    //! (or an empty CSV cell).
+    class record
+    {
+    public:
+        record& text(const std::string& name, const std::string& value)
+        {
+            m_fields.push_back(field{ name, quoted_json(value), quoted_csv(value) });
+            return *this;
+        }
+
+        record& number(const std::string& name, double value, int precision = 4)
+        {
+            std::string formatted = format(value, precision);
+            m_fields.push_back(field{ name, formatted.empty() ? "null" : formatted, formatted });
+            return *this;
+        }
+
+        record& integer(const std::string& name, long long value)
+        {
+            std::string formatted = std::to_string(value);
+            m_fields.push_back(field{ name, formatted, formatted });
+            return *this;
+        }
+
+        std::string json() const
+        {
+            std::string result = "{";
+            for (const field& f : m_fields)
+            {
+                result += (result.size() > 1 ? ",\"" : "\"") + f.name + "\":" + f.json;
+            }
+            return result + "}";
+        }
+
+        std::string csv_header() const
+        {
+            std::string result;
+            for (const field& f : m_fields)
+            {
+                result += (result.empty() ? "" : ",") + f.name;
+            }
+            return result;
+        }
+
+        std::string csv() const
+        {
+            std::string result;
+            for (size_t i = 0; i < m_fields.size(); ++i)
+            {
+                result += (i ? "," : "") + m_fields[i].csv;
+            }
+            return result;
+        }
+
+    private:
+        struct field
+        {
+            std::string name;
+            std::string json;
+            std::string csv;
+        };
+
+        static std::string format(double value, int precision)
+        {
+            if (value != value)
+            {
+                return std::string();
+            }
+            std::ostringstream s;
+            s.precision(precision);
+            s << std::fixed << value;
+            return s.str();
+        }
+
+        static std::string quoted_json(const std::string& text)
+        {
+            std::string result = "\"";
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    result += '\\';
+                }
+                result += c;
+            }
+            return result + "\"";
+        }
+
+        static std::string quoted_csv(const std::string& text)
+        {
+            if (text.find_first_of(",\"") == std::string::npos)
+            {
+                return text;
+            }
+            std::string result = "\"";
+            for (char c : text)
+            {
+                if (c == '"')
+                {
+                    result += '"';
+                }
+                result += c;
+            }
+            return result + "\"";
+        }
+
+        std::vector<field> m_fields;
+    };
+
+    //! A measurement of a builtin; see builtins.cpp.
+    struct result
+    {
+        std::string suite;
+        std::string name;
+        std::string backend;
+        std::string type;
+        //! Values processed by a call, i.e. SIMD lanes times components.
+        unsigned values;
+        //! Nanoseconds per call when calls are independent.
+        double throughput_ns;
+        //! Nanoseconds per call when each one needs the result of the previous one.
+        double latency_ns;
+        //! Same as throughput_ns and latency_ns, with the harness' cost still in.
+        double raw_throughput_ns;
+        double raw_latency_ns;
+        //! Whether throughput_ns or latency_ns is smaller than the spread of repetitions, i.e. too small to tell
+        //! from the harness' cost.
+        bool throughput_below_noise;
+        bool latency_below_noise;
+
+        result()
+            : values(1)
+            , throughput_ns(std::numeric_limits<double>::quiet_NaN())
+            , latency_ns(std::numeric_limits<double>::quiet_NaN())
+            , raw_throughput_ns(std::numeric_limits<double>::quiet_NaN())
+            , raw_latency_ns(std::numeric_limits<double>::quiet_NaN())
+            , throughput_below_noise(false)
+            , latency_below_noise(false)
+        {}
+
+        record to_record() const
+        {
+            record r;
+            r.text("suite", suite).text("name", name).text("backend", backend).text("type", type).integer("values", values)
+                .number("throughput_ns", throughput_ns).number("latency_ns", latency_ns)
+                .number("raw_throughput_ns", raw_throughput_ns).number("raw_latency_ns", raw_latency_ns)
+                .integer("throughput_below_noise", throughput_below_noise ? 1 : 0).integer("latency_below_noise", latency_below_noise ? 1 : 0);
+            return r;
+        }
+    };
+
+    //! Writes records, each with the tag of options appended. All the records of a CSV report need the same
+    //! fields; the header is written with the first one.
+    class report
+    {
+    public:
+        explicit report(const options& opts, std::ostream& out = std::cout)
+            : m_options(opts)
+            , m_out(out)
+            , m_empty(true)
+        {}
+
+        void add(record r)
+        {
+            r.text("tag", m_options.tag);
+            if (m_options.csv)
+            {
+                if (m_empty)
+                {
+                    m_out << r.csv_header() << std::endl;
+                }
+                m_out << r.csv() << std::endl;
+            }
+            else
+            {
+                m_out << r.json() << std::endl;
+            }
+            m_empty = false;
+        }
+
+        void add(const result& r)
+        {
+            add(r.to_record());
+        }
+
+    private:
+        const options& m_options;
+        std::ostream& m_out;
+        bool m_empty;
+    };
+}
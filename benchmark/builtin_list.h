@@ -0,0 +1,112 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// The builtins; see builtins.h. Included once per executable, after builtins::registrar is defined.
+
+// angle and trigonometry
+CXXSWIZZLE_BUILTIN(radians, scalars | vectors, -4, 4, radians(a))
+CXXSWIZZLE_BUILTIN(degrees, scalars | vectors, -4, 4, degrees(a))
+CXXSWIZZLE_BUILTIN(sin, scalars | vectors, -4, 4, sin(a))
+CXXSWIZZLE_BUILTIN(cos, scalars | vectors, -4, 4, cos(a))
+CXXSWIZZLE_BUILTIN(tan, scalars | vectors, -1, 1, tan(a))
+CXXSWIZZLE_BUILTIN(asin, scalars | vectors, -1, 1, asin(a))
+CXXSWIZZLE_BUILTIN(acos, scalars | vectors, -1, 1, acos(a))
+CXXSWIZZLE_BUILTIN(atan, scalars | vectors, -4, 4, atan(a))
+CXXSWIZZLE_BUILTIN(atan2, scalars | vectors, -4, 4, atan(a, b))
+
+// exponential
+CXXSWIZZLE_BUILTIN(pow, scalars | vectors, 0.1f, 4, pow(a, b))
+CXXSWIZZLE_BUILTIN(exp, scalars | vectors, -4, 4, exp(a))
+CXXSWIZZLE_BUILTIN(log, scalars | vectors, 0.1f, 4, log(a))
+CXXSWIZZLE_BUILTIN(exp2, scalars | vectors, -4, 4, exp2(a))
+CXXSWIZZLE_BUILTIN(log2, scalars | vectors, 0.1f, 4, log2(a))
+CXXSWIZZLE_BUILTIN(sqrt, scalars | vectors, 0.1f, 4, sqrt(a))
+CXXSWIZZLE_BUILTIN(inversesqrt, scalars | vectors, 0.1f, 4, inversesqrt(a))
+
+// common
+CXXSWIZZLE_BUILTIN(abs, scalars | vectors, -4, 4, abs(a))
+CXXSWIZZLE_BUILTIN(sign, scalars | vectors, -4, 4, sign(a))
+CXXSWIZZLE_BUILTIN(floor, scalars | vectors, -4, 4, floor(a))
+CXXSWIZZLE_BUILTIN(ceil, scalars | vectors, -4, 4, ceil(a))
+CXXSWIZZLE_BUILTIN(trunc, scalars | vectors, -4, 4, trunc(a))
+CXXSWIZZLE_BUILTIN(round, scalars | vectors, -4, 4, round(a))
+CXXSWIZZLE_BUILTIN(roundEven, scalars | vectors, -4, 4, roundEven(a))
+CXXSWIZZLE_BUILTIN(fract, scalars | vectors, -4, 4, fract(a))
+CXXSWIZZLE_BUILTIN(mod, scalars | vectors, 0.5f, 4, mod(a, b))
+CXXSWIZZLE_BUILTIN_NAMED(modf, "modf(a, b)", scalars | vectors, -4, 4, modf_copy(a, b))
+CXXSWIZZLE_BUILTIN(min, scalars | vectors, -4, 4, min(a, b))
+CXXSWIZZLE_BUILTIN(max, scalars | vectors, -4, 4, max(a, b))
+CXXSWIZZLE_BUILTIN(clamp, scalars | vectors, -4, 4, clamp(a, b, c))
+CXXSWIZZLE_BUILTIN(mix, scalars | vectors, -4, 4, mix(a, b, c))
+CXXSWIZZLE_BUILTIN(step, scalars | vectors, -4, 4, step(a, b))
+CXXSWIZZLE_BUILTIN(smoothstep, scalars | vectors, -4, 4, smoothstep(b, c, a))
+CXXSWIZZLE_BUILTIN(fma, scalars | vectors, -4, 4, fma(a, b, c))
+CXXSWIZZLE_BUILTIN(isnan, scalars | vectors, -4, 4, isnan(a))
+CXXSWIZZLE_BUILTIN(isinf, scalars | vectors, -4, 4, isinf(a))
+
+// geometric
+CXXSWIZZLE_BUILTIN(length, scalars | vectors, -4, 4, length(a))
+CXXSWIZZLE_BUILTIN(distance, scalars | vectors, -4, 4, distance(a, b))
+CXXSWIZZLE_BUILTIN(dot, scalars | vectors, -4, 4, dot(a, b))
+CXXSWIZZLE_BUILTIN(cross, scalars | vectors, -4, 4, cross(a, b))
+CXXSWIZZLE_BUILTIN(normalize, scalars | vectors, 0.5f, 4, normalize(a))
+CXXSWIZZLE_BUILTIN(faceforward, scalars | vectors, -4, 4, faceforward(a, b, c))
+CXXSWIZZLE_BUILTIN(reflect, scalars | vectors, -4, 4, reflect(a, b))
+CXXSWIZZLE_BUILTIN(refract, scalars | vectors, -1, 1, refract(a, b, 0.9f))
+CXXSWIZZLE_BUILTIN(outerProduct, scalars | vectors, -4, 4, outerProduct(a, b))
+
+// bits and packing
+CXXSWIZZLE_BUILTIN(floatBitsToInt, scalars | vectors, -4, 4, floatBitsToInt(a))
+CXXSWIZZLE_BUILTIN(floatBitsToUint, scalars | vectors, -4, 4, floatBitsToUint(a))
+CXXSWIZZLE_BUILTIN(intBitsToFloat, scalars | vectors, -4, 4, intBitsToFloat(floatBitsToInt(a)))
+CXXSWIZZLE_BUILTIN(uintBitsToFloat, scalars | vectors, -4, 4, uintBitsToFloat(floatBitsToUint(a)))
+CXXSWIZZLE_BUILTIN(packUnorm4x8, scalars | vectors, 0, 1, packUnorm4x8(a))
+CXXSWIZZLE_BUILTIN(unpackUnorm4x8, scalars | vectors, 0, 1, unpackUnorm4x8(packUnorm4x8(a)))
+CXXSWIZZLE_BUILTIN(packHalf2x16, scalars | vectors, -4, 4, packHalf2x16(a))
+CXXSWIZZLE_BUILTIN(unpackHalf2x16, scalars | vectors, -4, 4, unpackHalf2x16(packHalf2x16(a)))
+
+// relational
+CXXSWIZZLE_BUILTIN(lessThan, scalars | vectors, -4, 4, lessThan(a, b))
+CXXSWIZZLE_BUILTIN(lessThanEqual, scalars | vectors, -4, 4, lessThanEqual(a, b))
+CXXSWIZZLE_BUILTIN(greaterThan, scalars | vectors, -4, 4, greaterThan(a, b))
+CXXSWIZZLE_BUILTIN(greaterThanEqual, scalars | vectors, -4, 4, greaterThanEqual(a, b))
+CXXSWIZZLE_BUILTIN(equal, scalars | vectors, -4, 4, equal(a, b))
+CXXSWIZZLE_BUILTIN(notEqual, scalars | vectors, -4, 4, notEqual(a, b))
+CXXSWIZZLE_BUILTIN(any, scalars | vectors, -4, 4, any(lessThan(a, b)))
+CXXSWIZZLE_BUILTIN(all, scalars | vectors, -4, 4, all(lessThan(a, b)))
+CXXSWIZZLE_BUILTIN(not, scalars | vectors, -4, 4, not(lessThan(a, b)))
+
+// operators
+CXXSWIZZLE_BUILTIN(add, scalars | vectors | matrices, -4, 4, a + b)
+CXXSWIZZLE_BUILTIN(sub, scalars | vectors | matrices, -4, 4, a - b)
+CXXSWIZZLE_BUILTIN(mul, scalars | vectors | matrices, -4, 4, a * b)
+CXXSWIZZLE_BUILTIN(div, scalars | vectors | matrices, 0.5f, 4, a / b)
+CXXSWIZZLE_BUILTIN(neg, scalars | vectors | matrices, -4, 4, -a)
+CXXSWIZZLE_BUILTIN(add_scalar, scalars | vectors | matrices, -4, 4, a + 2.0f)
+CXXSWIZZLE_BUILTIN(scalar_sub, scalars | vectors | matrices, -4, 4, 2.0f - a)
+CXXSWIZZLE_BUILTIN(mul_scalar, scalars | vectors | matrices, -4, 4, a * 2.0f)
+CXXSWIZZLE_BUILTIN(scalar_div, scalars | vectors | matrices, 0.5f, 4, 2.0f / a)
+CXXSWIZZLE_BUILTIN(eq, scalars | vectors | matrices, -4, 4, a == b)
+CXXSWIZZLE_BUILTIN(neq, scalars | vectors | matrices, -4, 4, a != b)
+
+// matrices
+CXXSWIZZLE_BUILTIN_NAMED(mul_column, "a * b[0]", matrices, -1, 1, mul_column(a, b))
+CXXSWIZZLE_BUILTIN_NAMED(mul_row, "b[0] * a", matrices, -1, 1, mul_row(a, b))
+CXXSWIZZLE_BUILTIN(transpose, matrices, -1, 1, transpose(a))
+CXXSWIZZLE_BUILTIN(determinant, matrices, -1, 1, determinant(a))
+CXXSWIZZLE_BUILTIN(inverse, matrices, -1, 1, inverse(a))
+
+// swizzles: reads, writes and arithmetic on proxies
+CXXSWIZZLE_BUILTIN(read_x, vectors, -4, 4, a.x)
+CXXSWIZZLE_BUILTIN(read_yx, vectors, -4, 4, a.yx)
+CXXSWIZZLE_BUILTIN(read_zyx, vectors, -4, 4, a.zyx)
+CXXSWIZZLE_BUILTIN(read_wzyx, vectors, -4, 4, a.wzyx)
+CXXSWIZZLE_BUILTIN(read_xxxx, vectors, -4, 4, a.xxxx)
+CXXSWIZZLE_BUILTIN_NAMED(write_yx, "a.yx = b.xy", vectors, -4, 4, assign_yx(a, b))
+CXXSWIZZLE_BUILTIN_NAMED(write_zyx, "a.zyx = b.xyz", vectors, -4, 4, assign_zyx(a, b))
+CXXSWIZZLE_BUILTIN_NAMED(write_wzyx, "a.wzyx = b.xyzw", vectors, -4, 4, assign_wzyx(a, b))
+CXXSWIZZLE_BUILTIN_NAMED(add_assign_zy, "a.zy += b.xx", vectors, -4, 4, add_assign_zy(a, b))
+CXXSWIZZLE_BUILTIN_NAMED(mul_assign_y, "a.y *= b.x", vectors, -4, 4, mul_assign_y(a, b))
+CXXSWIZZLE_BUILTIN(proxy_add, vectors, -4, 4, a.yx + b.xy)
+CXXSWIZZLE_BUILTIN(proxy_mul_vec, vectors, -4, 4, a.zyx * b.xyz)
+CXXSWIZZLE_BUILTIN(proxy_dot, vectors, -4, 4, dot(a.zyx, b.xyz))
@@ -0,0 +1,372 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Throughput and latency of GLSL builtins, operators and swizzles, for float (benchmark_scalar) or
+// vc_float (benchmark_simd) scalars, their vectors and square matrices. Each builtin of builtin_list.h is
+// measured for every type it compiles for.
+//
+// Throughput is measured with 8 independent calls in flight, latency with a chain of calls where the
+// arguments of each one depend on the result of the previous one. The harness' own cost (loading the
+// arguments and consuming the result) is measured for each type of arguments and of results and
+// subtracted: with the expression "a" for results of the arguments' type, otherwise by replaying results
+// computed in advance. Replayed results do not depend on the previous call, same as results which do
+// not carry the dependency on to the next call (e.g. booleans turned into selects or branches).
+
+#if defined(USE_SIMD)
+#include "use_simd.h"
+static const char c_backend[] = "vc_float";
+#else
+#include "use_scalar.h"
+static const char c_backend[] = "float";
+#endif
+
+#include <functional>
+#include <random>
+#include "benchmark.h"
+#include "builtins.h"
+
+namespace builtins
+{
+    // random values in [lo;hi)
+
+    typedef std::mt19937 random_engine;
+
+    inline void randomize(float& value, random_engine& rng, float lo, float hi)
+    {
+        value = std::uniform_real_distribution<float>(lo, hi)(rng);
+    }
+
+#ifdef USE_SIMD
+    inline void randomize(float_type& value, random_engine& rng, float lo, float hi)
+    {
+        raw_float_type lanes;
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            lanes[i] = std::uniform_real_distribution<float>(lo, hi)(rng);
+        }
+        value = lanes;
+    }
+#endif
+
+    template <class T, size_t N>
+    void randomize(swizzle::glsl::vector<T, N>& value, random_engine& rng, float lo, float hi)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            randomize(value[i], rng, lo, hi);
+        }
+    }
+
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M>
+    void randomize(swizzle::glsl::matrix<VectorType, T, N, M>& value, random_engine& rng, float lo, float hi)
+    {
+        for (size_t i = 0; i < M; ++i)
+        {
+            randomize(value[i], rng, lo, hi);
+        }
+    }
+
+    // Results are reduced to a scalar: the sum of their components, bools counting as 1. The chain of
+    // calls depends on all the components that way, so none of them can be optimised away; the cost of
+    // reducing is part of the harness' overhead for the type of results.
+
+    inline float reduce(float result)
+    {
+        return result;
+    }
+
+#ifdef USE_SIMD
+    inline float_type reduce(const float_type& result)
+    {
+        return result;
+    }
+
+    inline float_type reduce(const swizzle::glsl::vc_uint<>& result)
+    {
+        return uintToFloat(result);
+    }
+
+    inline float_type reduce(const swizzle::glsl::vc_int<>& result)
+    {
+        return float_type(::Vc::float_v(static_cast< ::Vc::int_v >(result)));
+    }
+#endif
+
+    inline float reduce(bool result)
+    {
+        return result ? 1.0f : 0.0f;
+    }
+
+    inline float reduce(unsigned result)
+    {
+        return static_cast<float>(result & 1);
+    }
+
+    inline float reduce(int result)
+    {
+        return static_cast<float>(result & 1);
+    }
+
+    template <class T, size_t N>
+    inline auto reduce(const swizzle::glsl::vector<T, N>& result) -> decltype(reduce(result[0]))
+    {
+        auto sum = reduce(result[0]);
+        for (size_t i = 1; i < N; ++i)
+        {
+            sum += reduce(result[i]);
+        }
+        return sum;
+    }
+
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M>
+    inline T reduce(const swizzle::glsl::matrix<VectorType, T, N, M>& result)
+    {
+        T sum = reduce(result[0]);
+        for (size_t i = 1; i < M; ++i)
+        {
+            sum += reduce(result[i]);
+        }
+        return sum;
+    }
+
+    //! Proxies (swizzles) are reduced as their vectors.
+    template <class Proxy>
+    inline auto reduce(const Proxy& result) -> decltype(reduce(result.decay()))
+    {
+        return reduce(result.decay());
+    }
+
+    //! Benchmarks, in order of definition.
+    std::vector<std::function<void(const bench::options&, bench::report&)>>& registry()
+    {
+        static std::vector<std::function<void(const bench::options&, bench::report&)>> s_registry;
+        return s_registry;
+    }
+
+    //! What a result is reduced as: proxies as their vectors, anything else as it is.
+    template <class T>
+    inline auto stored_result(const T& result, int) -> decltype(result.decay())
+    {
+        return result.decay();
+    }
+
+    template <class T>
+    inline T stored_result(const T& result, long)
+    {
+        return result;
+    }
+
+    //! Calls of Benchmark, with the j-th arguments or ones depending on the previous call.
+    template <class Benchmark>
+    struct call
+    {
+        template <class V>
+        auto operator()(size_t, const V& a, const V& b, const V& c) const -> decltype(Benchmark::eval(a, b, c))
+        {
+            return Benchmark::eval(a, b, c);
+        }
+    };
+
+    //! The harness alone, for results of the arguments' type.
+    struct identity
+    {
+        template <class V>
+        const V& operator()(size_t, const V& a, const V&, const V&) const
+        {
+            return a;
+        }
+    };
+
+    //! The harness alone, for results of another type: the j-th result computed in advance.
+    template <class R>
+    struct replay
+    {
+        const R* results;
+
+        template <class V>
+        const R& operator()(size_t j, const V&, const V&, const V&) const
+        {
+            return results[j];
+        }
+    };
+
+    template <class Eval, class V>
+    bench::timing measure_throughput(const bench::options& opts, Eval eval, const V (&a)[16], const V (&b)[16], const V (&c)[16])
+    {
+        typedef typename scalar_of<V>::type scalar_type;
+        return bench::time_iterations(opts, [&](size_t iterations)
+        {
+            scalar_type zero(0.0f);
+            bench::opaque(zero);
+            scalar_type acc[8] = { zero, zero, zero, zero, zero, zero, zero, zero };
+            for (size_t i = 0; i < iterations; i += 8)
+            {
+                for (size_t k = 0; k < 8; ++k)
+                {
+                    size_t j = (i + k) & 15;
+                    acc[k] = acc[k] + reduce(eval(j, a[j], b[j], c[j])) * zero;
+                }
+            }
+            for (size_t k = 0; k < 8; ++k)
+            {
+                bench::keep(acc[k]);
+            }
+        });
+    }
+
+    template <class Eval, class V>
+    bench::timing measure_latency(const bench::options& opts, Eval eval, const V (&a)[16], const V (&b)[16], const V (&c)[16])
+    {
+        typedef typename scalar_of<V>::type scalar_type;
+        return bench::time_iterations(opts, [&](size_t iterations)
+        {
+            scalar_type zero(0.0f);
+            bench::opaque(zero);
+            V x = a[0];
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                size_t j = i & 15;
+                x = a[j] + reduce(eval(j, x, b[j], c[j])) * zero;
+            }
+            bench::keep(x);
+        });
+    }
+
+    //! The harness' cost for arguments of V and results of R, measured once.
+    struct overhead
+    {
+        bench::timing throughput;
+        bench::timing latency;
+    };
+
+    template <class V, class R>
+    overhead measure_overhead(const bench::options& opts, const V (&a)[16], const R (&)[16], std::true_type)
+    {
+        overhead result = { measure_throughput(opts, identity(), a, a, a), measure_latency(opts, identity(), a, a, a) };
+        return result;
+    }
+
+    template <class V, class R>
+    overhead measure_overhead(const bench::options& opts, const V (&a)[16], const R (&results)[16], std::false_type)
+    {
+        replay<R> eval = { results };
+        overhead result = { measure_throughput(opts, eval, a, a, a), measure_latency(opts, eval, a, a, a) };
+        return result;
+    }
+
+    //! results are of a builtin called with the arguments; only their type matters.
+    template <class V, class R>
+    const overhead& overhead_of(const bench::options& opts, const V (&a)[16], const R (&results)[16])
+    {
+        static overhead s_overhead = measure_overhead(opts, a, results, std::is_same<V, R>());
+        return s_overhead;
+    }
+
+    //! Time of a builtin less the harness' cost, below the noise floor if the difference is within the
+    //! spread of either measurement.
+    inline void subtract(const bench::timing& measured, const bench::timing& cost, double& raw_ns, double& ns, bool& below_noise)
+    {
+        raw_ns = measured.best_ns;
+        ns = measured.best_ns - cost.best_ns;
+        below_noise = ns <= measured.spread_ns + cost.spread_ns;
+    }
+
+    //! Measures Benchmark for V, if it compiles for V.
+    template <class Benchmark, class V>
+    auto run(const bench::options& opts, bench::report& report, const char* backend, const char* type, int)
+        -> decltype(std::declval<const V&>() + reduce(Benchmark::eval(std::declval<const V&>(), std::declval<const V&>(), std::declval<const V&>())) * std::declval<const typename scalar_of<V>::type&>(), void())
+    {
+        typedef decltype(stored_result(Benchmark::eval(std::declval<const V&>(), std::declval<const V&>(), std::declval<const V&>()), 0)) result_type;
+
+        if (!opts.matches(Benchmark::name(), type))
+        {
+            return;
+        }
+
+        V a[16], b[16], c[16];
+        result_type results[16];
+        random_engine rng(1);
+        for (size_t i = 0; i < 16; ++i)
+        {
+            randomize(a[i], rng, Benchmark::lo(), Benchmark::hi());
+            randomize(b[i], rng, Benchmark::lo(), Benchmark::hi());
+            randomize(c[i], rng, Benchmark::lo(), Benchmark::hi());
+            results[i] = stored_result(Benchmark::eval(a[i], b[i], c[i]), 0);
+        }
+
+        const overhead& cost = overhead_of(opts, a, results);
+
+        bench::result result;
+        result.suite = "builtins";
+        result.name = Benchmark::name();
+        result.backend = backend;
+        result.type = type;
+        result.values = static_cast<unsigned>(values_of<V>::value * (std::is_same<typename scalar_of<V>::type, float>::value ? 1 : scalar_count));
+        subtract(measure_throughput(opts, call<Benchmark>(), a, b, c), cost.throughput, result.raw_throughput_ns, result.throughput_ns, result.throughput_below_noise);
+        subtract(measure_latency(opts, call<Benchmark>(), a, b, c), cost.latency, result.raw_latency_ns, result.latency_ns, result.latency_below_noise);
+        report.add(result);
+    }
+
+    template <class Benchmark, class V>
+    void run(const bench::options&, bench::report&, const char*, const char*, long)
+    {
+        // not available for V
+    }
+
+    template <class Benchmark, class V>
+    void run_if(const bench::options& opts, bench::report& report, const char* backend, const char* type, std::true_type)
+    {
+        run<Benchmark, V>(opts, report, backend, type, 0);
+    }
+
+    template <class Benchmark, class V>
+    void run_if(const bench::options&, bench::report&, const char*, const char*, std::false_type)
+    {}
+
+    template <class Benchmark, class T>
+    void run_types(const bench::options& opts, bench::report& report, const char* backend)
+    {
+        typedef std::integral_constant<bool, (Benchmark::kinds & scalars) != 0> on_scalars;
+        typedef std::integral_constant<bool, (Benchmark::kinds & vectors) != 0> on_vectors;
+        typedef std::integral_constant<bool, (Benchmark::kinds & matrices) != 0> on_matrices;
+
+        run_if<Benchmark, T>(opts, report, backend, "float", on_scalars());
+        run_if<Benchmark, typename types<T>::vec1>(opts, report, backend, "vec1", on_vectors());
+        run_if<Benchmark, typename types<T>::vec2>(opts, report, backend, "vec2", on_vectors());
+        run_if<Benchmark, typename types<T>::vec3>(opts, report, backend, "vec3", on_vectors());
+        run_if<Benchmark, typename types<T>::vec4>(opts, report, backend, "vec4", on_vectors());
+        run_if<Benchmark, typename types<T>::mat2>(opts, report, backend, "mat2", on_matrices());
+        run_if<Benchmark, typename types<T>::mat3>(opts, report, backend, "mat3", on_matrices());
+        run_if<Benchmark, typename types<T>::mat4>(opts, report, backend, "mat4", on_matrices());
+    }
+
+    template <class Benchmark>
+    struct registrar
+    {
+        registrar()
+        {
+            registry().push_back([](const bench::options& opts, bench::report& report)
+            {
+                run_types<Benchmark, float_type>(opts, report, c_backend);
+            });
+        }
+    };
+}
+
+#include "builtin_list.h"
+
+int main(int argc, char* argv[])
+{
+    bench::options opts;
+    if (!opts.parse(argc, argv))
+    {
+        return 1;
+    }
+
+    bench::report report(opts);
+    for (auto& benchmark : builtins::registry())
+    {
+        benchmark(opts, report);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// GLSL builtins, operators and swizzles, as expressions of a, b and c: values of a scalar, vector or
+// matrix type. The list (builtin_list.h) is shared by the benchmark and the equivalence report; each
+// of them defines builtins::registrar<Builtin> before including it, which is instantiated for every
+// entry. Builtin has:
+//   static const int kinds;            - kinds of types to try it with
+//   static const char* name();         - the expression
+//   static float lo(), hi();           - range of arguments' components
+//   static auto eval(a, b, c);         - the expression, for any type it compiles for
+#pragma once
+
+#include <swizzle/glsl/vector.h>
+#include <swizzle/glsl/matrix.h>
+
+namespace builtins
+{
+    #include <swizzle/glsl/vector_functions.h>
+
+    template <class T> struct types
+    {
+        typedef swizzle::glsl::vector<T, 1> vec1;
+        typedef swizzle::glsl::vector<T, 2> vec2;
+        typedef swizzle::glsl::vector<T, 3> vec3;
+        typedef swizzle::glsl::vector<T, 4> vec4;
+        typedef swizzle::glsl::matrix<swizzle::glsl::vector, T, 2, 2> mat2;
+        typedef swizzle::glsl::matrix<swizzle::glsl::vector, T, 3, 3> mat3;
+        typedef swizzle::glsl::matrix<swizzle::glsl::vector, T, 4, 4> mat4;
+    };
+
+    //! Scalar type of values.
+    template <class V> struct scalar_of { typedef V type; };
+    template <class T, size_t N> struct scalar_of<swizzle::glsl::vector<T, N>> { typedef T type; };
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M> struct scalar_of<swizzle::glsl::matrix<VectorType, T, N, M>> { typedef T type; };
+
+    //! Count of floats in a value.
+    template <class V> struct values_of { static const unsigned value = 1; };
+    template <class T, size_t N> struct values_of<swizzle::glsl::vector<T, N>> { static const unsigned value = N; };
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M> struct values_of<swizzle::glsl::matrix<VectorType, T, N, M>> { static const unsigned value = N * M; };
+
+    //! Kinds of types a builtin is tried with. Builtins fail to compile (rather than to be found) for
+    //! matrices, hence this needs to be said up front.
+    enum kinds
+    {
+        scalars = 1,
+        vectors = 2,
+        matrices = 4,
+    };
+
+    // helpers for builtins with out parameters, matrix products and assignments
+
+    template <class M>
+    auto mul_column(const M& m, const M& other) -> typename M::column_type
+    {
+        return m * other[0];
+    }
+
+    template <class M>
+    auto mul_row(const M& m, const M& other) -> typename M::row_type
+    {
+        return other[0] * m;
+    }
+
+    template <class V>
+    auto modf_copy(const V& x, V integral) -> decltype(modf(x, integral))
+    {
+        return modf(x, integral);
+    }
+
+    template <class V>
+    auto assign_yx(V a, const V& b) -> decltype(a.yx = b.xy, V())
+    {
+        a.yx = b.xy;
+        return a;
+    }
+
+    template <class V>
+    auto assign_zyx(V a, const V& b) -> decltype(a.zyx = b.xyz, V())
+    {
+        a.zyx = b.xyz;
+        return a;
+    }
+
+    template <class V>
+    auto assign_wzyx(V a, const V& b) -> decltype(a.wzyx = b.xyzw, V())
+    {
+        a.wzyx = b.xyzw;
+        return a;
+    }
+
+    template <class V>
+    auto add_assign_zy(V a, const V& b) -> decltype(a.zy += b.xx, V())
+    {
+        a.zy += b.xx;
+        return a;
+    }
+
+    template <class V>
+    auto mul_assign_y(V a, const V& b) -> decltype(a.y *= b.x, V())
+    {
+        a.y *= b.x;
+        return a;
+    }
+}
+
+//! Defines builtins::builtin_##id, the expression expr over arguments in [lo;hi), tried with kinds_value of
+//! types, and registers it.
+#define CXXSWIZZLE_BUILTIN(id, kinds_value, lo_value, hi_value, expr) \
+    CXXSWIZZLE_BUILTIN_NAMED(id, #expr, kinds_value, lo_value, hi_value, expr)
+
+//! Same as CXXSWIZZLE_BUILTIN, for expressions using helpers: the name is what the helper does.
+#define CXXSWIZZLE_BUILTIN_NAMED(id, name_value, kinds_value, lo_value, hi_value, expr) \
+    namespace builtins { \
+        struct builtin_##id \
+        { \
+            static const int kinds = kinds_value; \
+            static const char* name() { return name_value; } \
+            static float lo() { return lo_value; } \
+            static float hi() { return hi_value; } \
+            template <class V> static auto eval(const V& a, const V& b, const V& c) -> decltype(expr) { (void)a; (void)b; (void)c; return expr; } \
+        }; \
+        static registrar<builtin_##id> s_registrar_##id; \
+    }
@@ -0,0 +1,240 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// What translation units of the benchmarks cost to compile: every shader of the sample and
+// compile_vectors.cpp (vectors alone), for each backend, compiled the way release builds are (see
+// compile_times_config.h.in). Each one is compiled --repetitions times (3 by default); reported are the
+// shortest CPU and wall times and the peak memory of the compiler. POSIX only.
+//
+// With --prelude dir, shader_sandbox.h gets precompiled into dir once per backend (reported as "prelude")
+// and shaders are compiled with it, as builds with precompiled headers do; run with and without it, with
+// different --tag values, to compare.
+
+#include "benchmark.h"
+#include "compile_times_config.h"
+#include <algorithm>
+#include <chrono>
+
+#ifndef _WIN32
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace compile_times
+{
+    struct options : bench::options
+    {
+        //! Where precompiled preludes go; empty if shaders are compiled without them.
+        std::string prelude_dir;
+
+        options()
+        {
+            repetitions = 3;
+        }
+
+    protected:
+        bool parse_extra(const std::string& arg, const char* value) override
+        {
+            if (arg == "--prelude")
+            {
+                prelude_dir = value;
+                return !prelude_dir.empty();
+            }
+            return false;
+        }
+
+        std::string usage_extra() const override
+        {
+            return " [--prelude dir]";
+        }
+    };
+
+    struct measurement
+    {
+        bool succeeded;
+        double cpu_s;
+        double wall_s;
+        double max_rss_mb;
+    };
+
+    //! Items separated with separator, empty ones skipped.
+    std::vector<std::string> split(const std::string& text, char separator)
+    {
+        std::vector<std::string> result;
+        std::istringstream s(text);
+        std::string item;
+        while (std::getline(s, item, separator))
+        {
+            if (!item.empty())
+            {
+                result.push_back(item);
+            }
+        }
+        return result;
+    }
+
+    //! File name without the directory and the extension.
+    std::string stem(const std::string& path)
+    {
+        std::string name = path.substr(path.find_last_of("/\\") + 1);
+        return name.substr(0, name.find_last_of('.'));
+    }
+
+    //! Runs the compiler once.
+    measurement compile(const std::vector<std::string>& args)
+    {
+        measurement result = { false, 0, 0, 0 };
+#ifndef _WIN32
+        std::vector<char*> argv;
+        for (const std::string& arg : args)
+        {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        pid_t pid;
+        if (::posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0)
+        {
+            return result;
+        }
+
+        // usage of this child only, unlike getrusage(RUSAGE_CHILDREN)
+        int status = 0;
+        struct rusage usage;
+        if (::wait4(pid, &status, 0, &usage) != pid)
+        {
+            return result;
+        }
+
+        result.succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        result.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.cpu_s = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#ifdef __APPLE__
+        // bytes rather than kilobytes
+        result.max_rss_mb = usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+        result.max_rss_mb = usage.ru_maxrss / 1024.0;
+#endif
+#else
+        (void)args;
+#endif
+        return result;
+    }
+
+    //! Compiles --repetitions times; the shortest times and the peak memory of all of them.
+    bool measure(const options& opts, const std::vector<std::string>& args, measurement& best)
+    {
+        best = { true, std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), 0 };
+        for (unsigned i = 0; i < opts.repetitions; ++i)
+        {
+            measurement m = compile(args);
+            if (!m.succeeded)
+            {
+                return false;
+            }
+            best.cpu_s = std::min(best.cpu_s, m.cpu_s);
+            best.wall_s = std::min(best.wall_s, m.wall_s);
+            best.max_rss_mb = std::max(best.max_rss_mb, m.max_rss_mb);
+        }
+        return true;
+    }
+
+    void addRecord(bench::report& report, const std::string& name, const char* backend, const measurement& m)
+    {
+        bench::record r;
+        r.text("suite", "compile").text("name", name).text("backend", backend)
+            .number("cpu_s", m.cpu_s, 3).number("wall_s", m.wall_s, 3).number("max_rss_mb", m.max_rss_mb, 1);
+        report.add(r);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace compile_times;
+
+    options opts;
+    if (!opts.parse(argc, argv))
+    {
+        return 1;
+    }
+#ifdef _WIN32
+    std::cerr << "ERROR: not supported on Windows" << std::endl;
+    return 1;
+#endif
+
+    bench::report report(opts);
+
+    struct backend
+    {
+        const char* name;
+        const char* flags;
+    };
+    std::vector<backend> backends = { { "float", COMPILE_TIMES_SCALAR_FLAGS } };
+    if (*COMPILE_TIMES_SIMD_FLAGS)
+    {
+        backends.push_back({ "vc_float", COMPILE_TIMES_SIMD_FLAGS });
+    }
+
+    for (const backend& b : backends)
+    {
+        std::vector<std::string> command = split(COMPILE_TIMES_COMMAND, ' ');
+        for (const std::string& flag : split(b.flags, ' '))
+        {
+            command.push_back(flag);
+        }
+
+        // the compiler finds the precompiled header by the name given to -include, plus the suffix
+        std::vector<std::string> prelude;
+        if (!opts.prelude_dir.empty())
+        {
+            std::string header = opts.prelude_dir + "/prelude_" + b.name + ".h";
+            std::vector<std::string> args = command;
+            args.insert(args.end(), { "-x", "c++-header", COMPILE_TIMES_PRELUDE, "-o", header + COMPILE_TIMES_PCH_SUFFIX });
+
+            measurement m;
+            if (!measure(opts, args, m))
+            {
+                std::cerr << "ERROR: unable to precompile " << COMPILE_TIMES_PRELUDE << " for " << b.name << std::endl;
+                return 1;
+            }
+            addRecord(report, "prelude", b.name, m);
+            prelude = { "-include", header };
+        }
+
+        std::vector<std::string> sources = split(COMPILE_TIMES_SOURCES, ';');
+        size_t first_shader = sources.size();
+        for (const std::string& source : split(COMPILE_TIMES_SHADER_SOURCES, ';'))
+        {
+            sources.push_back(source);
+        }
+
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            std::string name = stem(sources[i]);
+            if (!opts.matches(name, b.name))
+            {
+                continue;
+            }
+
+            std::vector<std::string> args = command;
+            if (i >= first_shader)
+            {
+                args.insert(args.end(), prelude.begin(), prelude.end());
+            }
+            args.insert(args.end(), { "-c", sources[i], "-o", COMPILE_TIMES_OBJECT });
+
+            measurement m;
+            if (!measure(opts, args, m))
+            {
+                std::cerr << "ERROR: unable to compile " << sources[i] << " for " << b.name << std::endl;
+                return 1;
+            }
+            addRecord(report, name, b.name, m);
+        }
+    }
+    return 0;
+}
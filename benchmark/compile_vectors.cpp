@@ -0,0 +1,25 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Not a part of any executable: compile_times compiles it to tell what vectors cost a translation unit by
+// themselves, i.e. vector_base with its swizzle proxies for every size, next to what whole shaders cost.
+
+#if defined(USE_SIMD)
+#include "use_simd.h"
+#else
+#include "use_scalar.h"
+#endif
+
+#include <swizzle/glsl/vector.h>
+
+typedef swizzle::glsl::vector< float_type, 1 > vec1;
+typedef swizzle::glsl::vector< float_type, 2 > vec2;
+typedef swizzle::glsl::vector< float_type, 3 > vec3;
+typedef swizzle::glsl::vector< float_type, 4 > vec4;
+typedef swizzle::glsl::vector< bool_type, 4 > bvec4;
+
+vec4 compileVectors(const vec4& a, const vec3& b, const vec2& c, const vec1& d, bvec4& e)
+{
+    e = bvec4(true);
+    return a.wzyx + vec4(b.zyx, c.y) * d.x;
+}
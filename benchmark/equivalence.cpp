@@ -0,0 +1,681 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Differences between the vc_float and float backends. Every builtin of builtin_list.h is evaluated with
+// both of them, for each type it compiles for, over a dense grid of arguments: the first component of a
+// goes through [lo;hi) in even steps, the other components and arguments follow additive recurrences of
+// irrational steps (so they cover the range evenly too, without being correlated). Batches of
+// scalar_count arguments are packed into lanes of vc_float and each lane's result is compared with the
+// float one for the same arguments: floats in ULPs, integers by difference and bools exactly.
+//
+// Where vc_float collapses lanes into a single bool (e.g. relational functions, as bool_type is bool),
+// the bool is compared with all the lanes' float results being true and the line says so; these are not
+// counted as failures, since they are a known limitation rather than an inaccuracy.
+//
+// Batched matrix functions (swizzle/glsl/matrix_batch_vc.h) are compared with their float counterparts
+// too, matrix by matrix, for a count of matrices which is not a multiple of scalar_count; results past
+// the count must be left alone.
+//
+// With --images, frames saved by shaders_scalar and shaders_simd (with --save-frames) are compared
+// pixel by pixel. --max-ulp and --max-pixel-diff make it a test: the exit code is 1 if any of the
+// differences is greater.
+
+#include "use_simd.h"
+#include <swizzle/glsl/matrix_batch_vc.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include "benchmark.h"
+#include "builtins.h"
+
+namespace builtins
+{
+    //! A component of a result.
+    struct value
+    {
+        double number;
+        bool is_float;
+    };
+
+    typedef std::vector<value> values;
+
+    // float results, flattened
+
+    inline void flatten(float result, values& out)
+    {
+        out.push_back(value{ result, true });
+    }
+
+    inline void flatten(bool result, values& out)
+    {
+        out.push_back(value{ result ? 1.0 : 0.0, false });
+    }
+
+    inline void flatten(unsigned result, values& out)
+    {
+        out.push_back(value{ static_cast<double>(result), false });
+    }
+
+    inline void flatten(int result, values& out)
+    {
+        out.push_back(value{ static_cast<double>(result), false });
+    }
+
+    template <class T, size_t N>
+    auto flatten(const swizzle::glsl::vector<T, N>& result, values& out) -> decltype(flatten(result[0], out))
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            flatten(result[i], out);
+        }
+    }
+
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M>
+    auto flatten(const swizzle::glsl::matrix<VectorType, T, N, M>& result, values& out) -> decltype(flatten(result[0], out))
+    {
+        for (size_t i = 0; i < M; ++i)
+        {
+            flatten(result[i], out);
+        }
+    }
+
+    template <class VectorType, class DataType, size_t... Indices>
+    auto flatten(const swizzle::detail::indexed_proxy<VectorType, DataType, Indices...>& result, values& out) -> decltype(flatten(result.decay(), out))
+    {
+        flatten(result.decay(), out);
+    }
+
+    // vc_float results, flattened lane by lane
+
+    struct lanes
+    {
+        values lane[scalar_count];
+        //! Set if a component is the same bool for all the lanes.
+        bool collapsed;
+    };
+
+    template <class Raw>
+    void flatten_raw(const Raw& raw, lanes& out, bool is_float)
+    {
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            out.lane[i].push_back(value{ static_cast<double>(raw[i]), is_float });
+        }
+    }
+
+    inline void flatten_lanes(const float_type& result, lanes& out)
+    {
+        flatten_raw(static_cast<raw_float_type>(result), out, true);
+    }
+
+    inline void flatten_lanes(const swizzle::glsl::vc_uint<>& result, lanes& out)
+    {
+        flatten_raw(static_cast< ::Vc::uint_v >(result), out, false);
+    }
+
+    inline void flatten_lanes(const swizzle::glsl::vc_int<>& result, lanes& out)
+    {
+        flatten_raw(static_cast< ::Vc::int_v >(result), out, false);
+    }
+
+    inline void flatten_lanes(const raw_float_type::Mask& result, lanes& out)
+    {
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            out.lane[i].push_back(value{ result[i] ? 1.0 : 0.0, false });
+        }
+    }
+
+    inline void flatten_lanes(bool result, lanes& out)
+    {
+        out.collapsed = true;
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            out.lane[i].push_back(value{ result ? 1.0 : 0.0, false });
+        }
+    }
+
+    template <class T, size_t N>
+    auto flatten_lanes(const swizzle::glsl::vector<T, N>& result, lanes& out) -> decltype(flatten_lanes(result[0], out))
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            flatten_lanes(result[i], out);
+        }
+    }
+
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M>
+    auto flatten_lanes(const swizzle::glsl::matrix<VectorType, T, N, M>& result, lanes& out) -> decltype(flatten_lanes(result[0], out))
+    {
+        for (size_t i = 0; i < M; ++i)
+        {
+            flatten_lanes(result[i], out);
+        }
+    }
+
+    template <class VectorType, class DataType, size_t... Indices>
+    auto flatten_lanes(const swizzle::detail::indexed_proxy<VectorType, DataType, Indices...>& result, lanes& out) -> decltype(flatten_lanes(result.decay(), out))
+    {
+        flatten_lanes(result.decay(), out);
+    }
+
+    // arguments
+
+    template <class S>
+    void set_component(S& arg, unsigned, const S& value)
+    {
+        arg = value;
+    }
+
+    template <class T, size_t N>
+    void set_component(swizzle::glsl::vector<T, N>& arg, unsigned index, const T& value)
+    {
+        arg[index] = value;
+    }
+
+    template <template <class, size_t> class VectorType, class T, size_t N, size_t M>
+    void set_component(swizzle::glsl::matrix<VectorType, T, N, M>& arg, unsigned index, const T& value)
+    {
+        arg[index / N][index % N] = value;
+    }
+
+    //! Component index of argument arg of sample i of count, in [lo;hi).
+    inline float grid(float lo, float hi, size_t i, size_t count, unsigned arg, unsigned index)
+    {
+        // steps are fractional parts of square roots of primes, one for each component of each argument
+        static const unsigned c_primes[48] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89,
+            97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223 };
+
+        double t;
+        if (arg == 0 && index == 0)
+        {
+            t = (i + 0.5) / count;
+        }
+        else
+        {
+            double root = std::sqrt(static_cast<double>(c_primes[(arg * 16 + index) % 48]));
+            double step = root - std::floor(root);
+            t = 0.5 + i * step;
+            t -= std::floor(t);
+        }
+        return static_cast<float>(lo + (hi - lo) * t);
+    }
+
+    //! Distance in representable floats; 0 for two NaNs, infinite for a NaN and a number.
+    inline double ulp_distance(float x, float y)
+    {
+        if (x != x || y != y)
+        {
+            return (x != x && y != y) ? 0.0 : std::numeric_limits<double>::infinity();
+        }
+        int32_t ix, iy;
+        std::memcpy(&ix, &x, sizeof(x));
+        std::memcpy(&iy, &y, sizeof(y));
+        // sign and magnitude to a monotonic integer; +0 and -0 both become 0
+        long long ox = ix < 0 ? -static_cast<long long>(ix & 0x7fffffff) : ix;
+        long long oy = iy < 0 ? -static_cast<long long>(iy & 0x7fffffff) : iy;
+        return static_cast<double>(ox > oy ? ox - oy : oy - ox);
+    }
+
+    struct options : bench::options
+    {
+        //! Arguments each builtin is evaluated for.
+        unsigned samples;
+        //! Limits of differences; negative for none.
+        double max_ulp;
+        double max_pixel_diff;
+        //! Directories of frames of shaders_scalar and shaders_simd.
+        std::string scalar_frames;
+        std::string simd_frames;
+
+        options()
+            : samples(4096)
+            , max_ulp(-1)
+            , max_pixel_diff(-1)
+        {}
+
+    protected:
+        bool parse_extra(const std::string& arg, const char* value) override
+        {
+            if (arg == "--samples")
+            {
+                samples = static_cast<unsigned>(std::max(1, std::atoi(value)));
+                return true;
+            }
+            else if (arg == "--max-ulp")
+            {
+                max_ulp = std::atof(value);
+                return true;
+            }
+            else if (arg == "--max-pixel-diff")
+            {
+                max_pixel_diff = std::atof(value);
+                return true;
+            }
+            else if (arg == "--images")
+            {
+                std::string dirs = value;
+                size_t comma = dirs.find(',');
+                if (comma == std::string::npos)
+                {
+                    return false;
+                }
+                scalar_frames = dirs.substr(0, comma);
+                simd_frames = dirs.substr(comma + 1);
+                return true;
+            }
+            return false;
+        }
+
+        std::string usage_extra() const override
+        {
+            return " [--samples n] [--max-ulp ulps] [--images scalar_dir,simd_dir] [--max-pixel-diff levels]";
+        }
+    };
+
+    //! Set when a limit is exceeded.
+    bool g_failed = false;
+
+    //! Compares Builtin for V (float based) and VV (vc_float based), if it compiles for both.
+    template <class Builtin, class V, class VV>
+    auto compare(const options& opts, bench::report& report, const char* type, int)
+        -> decltype(flatten(Builtin::eval(std::declval<const V&>(), std::declval<const V&>(), std::declval<const V&>()), std::declval<values&>()),
+                    flatten_lanes(Builtin::eval(std::declval<const VV&>(), std::declval<const VV&>(), std::declval<const VV&>()), std::declval<lanes&>()), void())
+    {
+        if (!opts.matches(Builtin::name(), type))
+        {
+            return;
+        }
+
+        const unsigned components = values_of<V>::value;
+        size_t batches = (opts.samples + scalar_count - 1) / scalar_count;
+        size_t count = batches * scalar_count;
+
+        size_t compared = 0;
+        size_t differing = 0;
+        size_t floats = 0;
+        double max_ulp = 0;
+        double sum_ulp = 0;
+        double max_abs = 0;
+        bool collapsed = false;
+
+        for (size_t batch = 0; batch < batches; ++batch)
+        {
+            VV simd_args[3];
+            for (unsigned arg = 0; arg < 3; ++arg)
+            {
+                for (unsigned index = 0; index < components; ++index)
+                {
+                    raw_float_type raw;
+                    for (size_t lane = 0; lane < scalar_count; ++lane)
+                    {
+                        raw[lane] = grid(Builtin::lo(), Builtin::hi(), batch * scalar_count + lane, count, arg, index);
+                    }
+                    set_component(simd_args[arg], index, float_type(raw));
+                }
+            }
+
+            lanes simd_result;
+            simd_result.collapsed = false;
+            flatten_lanes(Builtin::eval(simd_args[0], simd_args[1], simd_args[2]), simd_result);
+            collapsed |= simd_result.collapsed;
+
+            // all the lanes need to be true for a collapsed bool to be true
+            values all_lanes;
+            for (size_t lane = 0; lane < scalar_count; ++lane)
+            {
+                V args[3];
+                for (unsigned arg = 0; arg < 3; ++arg)
+                {
+                    for (unsigned index = 0; index < components; ++index)
+                    {
+                        set_component(args[arg], index, grid(Builtin::lo(), Builtin::hi(), batch * scalar_count + lane, count, arg, index));
+                    }
+                }
+
+                values result;
+                flatten(Builtin::eval(args[0], args[1], args[2]), result);
+                if (lane == 0)
+                {
+                    all_lanes = result;
+                }
+                for (size_t i = 0; i < result.size() && i < all_lanes.size(); ++i)
+                {
+                    all_lanes[i].number = all_lanes[i].number != 0 && result[i].number != 0 ? 1.0 : 0.0;
+                }
+
+                const values& expected = simd_result.collapsed ? all_lanes : result;
+                if (simd_result.collapsed && lane + 1 < scalar_count)
+                {
+                    continue;
+                }
+
+                const values& actual = simd_result.lane[lane];
+                differing += actual.size() != expected.size() ? 1 : 0;
+                for (size_t i = 0; i < actual.size() && i < expected.size(); ++i)
+                {
+                    ++compared;
+                    double diff = std::abs(actual[i].number - expected[i].number);
+                    if (actual[i].is_float && expected[i].is_float)
+                    {
+                        double ulps = ulp_distance(static_cast<float>(actual[i].number), static_cast<float>(expected[i].number));
+                        ++floats;
+                        sum_ulp += ulps;
+                        max_ulp = std::max(max_ulp, ulps);
+                        diff = ulps == 0 ? 0 : (diff == diff ? diff : std::numeric_limits<double>::infinity());
+                    }
+                    differing += diff != 0 ? 1 : 0;
+                    max_abs = std::max(max_abs, diff);
+                }
+            }
+        }
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        bench::record r;
+        r.text("suite", "builtins").text("name", Builtin::name()).text("type", type)
+            .integer("samples", static_cast<long long>(count)).integer("values", static_cast<long long>(compared))
+            .integer("differing", static_cast<long long>(differing))
+            .number("max_ulp", floats ? max_ulp : nan, 1).number("mean_ulp", floats ? sum_ulp / floats : nan)
+            .number("max_abs_diff", max_abs, 8).integer("lanes_collapsed", collapsed ? 1 : 0);
+        report.add(r);
+
+        if (!collapsed && opts.max_ulp >= 0 && (max_ulp > opts.max_ulp || (differing && !floats)))
+        {
+            g_failed = true;
+        }
+    }
+
+    template <class Builtin, class V, class VV>
+    void compare(const options&, bench::report&, const char*, long)
+    {
+        // not available for either of the types
+    }
+
+    template <class Builtin, class V, class VV>
+    void compare_if(const options& opts, bench::report& report, const char* type, std::true_type)
+    {
+        compare<Builtin, V, VV>(opts, report, type, 0);
+    }
+
+    template <class Builtin, class V, class VV>
+    void compare_if(const options&, bench::report&, const char*, std::false_type)
+    {}
+
+    std::vector<std::function<void(const options&, bench::report&)>>& registry()
+    {
+        static std::vector<std::function<void(const options&, bench::report&)>> s_registry;
+        return s_registry;
+    }
+
+    template <class Builtin>
+    struct registrar
+    {
+        registrar()
+        {
+            registry().push_back([](const options& opts, bench::report& report)
+            {
+                typedef std::integral_constant<bool, (Builtin::kinds & scalars) != 0> on_scalars;
+                typedef std::integral_constant<bool, (Builtin::kinds & vectors) != 0> on_vectors;
+                typedef std::integral_constant<bool, (Builtin::kinds & matrices) != 0> on_matrices;
+                typedef types<float> s;
+                typedef types<float_type> v;
+
+                compare_if<Builtin, float, float_type>(opts, report, "float", on_scalars());
+                compare_if<Builtin, s::vec1, v::vec1>(opts, report, "vec1", on_vectors());
+                compare_if<Builtin, s::vec2, v::vec2>(opts, report, "vec2", on_vectors());
+                compare_if<Builtin, s::vec3, v::vec3>(opts, report, "vec3", on_vectors());
+                compare_if<Builtin, s::vec4, v::vec4>(opts, report, "vec4", on_vectors());
+                compare_if<Builtin, s::mat2, v::mat2>(opts, report, "mat2", on_matrices());
+                compare_if<Builtin, s::mat3, v::mat3>(opts, report, "mat3", on_matrices());
+                compare_if<Builtin, s::mat4, v::mat4>(opts, report, "mat4", on_matrices());
+            });
+        }
+    };
+}
+
+#include "builtin_list.h"
+
+namespace batches
+{
+    using builtins::values;
+
+    //! Matrices with components from the grid in [-1;1), plus N on the diagonal, so that all of them can
+    //! be inverted.
+    template <class M>
+    std::vector<M> grid_matrices(size_t count)
+    {
+        const unsigned n = builtins::values_of<typename M::column_type>::value;
+        const unsigned components = builtins::values_of<M>::value;
+        std::vector<M> result(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (unsigned index = 0; index < components; ++index)
+            {
+                float diagonal = index / n == index % n ? static_cast<float>(n) : 0.0f;
+                builtins::set_component(result[i], index, builtins::grid(-1, 1, i, count, 0, index) + diagonal);
+            }
+        }
+        return result;
+    }
+
+    //! Compares batch (a function of batch::) for arrays of M with scalar, a float function of an M giving R.
+    template <class M, class R, class Batch, class Scalar>
+    void compare(const builtins::options& opts, bench::report& report, const char* name, const char* type, Batch batch, Scalar scalar)
+    {
+        if (!opts.matches(name, type))
+        {
+            return;
+        }
+
+        // not a multiple of scalar_count, so that the last batch is partial (unless there is one lane)
+        size_t count = opts.samples + (opts.samples % scalar_count == 0 ? scalar_count / 2 : 0);
+        std::vector<M> input = grid_matrices<M>(count);
+
+        // a batch's worth of canaries past the count
+        const R canary(12345.0f);
+        std::vector<R> output(count + scalar_count, canary);
+        batch(input.data(), output.data(), count);
+
+        size_t compared = 0;
+        size_t differing = 0;
+        double max_ulp = 0;
+        double sum_ulp = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            values actual, expected;
+            builtins::flatten(output[i], actual);
+            builtins::flatten(scalar(input[i]), expected);
+            for (size_t j = 0; j < actual.size(); ++j)
+            {
+                double ulps = builtins::ulp_distance(static_cast<float>(actual[j].number), static_cast<float>(expected[j].number));
+                ++compared;
+                differing += ulps != 0 ? 1 : 0;
+                sum_ulp += ulps;
+                max_ulp = std::max(max_ulp, ulps);
+            }
+        }
+
+        size_t overwritten = 0;
+        for (size_t i = count; i < output.size(); ++i)
+        {
+            values actual, expected;
+            builtins::flatten(output[i], actual);
+            builtins::flatten(canary, expected);
+            for (size_t j = 0; j < actual.size(); ++j)
+            {
+                overwritten += actual[j].number != expected[j].number ? 1 : 0;
+            }
+        }
+
+        bench::record r;
+        r.text("suite", "batches").text("name", name).text("type", type)
+            .integer("samples", static_cast<long long>(count)).integer("values", static_cast<long long>(compared))
+            .integer("differing", static_cast<long long>(differing))
+            .number("max_ulp", max_ulp, 1).number("mean_ulp", compared ? sum_ulp / compared : 0)
+            .integer("overwritten", static_cast<long long>(overwritten));
+        report.add(r);
+
+        if (overwritten || (opts.max_ulp >= 0 && max_ulp > opts.max_ulp))
+        {
+            builtins::g_failed = true;
+        }
+    }
+
+    template <class M, class SimdM>
+    void compare_all(const builtins::options& opts, bench::report& report, const char* type)
+    {
+        using namespace swizzle::glsl;
+
+        compare<M, M>(opts, report, "inverse(a)", type,
+            [](const M* input, M* output, size_t count) { batch::inverse(input, output, count); },
+            [](const M& m) { return inverse(m); });
+        compare<M, M>(opts, report, "transpose(a)", type,
+            [](const M* input, M* output, size_t count) { batch::transpose(input, output, count); },
+            [](const M& m) { return transpose(m); });
+        compare<M, float>(opts, report, "determinant(a)", type,
+            [](const M* input, float* output, size_t count) { batch::determinant(input, output, count); },
+            [](const M& m) { return determinant(m); });
+        compare<M, M>(opts, report, "a * transpose(a)", type,
+            [](const M* input, M* output, size_t count) { batch::transform(input, output, count, [](const SimdM& m) { return m * transpose(m); }); },
+            [](const M& m) { return m * transpose(m); });
+    }
+
+    void compare(const builtins::options& opts, bench::report& report)
+    {
+        typedef builtins::types<float> s;
+        typedef builtins::types<float_type> v;
+
+        compare_all<s::mat2, v::mat2>(opts, report, "mat2");
+        compare_all<s::mat3, v::mat3>(opts, report, "mat3");
+        compare_all<s::mat4, v::mat4>(opts, report, "mat4");
+    }
+}
+
+namespace images
+{
+    //! 8 bit RGB, as saved by shaders_scalar and shaders_simd.
+    struct image
+    {
+        unsigned width;
+        unsigned height;
+        std::vector<uint8_t> pixels;
+    };
+
+    //! Reads a binary PPM with maxval 255; returns false if it is not one.
+    bool read_ppm(const std::string& path, image& result)
+    {
+        std::ifstream file(path.c_str(), std::ios::binary);
+        std::string magic;
+        unsigned maxval = 0;
+        if (!(file >> magic >> result.width >> result.height >> maxval) || magic != "P6" || maxval != 255)
+        {
+            return false;
+        }
+        file.get();
+        result.pixels.resize(3 * result.width * result.height);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(result.pixels.data()), result.pixels.size()));
+    }
+
+    //! Compares frames listed in frames.txt of both directories.
+    bool compare(const builtins::options& opts, bench::report& report)
+    {
+        std::ifstream list((opts.scalar_frames + "/frames.txt").c_str());
+        if (!list)
+        {
+            std::cerr << "ERROR: no frames.txt in " << opts.scalar_frames << std::endl;
+            return false;
+        }
+
+        bool passed = true;
+        std::string name;
+        while (std::getline(list, name))
+        {
+            if (name.empty() || !opts.matches(name, std::string()))
+            {
+                continue;
+            }
+
+            image scalar, simd;
+            const char* error = nullptr;
+            if (!read_ppm(opts.scalar_frames + "/" + name, scalar))
+            {
+                error = "unable to read the scalar frame";
+            }
+            else if (!read_ppm(opts.simd_frames + "/" + name, simd))
+            {
+                error = "unable to read the SIMD frame";
+            }
+            else if (scalar.width != simd.width || scalar.height != simd.height)
+            {
+                error = "frames differ in size";
+            }
+            if (error)
+            {
+                std::cerr << "ERROR: " << name << ": " << error << std::endl;
+                passed = false;
+                continue;
+            }
+
+            size_t differing = 0;
+            unsigned max_diff = 0;
+            double sum_diff = 0;
+            double sum_squared = 0;
+            for (size_t pixel = 0; pixel < scalar.width * scalar.height; ++pixel)
+            {
+                bool differs = false;
+                for (size_t channel = 0; channel < 3; ++channel)
+                {
+                    int diff = std::abs(static_cast<int>(scalar.pixels[3 * pixel + channel]) - static_cast<int>(simd.pixels[3 * pixel + channel]));
+                    differs |= diff != 0;
+                    max_diff = std::max(max_diff, static_cast<unsigned>(diff));
+                    sum_diff += diff;
+                    sum_squared += diff * diff;
+                }
+                differing += differs ? 1 : 0;
+            }
+
+            // PSNR is infinite for identical frames; reported as null
+            double channels = 3.0 * scalar.width * scalar.height;
+            double mse = sum_squared / channels;
+            bench::record r;
+            r.text("suite", "shaders").text("name", name).integer("pixels", static_cast<long long>(scalar.width) * scalar.height)
+                .integer("differing_pixels", static_cast<long long>(differing)).integer("max_channel_diff", max_diff)
+                .number("mean_channel_diff", sum_diff / channels)
+                .number("psnr_db", mse > 0 ? 10 * std::log10(255.0 * 255.0 / mse) : std::numeric_limits<double>::quiet_NaN(), 2);
+            report.add(r);
+
+            if (opts.max_pixel_diff >= 0 && max_diff > opts.max_pixel_diff)
+            {
+                passed = false;
+            }
+        }
+        return passed;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    builtins::options opts;
+    if (!opts.parse(argc, argv))
+    {
+        return 1;
+    }
+
+    bench::report report(opts);
+    bool passed = true;
+    if (opts.scalar_frames.empty())
+    {
+        for (auto& compare : builtins::registry())
+        {
+            compare(opts, report);
+        }
+        batches::compare(opts, report);
+        passed = !builtins::g_failed;
+    }
+    else
+    {
+        passed = images::compare(opts, report);
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,353 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Optional performance counters of the headless render path, through perf_event_open (Linux only). Every
+// thread rendering rows of the screen counts events of shading (calls of the shader) and of packing
+// (clamping, converting and storing pixels) separately, with a group of counters per phase that gets
+// enabled and disabled around each batch of pixels. Toggling takes a system call, so frame times of runs
+// with counters are not comparable with the ones of runs without; counts of hardware events exclude the
+// kernel, so the toggling itself hardly shows in them (unlike in task_clock_ns, a software event).
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+    namespace perf
+    {
+        enum phase
+        {
+            shading,
+            packing,
+            phase_count
+        };
+
+        inline const char* phase_name(phase p)
+        {
+            return p == shading ? "shade" : "pack";
+        }
+
+        struct event
+        {
+            std::string name;
+            uint32_t type;
+            uint64_t config;
+        };
+
+        //! Events known by name; others can be given as raw, model specific configs.
+        inline std::vector<event> known_events()
+        {
+#ifdef __linux__
+            return {
+                { "task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+                { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+                { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+                { "cache_references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+                { "cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+                { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+                { "l1d_read_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+            };
+#else
+            return {};
+#endif
+        }
+
+        //! Parses a comma separated list of known event names ("all" meaning all of them) and raw events,
+        //! given as name=config (hexadecimal, e.g. fp_packed_single=0x08c7); returns false if it is not one.
+        inline bool parse_events(const std::string& list, std::vector<event>& result)
+        {
+            std::vector<event> known = known_events();
+            std::istringstream s(list);
+            std::string item;
+            while (std::getline(s, item, ','))
+            {
+                size_t equals = item.find('=');
+                if (item == "all")
+                {
+                    result.insert(result.end(), known.begin(), known.end());
+                }
+                else if (equals != std::string::npos)
+                {
+                    char* end = nullptr;
+                    uint64_t config = std::strtoull(item.c_str() + equals + 1, &end, 16);
+                    if (equals == 0 || *end)
+                    {
+                        return false;
+                    }
+#ifdef __linux__
+                    result.push_back(event{ item.substr(0, equals), PERF_TYPE_RAW, config });
+#endif
+                }
+                else
+                {
+                    bool found = false;
+                    for (const event& e : known)
+                    {
+                        if (e.name == item)
+                        {
+                            result.push_back(e);
+                            found = true;
+                        }
+                    }
+                    if (!found)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return !result.empty();
+        }
+
+        //! Counts of events, per phase, summed over threads; NaN for events that could not be counted.
+        struct counts
+        {
+            std::vector<double> values[phase_count];
+        };
+
+        //! Counter groups of a thread, one per phase. Only its thread toggles them; they are read by
+        //! collect(), when no thread renders.
+        class thread_counters
+        {
+        public:
+            explicit thread_counters(const std::vector<event>& events)
+                : finished(false)
+            {
+                for (size_t p = 0; p < phase_count; ++p)
+                {
+                    m_groups[p].leader = -1;
+                    m_groups[p].fds.assign(events.size(), -1);
+                    m_groups[p].last.assign(events.size(), 0.0);
+#ifdef __linux__
+                    for (size_t i = 0; i < events.size(); ++i)
+                    {
+                        perf_event_attr attr = {};
+                        attr.size = sizeof(attr);
+                        attr.type = events[i].type;
+                        attr.config = events[i].config;
+                        attr.disabled = m_groups[p].leader < 0 ? 1 : 0;
+                        attr.exclude_kernel = 1;
+                        attr.exclude_hv = 1;
+                        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                        int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, m_groups[p].leader, 0));
+                        if (fd >= 0)
+                        {
+                            m_groups[p].fds[i] = fd;
+                            m_groups[p].members.push_back(i);
+                            if (m_groups[p].leader < 0)
+                            {
+                                m_groups[p].leader = fd;
+                            }
+                        }
+                    }
+#endif
+                }
+            }
+
+            ~thread_counters()
+            {
+#ifdef __linux__
+                for (group& g : m_groups)
+                {
+                    for (int fd : g.fds)
+                    {
+                        if (fd >= 0)
+                        {
+                            ::close(fd);
+                        }
+                    }
+                }
+#endif
+            }
+
+            //! Set once the thread has exited; such counters are closed after being collected.
+            std::atomic<bool> finished;
+
+            thread_counters(const thread_counters&) = delete;
+            thread_counters& operator=(const thread_counters&) = delete;
+
+            void begin(phase p)
+            {
+#ifdef __linux__
+                if (m_groups[p].leader >= 0)
+                {
+                    ::ioctl(m_groups[p].leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                }
+#endif
+            }
+
+            void end(phase p)
+            {
+#ifdef __linux__
+                if (m_groups[p].leader >= 0)
+                {
+                    ::ioctl(m_groups[p].leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                }
+#endif
+            }
+
+            //! Adds counts since the previous call to result. Counts get scaled up if the kernel had to
+            //! multiplex counters; events that never got a counter stay NaN.
+            void add_to(counts& result)
+            {
+                for (size_t p = 0; p < phase_count; ++p)
+                {
+                    group& g = m_groups[p];
+#ifdef __linux__
+                    if (g.leader < 0)
+                    {
+                        continue;
+                    }
+
+                    std::vector<uint64_t> data(3 + g.members.size());
+                    ssize_t size = ::read(g.leader, data.data(), data.size() * sizeof(uint64_t));
+                    if (size != static_cast<ssize_t>(data.size() * sizeof(uint64_t)) || data[2] == 0)
+                    {
+                        continue;
+                    }
+
+                    double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+                    for (size_t m = 0; m < g.members.size(); ++m)
+                    {
+                        size_t i = g.members[m];
+                        double value = static_cast<double>(data[3 + m]) * scale;
+                        double& sum = result.values[p][i];
+                        sum = (std::isnan(sum) ? 0.0 : sum) + (value - g.last[i]);
+                        g.last[i] = value;
+                    }
+#else
+                    (void)g;
+                    (void)result;
+#endif
+                }
+            }
+
+        private:
+            struct group
+            {
+                int leader;
+                //! Per event, -1 if it could not be opened.
+                std::vector<int> fds;
+                //! Indices of events opened, in order of the group's members.
+                std::vector<size_t> members;
+                //! Scaled counts read last time.
+                std::vector<double> last;
+            };
+
+            group m_groups[phase_count];
+        };
+
+        //! Counters of all the threads, which outlive the threads so that their counts can still be read.
+        class session
+        {
+        public:
+            static session& get()
+            {
+                static session s_session;
+                return s_session;
+            }
+
+            //! Starts counting events in threads calling local() from now on; call once, before rendering.
+            void configure(std::vector<event> events)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_events = std::move(events);
+                m_enabled = !m_events.empty();
+            }
+
+            bool enabled() const
+            {
+                return m_enabled;
+            }
+
+            const std::vector<event>& events() const
+            {
+                return m_events;
+            }
+
+            //! Counters of the calling thread; null if there is no session.
+            thread_counters* local()
+            {
+                if (!m_enabled)
+                {
+                    return nullptr;
+                }
+
+                struct slot
+                {
+                    thread_counters* counters;
+
+                    ~slot()
+                    {
+                        if (counters)
+                        {
+                            counters->finished = true;
+                        }
+                    }
+                };
+
+                static thread_local slot s_slot = { nullptr };
+                if (!s_slot.counters)
+                {
+                    std::unique_ptr<thread_counters> counters(new thread_counters(m_events));
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_threads.push_back(std::move(counters));
+                    s_slot.counters = m_threads.back().get();
+                }
+                return s_slot.counters;
+            }
+
+            //! Counts since the previous call, summed over threads; call while no thread renders.
+            counts collect()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                counts result;
+                for (size_t p = 0; p < phase_count; ++p)
+                {
+                    result.values[p].assign(m_events.size(), std::numeric_limits<double>::quiet_NaN());
+                }
+                for (auto& counters : m_threads)
+                {
+                    counters->add_to(result);
+                }
+                m_threads.erase(std::remove_if(m_threads.begin(), m_threads.end(), [](const std::unique_ptr<thread_counters>& counters)
+                {
+                    return counters->finished.load();
+                }), m_threads.end());
+                return result;
+            }
+
+        private:
+            session()
+                : m_enabled(false)
+            {}
+
+            std::mutex m_mutex;
+            bool m_enabled;
+            std::vector<event> m_events;
+            std::vector<std::unique_ptr<thread_counters>> m_threads;
+        };
+
+        //! Counters of the calling thread, or null if nothing is being counted.
+        inline thread_counters* local()
+        {
+            return session::get().local();
+        }
+    }
+}
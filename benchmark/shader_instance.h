@@ -0,0 +1,119 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// A shader of sample/shaders, compiled in a namespace of its own and registered with the shader
+// benchmark. Included once per translation unit (CMake generates them from shader.cpp.in), with:
+//   BENCHMARK_SHADER_NAME      - name of the shader, an identifier
+//   BENCHMARK_SHADER_FILE      - path of the shader, e.g. "shaders/sky.frag"
+//   BENCHMARK_BUFFER_A_FILE    - optional; BufferA shader of a multi-pass shader
+// Uniforms are defined in the shader's namespace, so that their declarations in the shader refer to
+// them and no two shaders share any.
+
+#include "shader_sandbox.h"
+
+#define BENCHMARK_STRINGIFY_IMPL(x) #x
+#define BENCHMARK_STRINGIFY(x) BENCHMARK_STRINGIFY_IMPL(x)
+
+namespace glsl_sandbox
+{
+    namespace BENCHMARK_SHADER_NAME
+    {
+        #include <swizzle/glsl/vector_functions.h>
+
+        uniform_float_type time = 1;
+        vec2 mouse(0, 0);
+        vec2 resolution;
+
+        vec2& iResolution = resolution;
+        uniform_float_type& iGlobalTime = time;
+        vec2& iMouse = mouse;
+
+        sampler2D diffuse(shader_bench::benchmarkTexture(), swizzle::glsl::wrap_mode::repeat, swizzle::glsl::texture_filter::linear_mipmap_linear, swizzle::glsl::texture_filter::linear);
+        sampler2D specular(shader_bench::benchmarkTexture(), swizzle::glsl::wrap_mode::repeat, swizzle::glsl::texture_filter::linear_mipmap_linear, swizzle::glsl::texture_filter::linear);
+        sampler2D iChannel0(shader_bench::blankTexture(), swizzle::glsl::wrap_mode::clamp, swizzle::glsl::texture_filter::linear, swizzle::glsl::texture_filter::linear);
+
+        struct fragment_shader
+        {
+            vec2 gl_FragCoord;
+            vec4 gl_FragColor;
+            void operator()(void);
+        };
+
+        // same as in the sample
+        #define uniform extern uniform_types::
+        #define in in::
+        #define out ref::
+        #define inout ref::
+        #define main fragment_shader::operator()
+        #define float float_type
+        #define bool bool_type
+        #define uniform_scope(x) CXXSWIZZLE_UNIFORM_SCOPE(x)
+
+#ifdef _MSC_VER
+        #pragma warning(push)
+        #pragma warning(disable: 4244) // disable return implicit conversion warning
+        #pragma warning(disable: 4305) // disable truncation warning
+#endif
+
+        #include BENCHMARK_SHADER_FILE
+
+#ifdef BENCHMARK_BUFFER_A_FILE
+        namespace buffer_a
+        {
+            struct fragment_shader
+            {
+                vec2 gl_FragCoord;
+                vec4 gl_FragColor;
+                void operator()(void);
+            };
+
+            #include BENCHMARK_BUFFER_A_FILE
+        }
+#endif
+
+#ifdef _MSC_VER
+        #pragma warning(pop)
+#endif
+        #undef uniform_scope
+        #undef bool
+        #undef float
+        #undef main
+        #undef in
+        #undef out
+        #undef inout
+        #undef uniform
+
+        static void setUniforms(const shader_bench::frame_uniforms& frame)
+        {
+            time = frame.time;
+            mouse = vec2(frame.mouse_x, frame.mouse_y);
+            resolution = vec2(frame.width, frame.height);
+        }
+
+        static void addPasses(swizzle::glsl::pass_graph& graph, shader_bench::screen& target)
+        {
+            std::vector<size_t> screenInputs;
+            std::function<void()> bindInputs;
+
+#ifdef BENCHMARK_BUFFER_A_FILE
+            auto bufferA = std::make_shared<swizzle::glsl::render_target>(target.width, target.height);
+            bindInputs = [bufferA]()
+            {
+                iChannel0 = sampler2D(bufferA->front(), swizzle::glsl::wrap_mode::clamp, swizzle::glsl::texture_filter::linear, swizzle::glsl::texture_filter::linear);
+            };
+            swizzle::glsl::pass_graph::pass bufferAPass = { "BufferA", bufferA, 0, bindInputs,
+                [bufferA](unsigned y) { shader_bench::renderTargetRow<buffer_a::fragment_shader>(*bufferA, y); }, {} };
+            screenInputs.push_back(graph.add(bufferAPass));
+#endif
+
+            swizzle::glsl::pass_graph::pass screenPass = { "Image", nullptr, target.height, bindInputs,
+                [&target](unsigned y) { shader_bench::renderScreenRow<fragment_shader>(target, y); }, screenInputs };
+            graph.add(screenPass);
+        }
+
+        static const bool s_registered = (shader_bench::registry().push_back(shader_bench::shader_program{ BENCHMARK_STRINGIFY(BENCHMARK_SHADER_NAME), setUniforms, addPasses }), true);
+    }
+}
+
+#undef BENCHMARK_STRINGIFY
+#undef BENCHMARK_STRINGIFY_IMPL
@@ -0,0 +1,254 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// What the shader benchmark shares with each of the shaders: the sandbox types of sample/main.cpp, the
+// functions rendering rows of passes and the registry of shaders. Shaders themselves are compiled one per
+// translation unit, see shader_instance.h; this header is their precompiled prelude.
+#pragma once
+
+#if defined(USE_SIMD)
+#include "use_simd.h"
+#else
+#include "use_scalar.h"
+#endif
+
+#include <swizzle/glsl/vector.h>
+#include <swizzle/glsl/matrix.h>
+#include <swizzle/glsl/texture_sampler.h>
+#include <swizzle/glsl/pass_graph.h>
+#include <swizzle/glsl/uniform_scope.h>
+#include <swizzle/glsl/explicit_instantiation.h>
+#include "benchmark.h"
+#include "perf_counters.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef swizzle::glsl::vector< float_type, 2 > vec2;
+typedef swizzle::glsl::vector< float_type, 3 > vec3;
+typedef swizzle::glsl::vector< float_type, 4 > vec4;
+
+typedef swizzle::glsl::matrix< swizzle::glsl::vector, vec4::scalar_type, 2, 2> mat2;
+typedef swizzle::glsl::matrix< swizzle::glsl::vector, vec4::scalar_type, 3, 3> mat3;
+typedef swizzle::glsl::matrix< swizzle::glsl::vector, vec4::scalar_type, 4, 4> mat4;
+
+typedef swizzle::glsl::basic_sampler2D<float_type> sampler2D;
+typedef swizzle::glsl::basic_sampler3D<float_type> sampler3D;
+typedef swizzle::glsl::basic_samplerCube<float_type> samplerCube;
+
+// instantiated in shader_templates.cpp
+CXXSWIZZLE_EXTERN_TEMPLATES(float_type)
+
+namespace glsl_sandbox
+{
+    namespace ref
+    {
+#ifdef CXXSWIZZLE_VECTOR_INOUT_WRAPPER_ENABLED
+        typedef swizzle::detail::vector_inout_wrapper<vec2> vec2;
+        typedef swizzle::detail::vector_inout_wrapper<vec3> vec3;
+        typedef swizzle::detail::vector_inout_wrapper<vec4> vec4;
+#else
+        typedef vec2& vec2;
+        typedef vec3& vec3;
+        typedef vec4& vec4;
+#endif
+        typedef ::float_type& float_type;
+    }
+
+    namespace in
+    {
+        typedef const ::vec2& vec2;
+        typedef const ::vec3& vec3;
+        typedef const ::vec4& vec4;
+        typedef const ::float_type& float_type;
+    }
+
+    namespace uniform_types
+    {
+        typedef ::uniform_float_type float_type;
+        typedef ::vec2 vec2;
+        typedef ::vec3 vec3;
+        typedef ::vec4 vec4;
+    }
+}
+
+namespace shader_bench
+{
+    #include <swizzle/glsl/vector_functions.h>
+
+#if defined(USE_SIMD)
+    static const char c_backend[] = "vc_float";
+#else
+    static const char c_backend[] = "float";
+#endif
+
+    //! Pixels of the screen pass: 8 bit RGB, row y being the one with gl_FragCoord.y == y.
+    struct screen
+    {
+        unsigned width;
+        unsigned height;
+        std::vector<uint8_t> pixels;
+        //! If not empty (i.e. if sized as the screen), cycles spent on the batch of scalar_count pixels each
+        //! pixel was rendered in, of the last frame.
+        std::vector<uint64_t> batch_cycles;
+    };
+
+    //! Uniforms of a frame; all of them are fixed for a frame number, so frames are reproducible.
+    struct frame_uniforms
+    {
+        float time;
+        float mouse_x;
+        float mouse_y;
+        float width;
+        float height;
+    };
+
+    //! A shader of sample/shaders, with the passes it needs.
+    struct shader_program
+    {
+        std::string name;
+        //! Sets uniforms of the shader (and of its other passes).
+        std::function<void(const frame_uniforms&)> set_uniforms;
+        //! Adds passes of the shader to graph; the last one renders to target, the other ones to render
+        //! targets of the target's size, cleared.
+        std::function<void(swizzle::glsl::pass_graph& graph, screen& target)> add_passes;
+    };
+
+    inline std::vector<shader_program>& registry()
+    {
+        static std::vector<shader_program> s_registry;
+        return s_registry;
+    }
+
+    //! A 256x256 mipmapped, tiled pattern standing in for textures of the sample, so that runs do not
+    //! depend on files.
+    std::shared_ptr<const swizzle::glsl::texture_image> benchmarkTexture();
+
+    //! 1x1 transparent black, for samplers with nothing to sample yet.
+    std::shared_ptr<const swizzle::glsl::texture_image> blankTexture();
+
+    //! 0, 1, ..., scalar_count - 1; added to x of gl_FragCoord of a batch.
+    raw_float_type laneOffsets();
+
+    template <size_t Align, typename T>
+    T* alignPtr(T* ptr)
+    {
+        static_assert((Align & (Align - 1)) == 0, "Align needs to be a power of two");
+        auto value = reinterpret_cast<ptrdiff_t>(ptr);
+        return reinterpret_cast<T*>((value + Align) & (~(Align - 1)));
+    }
+
+    //! Renders row y of a render target with Shader, keeping colours as they are; same as the sample's.
+    template <class Shader>
+    void renderTargetRow(swizzle::glsl::render_target& target, unsigned y)
+    {
+        using ::swizzle::detail::static_for;
+
+        float unalignedBlob[4 * (scalar_count + float_entries_align / sizeof(float))];
+        float* pr = alignPtr<float_entries_align>(unalignedBlob);
+        float* pg = alignPtr<float_entries_align>(pr + scalar_count);
+        float* pb = alignPtr<float_entries_align>(pg + scalar_count);
+        float* pa = alignPtr<float_entries_align>(pb + scalar_count);
+
+        const raw_float_type offsets = laneOffsets();
+        Shader shader;
+        shader.gl_FragCoord.y = static_cast<float>(y);
+
+        int width = static_cast<int>(target.width());
+        int limitX = width - static_cast<int>(scalar_count);
+        for (int x = 0; x < width; x += scalar_count)
+        {
+            if (x > limitX)
+            {
+                x = limitX;
+            }
+
+            shader.gl_FragCoord.x = static_cast<float>(x) + offsets;
+            shader();
+
+            store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.r), pr);
+            store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.g), pg);
+            store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.b), pb);
+            store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.a), pa);
+
+            static_for<0, scalar_count>([&](size_t i)
+            {
+                target.store(static_cast<unsigned>(x) + static_cast<unsigned>(i), y, pr[i], pg[i], pb[i], pa[i]);
+            });
+        }
+    }
+
+    //! Renders row y of the screen with Shader, converting to 8 bits like the sample does.
+    template <class Shader>
+    void renderScreenRow(screen& target, unsigned y)
+    {
+        using ::swizzle::detail::static_for;
+
+        unsigned unalignedBlob[3 * (scalar_count + uint_entries_align / sizeof(unsigned))];
+        unsigned* pr = alignPtr<uint_entries_align>(unalignedBlob);
+        unsigned* pg = alignPtr<uint_entries_align>(pr + scalar_count);
+        unsigned* pb = alignPtr<uint_entries_align>(pg + scalar_count);
+
+        const float_type zero = 0.0f;
+        const float_type one = 1.0f;
+        const raw_float_type offsets = laneOffsets();
+        Shader shader;
+        shader.gl_FragCoord.y = static_cast<float>(y);
+
+        uint8_t* ptr = target.pixels.data() + 3 * y * target.width;
+        uint64_t* cycles = target.batch_cycles.empty() ? nullptr : target.batch_cycles.data() + y * target.width;
+        bench::perf::thread_counters* counters = bench::perf::local();
+
+        int width = static_cast<int>(target.width);
+        int limitX = width - static_cast<int>(scalar_count);
+        for (int x = 0; x < width; x += scalar_count)
+        {
+            if (x > limitX)
+            {
+                ptr -= 3 * (x - limitX);
+                x = limitX;
+            }
+
+            uint64_t start = cycles ? bench::cycles() : 0;
+            if (counters)
+            {
+                counters->begin(bench::perf::shading);
+            }
+
+            shader.gl_FragCoord.x = static_cast<float>(x) + offsets;
+            shader();
+
+            if (counters)
+            {
+                counters->end(bench::perf::shading);
+                counters->begin(bench::perf::packing);
+            }
+
+            auto color = clamp(shader.gl_FragColor, zero, one);
+            color *= 255 + 0.5f;
+
+            store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.r)), pr);
+            store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.g)), pg);
+            store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.b)), pb);
+
+            static_for<0, scalar_count>([&](size_t i)
+            {
+                *ptr++ = static_cast<uint8_t>(pr[i]);
+                *ptr++ = static_cast<uint8_t>(pg[i]);
+                *ptr++ = static_cast<uint8_t>(pb[i]);
+            });
+
+            if (counters)
+            {
+                counters->end(bench::perf::packing);
+            }
+            if (cycles)
+            {
+                std::fill(cycles + x, cycles + x + scalar_count, bench::cycles() - start);
+            }
+        }
+    }
+}
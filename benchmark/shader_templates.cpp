@@ -0,0 +1,9 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Functions of vectors, matrices and samplers of the backend, instantiated once for all the shaders of the
+// benchmark; shader_sandbox.h declares them extern. See swizzle/glsl/explicit_instantiation.h.
+
+#include "shader_sandbox.h"
+
+CXXSWIZZLE_INSTANTIATE_TEMPLATES(float_type)
@@ -0,0 +1,636 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Renders shaders of sample/shaders headlessly, for float (shaders_scalar) or vc_float (shaders_simd)
+// scalars. Each shader is rendered at every resolution with every thread count; a run renders some
+// warm-up frames and then the measured ones. Frame i of a run has time = start + i / 60 and the mouse
+// in the middle of the screen, so the same frames get rendered every time and their checksum (of the
+// last frame's pixels) tells whether a change to the library changed the output as well.
+//
+// Reported are pixels per second, percentiles of frame times and scaling efficiency: speedup over the
+// smallest thread count divided by the ratio of thread counts, i.e. 1 for perfect scaling.
+//
+// With --save-frames, last frames are saved as PPM (and listed in frames.txt) for the equivalence
+// report to compare frames of the backends.
+//
+// With --heatmap, cycles spent on each batch of pixels (scalar_count of them, one call of the shader) of
+// last frames are saved too, as a PPM heatmap and as CSV summed over tiles of --tile-size pixels.
+//
+// With --perf, events of shading and packing pixels are counted with perf_event_open (see
+// perf_counters.h) and reported per pixel, next to the times.
+//
+// Built with CXXSWIZZLE_INSTRUMENTATION (see swizzle/detail/instrumentation.h), --counters writes calls
+// (and cycles) of builtins, texture functions and swizzle decays of every measured frame to a file.
+
+#include "shader_sandbox.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace shader_bench
+{
+    std::shared_ptr<const swizzle::glsl::texture_image> benchmarkTexture()
+    {
+        static const std::shared_ptr<const swizzle::glsl::texture_image> s_texture = []()
+        {
+            const unsigned size = 256;
+            std::vector<unsigned> texels(size * size);
+            for (unsigned y = 0; y < size; ++y)
+            {
+                for (unsigned x = 0; x < size; ++x)
+                {
+                    unsigned r = (x ^ y) & 0xff;
+                    unsigned g = (x * x + y * 3) & 0xff;
+                    unsigned b = ((x / 32 + y / 32) & 1) ? 0xe0 : 0x20;
+                    texels[y * size + x] = 0xff000000u | (b << 16) | (g << 8) | r;
+                }
+            }
+            auto result = std::make_shared<swizzle::glsl::texture_image>(size, size, std::move(texels));
+            result->generate_mipmaps();
+            result->set_layout(swizzle::glsl::texture_layout::tiled);
+            return result;
+        }();
+        return s_texture;
+    }
+
+    std::shared_ptr<const swizzle::glsl::texture_image> blankTexture()
+    {
+        return std::make_shared<swizzle::glsl::texture_image>(1, 1, std::vector<swizzle::glsl::texture_image::texel_type>(1, 0u));
+    }
+
+    raw_float_type laneOffsets()
+    {
+        using ::swizzle::detail::static_for;
+
+        // see the sample's renderThread for why not std::aligned_storage
+        uint8_t unalignedBlob[scalar_count * sizeof(float) + float_entries_align];
+        float* aligned = alignPtr<float_entries_align>(reinterpret_cast<float*>(unalignedBlob));
+        static_for<0, scalar_count>([&](size_t i) { aligned[i] = static_cast<float>(i); });
+
+        raw_float_type result;
+        load_aligned(result, aligned);
+        return result;
+    }
+
+    //! Threads sharing rows of a wave; the thread calling parallel_for is one of them. Threads are kept
+    //! between waves, so that starting them is not measured.
+    class worker_pool
+    {
+    public:
+        explicit worker_pool(unsigned threads)
+            : m_func(nullptr)
+            , m_count(0)
+            , m_next(0)
+            , m_generation(0)
+            , m_busy(0)
+            , m_stop(false)
+        {
+            for (unsigned i = 1; i < threads; ++i)
+            {
+                m_workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        ~worker_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_start.notify_all();
+            for (std::thread& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        void parallel_for(size_t count, const std::function<void(size_t)>& func)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_func = &func;
+                m_count = count;
+                m_next = 0;
+                m_busy = m_workers.size();
+                ++m_generation;
+            }
+            m_start.notify_all();
+            run();
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return m_busy == 0; });
+        }
+
+    private:
+        void run()
+        {
+            for (size_t i = m_next++; i < m_count; i = m_next++)
+            {
+                (*m_func)(i);
+            }
+        }
+
+        void work()
+        {
+            unsigned long long generation = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    generation = m_generation;
+                }
+
+                run();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_busy == 0)
+                {
+                    m_done.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        const std::function<void(size_t)>* m_func;
+        size_t m_count;
+        std::atomic<size_t> m_next;
+        unsigned long long m_generation;
+        size_t m_busy;
+        bool m_stop;
+    };
+
+    struct resolution
+    {
+        unsigned width;
+        unsigned height;
+
+        std::string name() const
+        {
+            return std::to_string(width) + "x" + std::to_string(height);
+        }
+    };
+
+    struct shader_options : bench::options
+    {
+        std::vector<resolution> resolutions;
+        //! Ascending.
+        std::vector<unsigned> threads;
+        unsigned frames;
+        unsigned warmup;
+        float start_time;
+        //! Directory to save last frames to; none if empty.
+        std::string save_frames;
+        //! File to write counters of instrumented builds to; none if empty.
+        std::string counters;
+        //! Directory to save cycles of last frames' batches to; none if empty.
+        std::string heatmap;
+        unsigned tile_size;
+        //! Events to count; none if empty.
+        std::vector<bench::perf::event> perf_events;
+
+        shader_options()
+            : frames(5)
+            , warmup(1)
+            , start_time(1)
+            , tile_size(16)
+        {
+            resolutions.push_back(resolution{ 160, 90 });
+            resolutions.push_back(resolution{ 320, 180 });
+
+            // 1, 2, 4, ... and all the cores
+            unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned count = 1; count < cores; count *= 2)
+            {
+                threads.push_back(count);
+            }
+            threads.push_back(cores);
+        }
+
+    protected:
+        bool parse_extra(const std::string& arg, const char* value) override
+        {
+            if (arg == "--resolutions")
+            {
+                resolutions.clear();
+                for (const std::string& item : split(value))
+                {
+                    resolution r = { 0, 0 };
+                    if (std::sscanf(item.c_str(), "%ux%u", &r.width, &r.height) != 2 || !r.width || !r.height)
+                    {
+                        return false;
+                    }
+                    resolutions.push_back(r);
+                }
+                return !resolutions.empty();
+            }
+            else if (arg == "--threads")
+            {
+                threads.clear();
+                for (const std::string& item : split(value))
+                {
+                    int count = std::atoi(item.c_str());
+                    if (count <= 0)
+                    {
+                        return false;
+                    }
+                    threads.push_back(static_cast<unsigned>(count));
+                }
+                std::sort(threads.begin(), threads.end());
+                threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+                return !threads.empty();
+            }
+            else if (arg == "--frames")
+            {
+                frames = static_cast<unsigned>(std::max(1, std::atoi(value)));
+                return true;
+            }
+            else if (arg == "--warmup")
+            {
+                warmup = static_cast<unsigned>(std::max(0, std::atoi(value)));
+                return true;
+            }
+            else if (arg == "--time")
+            {
+                start_time = static_cast<float>(std::atof(value));
+                return true;
+            }
+            else if (arg == "--save-frames")
+            {
+                save_frames = value;
+                return true;
+            }
+            else if (arg == "--counters")
+            {
+                counters = value;
+                return true;
+            }
+            else if (arg == "--heatmap")
+            {
+                heatmap = value;
+                return true;
+            }
+            else if (arg == "--perf")
+            {
+                perf_events.clear();
+                return bench::perf::parse_events(value, perf_events);
+            }
+            else if (arg == "--tile-size")
+            {
+                int size = std::atoi(value);
+                tile_size = static_cast<unsigned>(std::max(1, size));
+                return size > 0;
+            }
+            return false;
+        }
+
+        std::string usage_extra() const override
+        {
+            return " [--resolutions WxH,...] [--threads n,...] [--frames n] [--warmup n] [--time seconds] [--save-frames dir] [--counters file] [--heatmap dir] [--tile-size n] [--perf event,...]";
+        }
+
+    private:
+        static std::vector<std::string> split(const std::string& text)
+        {
+            std::vector<std::string> result;
+            std::istringstream s(text);
+            std::string item;
+            while (std::getline(s, item, ','))
+            {
+                result.push_back(item);
+            }
+            return result;
+        }
+    };
+
+    struct run_result
+    {
+        //! Milliseconds, in order of frames.
+        std::vector<double> frame_ms;
+        //! FNV-1a of the last frame's pixels.
+        uint32_t checksum;
+        screen last_frame;
+        //! Of the measured frames, if counting.
+        bench::perf::counts perf;
+    };
+
+#ifdef CXXSWIZZLE_INSTRUMENTATION
+    //! Adds counters of a frame to report, one record per function, and resets them.
+    void reportCounters(bench::report& report, const shader_program& shader, const resolution& res, unsigned threads, unsigned frame)
+    {
+        namespace instrumentation = swizzle::detail::instrumentation;
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+
+        for (const instrumentation::function_counters& function : instrumentation::collect(true))
+        {
+            double cycles = instrumentation::timing_enabled() ? static_cast<double>(function.cycles) : nan;
+            bench::record r;
+            r.text("suite", "counters").text("name", shader.name).text("backend", c_backend).text("resolution", res.name())
+                .integer("threads", threads).integer("frame", frame)
+                .text("category", function.category).text("function", function.name)
+                .integer("calls", static_cast<long long>(function.calls))
+                .number("cycles", cycles, 0)
+                .number("cycles_per_call", cycles / static_cast<double>(function.calls), 1);
+            report.add(r);
+        }
+    }
+#endif
+
+    //! Renders a run of frames; counters of measured frames are added to counters if it is not null (and
+    //! the build is instrumented).
+    run_result render(const shader_options& opts, const shader_program& shader, const resolution& res, unsigned threads, bench::report* counters)
+    {
+        typedef std::chrono::steady_clock clock;
+
+        screen target = { res.width, res.height, std::vector<uint8_t>(3 * res.width * res.height), std::vector<uint64_t>() };
+        if (!opts.heatmap.empty())
+        {
+            target.batch_cycles.resize(res.width * res.height);
+        }
+        swizzle::glsl::pass_graph graph;
+        shader.add_passes(graph, target);
+
+        worker_pool pool(threads);
+        auto parallelFor = [&pool](size_t count, const std::function<void(size_t)>& func)
+        {
+            pool.parallel_for(count, func);
+        };
+
+#ifdef CXXSWIZZLE_INSTRUMENTATION
+        // whatever setting up the passes called
+        swizzle::detail::instrumentation::collect(true);
+#endif
+
+        run_result result;
+        for (unsigned frame = 0; frame < opts.warmup + opts.frames; ++frame)
+        {
+            frame_uniforms uniforms = { opts.start_time + frame / 60.0f, 0.5f, 0.5f, static_cast<float>(res.width), static_cast<float>(res.height) };
+            shader.set_uniforms(uniforms);
+            swizzle::glsl::uniform_scope::next_frame();
+
+            if (frame == opts.warmup && bench::perf::session::get().enabled())
+            {
+                // counts of warm-up frames are dropped
+                bench::perf::session::get().collect();
+            }
+
+            clock::time_point start = clock::now();
+            graph.render_frame(parallelFor);
+            double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            if (frame >= opts.warmup)
+            {
+                result.frame_ms.push_back(ms);
+            }
+
+#ifdef CXXSWIZZLE_INSTRUMENTATION
+            if (counters && frame >= opts.warmup)
+            {
+                reportCounters(*counters, shader, res, threads, frame - opts.warmup);
+            }
+            else
+            {
+                swizzle::detail::instrumentation::collect(true);
+            }
+#else
+            (void)counters;
+#endif
+        }
+
+        if (bench::perf::session::get().enabled())
+        {
+            result.perf = bench::perf::session::get().collect();
+        }
+
+        result.checksum = 2166136261u;
+        for (uint8_t value : target.pixels)
+        {
+            result.checksum = (result.checksum ^ value) * 16777619u;
+        }
+        result.last_frame = std::move(target);
+        return result;
+    }
+
+    //! Saves frame as dir/name.ppm, adding it to dir/frames.txt; returns false if unable to.
+    bool saveFrame(const std::string& dir, const std::string& name, const screen& frame)
+    {
+        std::ofstream file((dir + "/" + name + ".ppm").c_str(), std::ios::binary);
+        file << "P6\n" << frame.width << " " << frame.height << "\n255\n";
+        // rows of PPMs go top to bottom
+        for (unsigned y = frame.height; y-- > 0;)
+        {
+            file.write(reinterpret_cast<const char*>(frame.pixels.data() + 3 * y * frame.width), 3 * frame.width);
+        }
+        std::ofstream list((dir + "/frames.txt").c_str(), std::ios::app);
+        list << name << ".ppm\n";
+        return file && list;
+    }
+
+    //! Saves cycles of frame's batches as dir/name_heatmap.ppm, black being free and white as expensive as
+    //! the 99th percentile of pixels or more, and as dir/name_tiles.csv, summed over tiles of tile_size
+    //! pixels (y of tiles as of gl_FragCoord, i.e. going up). Returns false if unable to.
+    bool saveHeatmap(const std::string& dir, const std::string& name, const screen& frame, unsigned tile_size)
+    {
+        std::vector<uint64_t> sorted = frame.batch_cycles;
+        std::sort(sorted.begin(), sorted.end());
+        double scale = sorted.empty() || !sorted[sorted.size() * 99 / 100] ? 0.0 : 1.0 / sorted[sorted.size() * 99 / 100];
+
+        std::ofstream image((dir + "/" + name + "_heatmap.ppm").c_str(), std::ios::binary);
+        image << "P6\n" << frame.width << " " << frame.height << "\n255\n";
+        std::vector<uint8_t> row(3 * frame.width);
+        for (unsigned y = frame.height; y-- > 0;)
+        {
+            for (unsigned x = 0; x < frame.width; ++x)
+            {
+                // black, red, yellow, white
+                double heat = std::min(1.0, frame.batch_cycles[y * frame.width + x] * scale);
+                for (unsigned channel = 0; channel < 3; ++channel)
+                {
+                    row[3 * x + channel] = static_cast<uint8_t>(255 * std::min(1.0, std::max(0.0, 3 * heat - channel)) + 0.5);
+                }
+            }
+            image.write(reinterpret_cast<const char*>(row.data()), row.size());
+        }
+
+        // batches are counted in the tile of their first pixel; rows start with a batch at every multiple of
+        // scalar_count, except for the last one which may overlap the one before (see renderScreenRow)
+        const unsigned lastBatch = frame.width >= scalar_count ? frame.width - static_cast<unsigned>(scalar_count) : 0;
+        std::ofstream tiles((dir + "/" + name + "_tiles.csv").c_str());
+        tiles << "x,y,width,height,batches,cycles,cycles_per_pixel,batch_cycles_min,batch_cycles_max\n";
+        for (unsigned ty = 0; ty < frame.height; ty += tile_size)
+        {
+            for (unsigned tx = 0; tx < frame.width; tx += tile_size)
+            {
+                unsigned width = std::min(tile_size, frame.width - tx);
+                unsigned height = std::min(tile_size, frame.height - ty);
+                uint64_t batches = 0, cycles = 0, min = std::numeric_limits<uint64_t>::max(), max = 0;
+                for (unsigned y = ty; y < ty + height; ++y)
+                {
+                    for (unsigned x = tx; x < tx + width; ++x)
+                    {
+                        if ((x % scalar_count == 0 && x <= lastBatch) || x == lastBatch)
+                        {
+                            uint64_t batch = frame.batch_cycles[y * frame.width + x];
+                            ++batches;
+                            cycles += batch;
+                            min = std::min(min, batch);
+                            max = std::max(max, batch);
+                        }
+                    }
+                }
+                tiles << tx << ',' << ty << ',' << width << ',' << height << ',' << batches << ',' << cycles << ','
+                    << static_cast<double>(cycles) / (width * height) << ',' << (batches ? min : 0) << ',' << max << '\n';
+            }
+        }
+        return image && tiles;
+    }
+
+    //! Adds counts of events per pixel (phase_event_per_pixel) to r, and IPC and cache miss rate where the
+    //! events needed are counted.
+    void addPerf(bench::record& r, const std::vector<bench::perf::event>& events, const bench::perf::counts& counts, double pixels)
+    {
+        using namespace bench::perf;
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+
+        for (size_t p = 0; p < phase_count; ++p)
+        {
+            std::string prefix = phase_name(static_cast<phase>(p));
+            double cycles = nan, instructions = nan, references = nan, misses = nan;
+            for (size_t i = 0; i < events.size(); ++i)
+            {
+                double value = counts.values[p][i];
+                r.number(prefix + "_" + events[i].name + "_per_pixel", value / pixels);
+
+                cycles = events[i].name == "cycles" ? value : cycles;
+                instructions = events[i].name == "instructions" ? value : instructions;
+                references = events[i].name == "cache_references" ? value : references;
+                misses = events[i].name == "cache_misses" ? value : misses;
+            }
+            r.number(prefix + "_ipc", instructions / cycles, 3);
+            r.number(prefix + "_cache_miss_rate", misses / references);
+        }
+    }
+
+    //! Nearest-rank percentile of sorted values.
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100 * sorted.size()));
+        return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace shader_bench;
+
+    shader_options opts;
+    if (!opts.parse(argc, argv))
+    {
+        return 1;
+    }
+    bench::report report(opts);
+
+    // counters go to a file of their own, as their records have different fields
+    std::ofstream countersFile;
+    std::unique_ptr<bench::report> counters;
+    if (!opts.counters.empty())
+    {
+#ifdef CXXSWIZZLE_INSTRUMENTATION
+        countersFile.open(opts.counters.c_str());
+        if (!countersFile)
+        {
+            std::cerr << "ERROR: unable to write counters to " << opts.counters << std::endl;
+            return 1;
+        }
+        counters.reset(new bench::report(opts, countersFile));
+#else
+        std::cerr << "ERROR: --counters needs a build with CXXSWIZZLE_INSTRUMENTATION defined" << std::endl;
+        return 1;
+#endif
+    }
+
+    bench::perf::session::get().configure(opts.perf_events);
+
+    if (!opts.save_frames.empty())
+    {
+        // frames.txt is appended to
+        std::ofstream((opts.save_frames + "/frames.txt").c_str(), std::ios::trunc);
+    }
+
+    // translation units register in no particular order
+    std::vector<shader_program> shaders = registry();
+    std::sort(shaders.begin(), shaders.end(), [](const shader_program& a, const shader_program& b) { return a.name < b.name; });
+
+    for (const shader_program& shader : shaders)
+    {
+        for (const resolution& res : opts.resolutions)
+        {
+            if (!opts.matches(shader.name, res.name()))
+            {
+                continue;
+            }
+
+            double baselinePixelsPerS = 0;
+            for (unsigned threads : opts.threads)
+            {
+                run_result run = render(opts, shader, res, threads, counters.get());
+
+                double totalMs = 0;
+                for (double ms : run.frame_ms)
+                {
+                    totalMs += ms;
+                }
+                double pixelsPerS = 1000.0 * res.width * res.height * run.frame_ms.size() / totalMs;
+                if (threads == opts.threads.front())
+                {
+                    baselinePixelsPerS = pixelsPerS;
+                    if (!opts.save_frames.empty() && !saveFrame(opts.save_frames, shader.name + "_" + res.name(), run.last_frame))
+                    {
+                        std::cerr << "ERROR: unable to save frames to " << opts.save_frames << std::endl;
+                        return 1;
+                    }
+                    if (!opts.heatmap.empty() && !saveHeatmap(opts.heatmap, shader.name + "_" + res.name(), run.last_frame, opts.tile_size))
+                    {
+                        std::cerr << "ERROR: unable to save heatmaps to " << opts.heatmap << std::endl;
+                        return 1;
+                    }
+                }
+
+                std::sort(run.frame_ms.begin(), run.frame_ms.end());
+                char checksum[9];
+                std::snprintf(checksum, sizeof(checksum), "%08x", run.checksum);
+
+                bench::record r;
+                r.text("suite", "shaders").text("name", shader.name).text("backend", c_backend).text("resolution", res.name())
+                    .integer("threads", threads).integer("frames", static_cast<long long>(run.frame_ms.size()))
+                    .number("mpixels_per_s", pixelsPerS / 1e6)
+                    .number("frame_ms_min", run.frame_ms.front())
+                    .number("frame_ms_p50", percentile(run.frame_ms, 50))
+                    .number("frame_ms_p90", percentile(run.frame_ms, 90))
+                    .number("frame_ms_p99", percentile(run.frame_ms, 99))
+                    .number("scaling_efficiency", pixelsPerS / baselinePixelsPerS * opts.threads.front() / threads)
+                    .text("checksum", checksum);
+                if (!opts.perf_events.empty())
+                {
+                    addPerf(r, opts.perf_events, run.perf, static_cast<double>(res.width) * res.height * run.frame_ms.size());
+                }
+                report.add(r);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,276 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace swizzle
+{
+    namespace detail
+    {
+        //! Decodes a whole BC7 (BPTC) block into 16 packed RGBA8 texels, row after row, top-down. Way too
+        //! branchy to be done per texel, let alone per SIMD lane, so samplers cache decoded blocks.
+        class bc7_decoder
+        {
+        public:
+            static void decode(const uint8_t* block, uint32_t texels[16])
+            {
+                unsigned mode = 0;
+                while (mode < 8 && !(block[0] & (1u << mode)))
+                {
+                    ++mode;
+                }
+                if (mode == 8)
+                {
+                    // reserved, decodes to transparent black
+                    std::fill(texels, texels + 16, 0u);
+                    return;
+                }
+
+                const mode_info& info = modes()[mode];
+                bit_reader reader = { block, mode + 1 };
+
+                unsigned partition = reader.read(info.partition_bits);
+                unsigned rotation = reader.read(info.rotation_bits);
+                unsigned index_selection = reader.read(info.index_selection_bits);
+
+                // [subset][endpoint][channel]
+                unsigned endpoints[3][2][4];
+                for (unsigned channel = 0; channel < 4; ++channel)
+                {
+                    unsigned bits = channel < 3 ? info.color_bits : info.alpha_bits;
+                    for (unsigned subset = 0; subset < info.subsets; ++subset)
+                    {
+                        for (unsigned i = 0; i < 2; ++i)
+                        {
+                            endpoints[subset][i][channel] = reader.read(bits);
+                        }
+                    }
+                }
+
+                // p-bits become the lowest bit of all the channels
+                unsigned color_bits = info.color_bits;
+                unsigned alpha_bits = info.alpha_bits;
+                if (info.endpoint_pbits || info.shared_pbits)
+                {
+                    for (unsigned subset = 0; subset < info.subsets; ++subset)
+                    {
+                        unsigned shared = info.shared_pbits ? reader.read(1) : 0;
+                        for (unsigned i = 0; i < 2; ++i)
+                        {
+                            unsigned pbit = info.shared_pbits ? shared : reader.read(1);
+                            for (unsigned channel = 0; channel < 4; ++channel)
+                            {
+                                endpoints[subset][i][channel] = (endpoints[subset][i][channel] << 1) | pbit;
+                            }
+                        }
+                    }
+                    ++color_bits;
+                    alpha_bits += alpha_bits ? 1 : 0;
+                }
+
+                for (unsigned subset = 0; subset < info.subsets; ++subset)
+                {
+                    for (unsigned i = 0; i < 2; ++i)
+                    {
+                        for (unsigned channel = 0; channel < 4; ++channel)
+                        {
+                            unsigned bits = channel < 3 ? color_bits : alpha_bits;
+                            unsigned& value = endpoints[subset][i][channel];
+                            value = bits ? expand(value, bits) : 255u;
+                        }
+                    }
+                }
+
+                unsigned subsets[16];
+                for (unsigned i = 0; i < 16; ++i)
+                {
+                    subsets[i] = subset_of(info.subsets, partition, i);
+                }
+
+                unsigned indices[16];
+                for (unsigned i = 0; i < 16; ++i)
+                {
+                    // the highest bit of anchors' indices is implied to be 0
+                    indices[i] = reader.read(is_anchor(info.subsets, partition, subsets[i], i) ? info.index_bits - 1 : info.index_bits);
+                }
+
+                unsigned alpha_indices[16];
+                if (info.alpha_index_bits)
+                {
+                    for (unsigned i = 0; i < 16; ++i)
+                    {
+                        alpha_indices[i] = reader.read(i == 0 ? info.alpha_index_bits - 1 : info.alpha_index_bits);
+                    }
+                }
+
+                for (unsigned i = 0; i < 16; ++i)
+                {
+                    const unsigned (&e)[2][4] = endpoints[subsets[i]];
+                    unsigned color_index = indices[i];
+                    unsigned color_index_bits = info.index_bits;
+                    unsigned alpha_index = indices[i];
+                    unsigned alpha_index_bits = info.index_bits;
+                    if (info.alpha_index_bits)
+                    {
+                        alpha_index = alpha_indices[i];
+                        alpha_index_bits = info.alpha_index_bits;
+                        if (index_selection)
+                        {
+                            std::swap(color_index, alpha_index);
+                            std::swap(color_index_bits, alpha_index_bits);
+                        }
+                    }
+
+                    unsigned rgba[4];
+                    for (unsigned channel = 0; channel < 3; ++channel)
+                    {
+                        rgba[channel] = interpolate(e[0][channel], e[1][channel], color_index, color_index_bits);
+                    }
+                    rgba[3] = interpolate(e[0][3], e[1][3], alpha_index, alpha_index_bits);
+
+                    if (rotation)
+                    {
+                        std::swap(rgba[3], rgba[rotation - 1]);
+                    }
+                    texels[i] = rgba[0] | (rgba[1] << 8) | (rgba[2] << 16) | (rgba[3] << 24);
+                }
+            }
+
+        private:
+            struct mode_info
+            {
+                unsigned subsets;
+                unsigned partition_bits;
+                unsigned rotation_bits;
+                unsigned index_selection_bits;
+                unsigned color_bits;
+                unsigned alpha_bits;
+                unsigned endpoint_pbits;
+                unsigned shared_pbits;
+                unsigned index_bits;
+                unsigned alpha_index_bits;
+            };
+
+            struct bit_reader
+            {
+                const uint8_t* data;
+                unsigned position;
+
+                unsigned read(unsigned bits)
+                {
+                    unsigned result = 0;
+                    for (unsigned i = 0; i < bits; ++i, ++position)
+                    {
+                        result |= ((data[position / 8] >> (position % 8)) & 1u) << i;
+                    }
+                    return result;
+                }
+            };
+
+            static const mode_info* modes()
+            {
+                static const mode_info s_modes[8] =
+                {
+                    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+                    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+                    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+                    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+                    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+                    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+                    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+                    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 }
+                };
+                return s_modes;
+            }
+
+            //! Replicates the highest bits into the lowest ones.
+            static unsigned expand(unsigned value, unsigned bits)
+            {
+                value <<= 8 - bits;
+                return value | (value >> bits);
+            }
+
+            static unsigned interpolate(unsigned e0, unsigned e1, unsigned index, unsigned bits)
+            {
+                static const unsigned s_weights2[] = { 0, 21, 43, 64 };
+                static const unsigned s_weights3[] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+                static const unsigned s_weights4[] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+                unsigned weight = bits == 2 ? s_weights2[index] : (bits == 3 ? s_weights3[index] : s_weights4[index]);
+                return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+            }
+
+            static unsigned subset_of(unsigned subsets, unsigned partition, unsigned texel)
+            {
+                // bit per texel
+                static const uint16_t s_partitions2[64] =
+                {
+                    0xccccu, 0x8888u, 0xeeeeu, 0xecc8u, 0xc880u, 0xfeecu, 0xfec8u, 0xec80u,
+                    0xc800u, 0xffecu, 0xfe80u, 0xe800u, 0xffe8u, 0xff00u, 0xfff0u, 0xf000u,
+                    0xf710u, 0x008eu, 0x7100u, 0x08ceu, 0x008cu, 0x7310u, 0x3100u, 0x8cceu,
+                    0x088cu, 0x3110u, 0x6666u, 0x366cu, 0x17e8u, 0x0ff0u, 0x718eu, 0x399cu,
+                    0xaaaau, 0xf0f0u, 0x5a5au, 0x33ccu, 0x3c3cu, 0x55aau, 0x9696u, 0xa55au,
+                    0x73ceu, 0x13c8u, 0x324cu, 0x3bdcu, 0x6996u, 0xc33cu, 0x9966u, 0x0660u,
+                    0x0272u, 0x04e4u, 0x4e40u, 0x2720u, 0xc936u, 0x936cu, 0x39c6u, 0x639cu,
+                    0x9336u, 0x9cc6u, 0x817eu, 0xe718u, 0xccf0u, 0x0fccu, 0x7744u, 0xee22u
+                };
+                // two bits per texel
+                static const uint32_t s_partitions3[64] =
+                {
+                    0xaa685050u, 0x6a5a5040u, 0x5a5a4200u, 0x5450a0a8u, 0xa5a50000u, 0xa0a05050u, 0x5555a0a0u, 0x5a5a5050u,
+                    0xaa550000u, 0xaa555500u, 0xaaaa5500u, 0x90909090u, 0x94949494u, 0xa4a4a4a4u, 0xa9a59450u, 0x2a0a4250u,
+                    0xa5945040u, 0x0a425054u, 0xa5a5a500u, 0x55a0a0a0u, 0xa8a85454u, 0x6a6a4040u, 0xa4a45000u, 0x1a1a0500u,
+                    0x0050a4a4u, 0xaaa59090u, 0x14696914u, 0x69691400u, 0xa08585a0u, 0xaa821414u, 0x50a4a450u, 0x6a5a0200u,
+                    0xa9a58000u, 0x5090a0a8u, 0xa8a09050u, 0x24242424u, 0x00aa5500u, 0x24924924u, 0x24499224u, 0x50a50a50u,
+                    0x500aa550u, 0xaaaa4444u, 0x66660000u, 0xa5a0a5a0u, 0x50a050a0u, 0x69286928u, 0x44aaaa44u, 0x66666600u,
+                    0xaa444444u, 0x54a854a8u, 0x95809580u, 0x96969600u, 0xa85454a8u, 0x80959580u, 0xaa141414u, 0x96960000u,
+                    0xaaaa1414u, 0xa05050a0u, 0xa0a5a5a0u, 0x96000000u, 0x40804080u, 0xa9a8a9a8u, 0xaaaaaa44u, 0x2a4a5254u
+                };
+
+                switch (subsets)
+                {
+                case 2:
+                    return (s_partitions2[partition] >> texel) & 1u;
+                case 3:
+                    return (s_partitions3[partition] >> (texel * 2)) & 3u;
+                default:
+                    return 0;
+                }
+            }
+
+            //! Anchors are the texels whose index's highest bit is omitted; texel 0 is the anchor of subset 0.
+            static bool is_anchor(unsigned subsets, unsigned partition, unsigned subset, unsigned texel)
+            {
+                static const uint8_t s_anchors2[64] =
+                {
+                    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+                    15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+                    15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+                    6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15
+                };
+                static const uint8_t s_anchors3[2][64] =
+                {
+                    {
+                        3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+                        3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+                        8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+                        3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3
+                    },
+                    {
+                        15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+                        15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+                        15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+                        15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8
+                    }
+                };
+
+                if (subset == 0)
+                {
+                    return texel == 0;
+                }
+                return texel == (subsets == 2 ? s_anchors2[partition] : s_anchors3[subset - 1][partition]);
+            }
+        };
+    }
+}
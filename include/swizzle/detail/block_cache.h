@@ -0,0 +1,91 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace swizzle
+{
+    namespace detail
+    {
+        //! Lookup counters of a block_cache.
+        struct block_cache_stats
+        {
+            uint64_t hits;
+            uint64_t misses;
+
+            //! 0 if there were no lookups.
+            double hit_rate() const
+            {
+                uint64_t lookups = hits + misses;
+                return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+            }
+        };
+
+        //! Identifies owners of cached blocks; ids start at 1, so zero-initialised entries are empty.
+        inline unsigned next_block_cache_owner()
+        {
+            static std::atomic<unsigned> s_id(0);
+            return ++s_id;
+        }
+
+        //! A small direct-mapped cache of decoded blocks of block_texels texels, keyed by an owner (an image)
+        //! and a block index. There is one per thread (and Texel type), hence no synchronisation and no
+        //! sharing of cache lines between cores; counters are per thread too.
+        template <class Texel, size_t Size, size_t BlockTexels = 16>
+        class block_cache
+        {
+        public:
+            static const size_t block_texels = BlockTexels;
+
+            //! Texels of the block, decoded with decode(block, Texel*) on a miss. Valid until the next lookup
+            //! of the thread.
+            template <class Decode>
+            static const Texel* lookup(unsigned owner, size_t block, const Decode& decode)
+            {
+                state& cache = local();
+                entry& cached = cache.entries[(block + owner * 31) % Size];
+                if (cached.owner != owner || cached.block != block)
+                {
+                    decode(block, cached.texels);
+                    cached.owner = owner;
+                    cached.block = block;
+                    ++cache.stats.misses;
+                }
+                else
+                {
+                    ++cache.stats.hits;
+                }
+                return cached.texels;
+            }
+
+            //! Counters of the calling thread; may be reset by assigning zeros.
+            static block_cache_stats& stats()
+            {
+                return local().stats;
+            }
+
+        private:
+            struct entry
+            {
+                unsigned owner;
+                size_t block;
+                Texel texels[BlockTexels];
+            };
+
+            struct state
+            {
+                entry entries[Size];
+                block_cache_stats stats;
+            };
+
+            static state& local()
+            {
+                static thread_local state s_state = {};
+                return s_state;
+            }
+        };
+    }
+}
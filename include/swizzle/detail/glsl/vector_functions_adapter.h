@@ -32,6 +32,12 @@
 
 namespace swizzle
 {
+    namespace glsl
+    {
+        template <template <class, size_t> class VectorType, class ScalarType, size_t N, size_t M, class>
+        class matrix;
+    }
+
     namespace detail
     {
         namespace glsl
@@ -98,6 +104,26 @@ namespace swizzle
                     }
                 };
 
+                //! x * a + y
+                struct functor_mad
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type x, scalar_arg_type a, vector_arg_type y)
+                    {
+                        using namespace std;
+                        result.at(i) = mad(x.at(i), a, y.at(i));
+                    }
+                };
+
+                //! x * a + y * b
+                struct functor_linear_combination
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type x, scalar_arg_type a, vector_arg_type y, scalar_arg_type b)
+                    {
+                        using namespace std;
+                        result.at(i) = mad(x.at(i), a, y.at(i) * b);
+                    }
+                };
+
                 struct functor_sin
                 {
                     template <size_t i> void operator()(vector_type& result, vector_arg_type x)
@@ -232,7 +258,7 @@ namespace swizzle
                     template <size_t i> void operator()(vector_type& result, vector_arg_type x)
                     {
                         using namespace std;
-                        result.at(i) = rsqrt(x.at(i));
+                        result.at(i) = inversesqrt(x.at(i));
                     }
                 };
 
@@ -361,7 +387,18 @@ namespace swizzle
                 {
                     template <size_t i> void operator()(scalar_type& result, vector_arg_type x, vector_arg_type y)
                     {
-                        result += x.at(i) * y.at(i);
+                        using namespace std;
+                        result = mad(x.at(i), y.at(i), result);
+                    }
+                };
+
+                struct functor_distance
+                {
+                    template <size_t i> void operator()(scalar_type& result, vector_arg_type p0, vector_arg_type p1)
+                    {
+                        using namespace std;
+                        scalar_type d = p0.at(i) - p1.at(i);
+                        result = mad(d, d, result);
                     }
                 };
 
@@ -383,6 +420,52 @@ namespace swizzle
                     }
                 };
 
+                struct functor_trunc
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type x)
+                    {
+                        using namespace std;
+                        result.at(i) = trunc(x.at(i));
+                    }
+                };
+
+                struct functor_round
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type x)
+                    {
+                        using namespace std;
+                        result.at(i) = round(x.at(i));
+                    }
+                };
+
+                struct functor_roundEven
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type x)
+                    {
+                        using namespace std;
+                        result.at(i) = roundEven(x.at(i));
+                    }
+                };
+
+                struct functor_fma
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type a, vector_arg_type b, vector_arg_type c)
+                    {
+                        using namespace std;
+                        result.at(i) = mad(a.at(i), b.at(i), c.at(i));
+                    }
+                };
+
+                struct functor_modf
+                {
+                    template <size_t i> void operator()(vector_type& result, vector_arg_type x, vector_type& integral)
+                    {
+                        using namespace std;
+                        integral.at(i) = trunc(x.at(i));
+                        result.at(i) = x.at(i) - integral.at(i);
+                    }
+                };
+
 
             public:
 
@@ -411,6 +494,9 @@ namespace swizzle
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_V(fract)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_V(floor)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_V(ceil)
+                CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_V(trunc)
+                CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_V(round)
+                CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_V(roundEven)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VV(mod)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VS(mod)
 
@@ -424,50 +510,96 @@ namespace swizzle
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VVV(mix)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VVS(mix)
 
+                CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VVV(fma)
+
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VV(step)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_SV(step)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_VVV(smoothstep)
                 CXXSWIZZLE_DETAIL_SIMPLE_TRANSFORM_SSV(smoothstep)
 
-                // these are more complex
+                // building blocks of matrix products; not GLSL functions, so they are not forwarded
+
+                //! x * a
+                static vector_type call_mul(vector_arg_type x, scalar_arg_type a)
+                {
+                    return construct_static(functor_mul{}, x, a);
+                }
+
+                //! x * a + y
+                static vector_type call_mad(vector_arg_type x, scalar_arg_type a, vector_arg_type y)
+                {
+                    return construct_static(functor_mad{}, x, a, y);
+                }
+
+                //! Integral part goes to i, which can be anything a vector is assignable to (proxies, scalars).
+                template <class T>
+                static vector_type call_modf(vector_arg_type x, T&& i)
+                {
+                    vector_type integral;
+                    vector_type result = construct_static(functor_modf{}, x, integral);
+                    i = integral;
+                    return result;
+                }
+
+                // these are more complex; all of them are written as mad chains with no temporary
+                // vectors, as they tend to dominate raymarching shaders
 
                 static vector_type call_reflect(vector_arg_type I, vector_arg_type N)
                 {
-                    //return (I - 2 * call_dot(I, N) * N);
-                    scalar_type dot2 = 2 * call_dot(I, N);
-                    vector_type n = N;
-                    n *= dot2;
+                    // I - 2 * dot(N, I) * N
+                    scalar_type factor = call_dot(N, I) * scalar_type(-2);
+                    return construct_static(functor_mad{}, N, factor, I);
+                }
+
+                static vector_type call_refract(vector_arg_type I, vector_arg_type N, scalar_arg_type eta)
+                {
+                    using namespace std;
+                    // k = 1 - eta * eta * (1 - dot(N, I) * dot(N, I))
+                    // k < 0 ? 0 : eta * I - (eta * dot(N, I) + sqrt(k)) * N
+                    // The condition is turned into a 0/1 factor, so that SIMD lanes do not need to diverge.
+                    scalar_type d = call_dot(N, I);
+                    scalar_type k = scalar_type(1) - eta * eta * (scalar_type(1) - d * d);
+                    scalar_type mask = scalar_type(1) - step(k, scalar_type(0));
+                    scalar_type n_factor = -mad(eta, d, sqrt(max(k, scalar_type(0)))) * mask;
+                    scalar_type i_factor = eta * mask;
+                    return construct_static(functor_linear_combination{}, N, n_factor, I, i_factor);
+                }
 
-                    vector_type i = I;
-                    i -= n;
-                    return i;
+                static vector_type call_faceforward(vector_arg_type N, vector_arg_type I, vector_arg_type Nref)
+                {
+                    using namespace std;
+                    // dot(Nref, I) < 0 ? N : -N
+                    scalar_type is_negative = step(call_dot(Nref, I), scalar_type(0));
+                    return construct_static(functor_mul{}, N, mad(is_negative, scalar_type(2), scalar_type(-1)));
                 }
 
                 // Geometric functions
                 static scalar_type call_length(vector_arg_type x)
                 {
                     using namespace std;
-                    scalar_type dot = call_dot(x, x);
-                    return sqrt(dot);
+                    return sqrt(call_dot(x, x));
                 }
 
-                static scalar_type call_distance(vector_arg_type p0, const vector_arg_type p1)
+                static scalar_type call_distance(vector_arg_type p0, vector_arg_type p1)
                 {
-                    return call_length(p0 - p1);
+                    using namespace std;
+                    scalar_type d = p0.at(0) - p1.at(0);
+                    scalar_type result = d * d;
+                    detail::static_for_with_static_call<1, Size>(functor_distance{}, result, p0, p1);
+                    return sqrt(result);
                 }
 
                 static scalar_type call_dot(vector_arg_type x, vector_arg_type y)
                 {
-                    scalar_type result = 0;
-                    detail::static_for_with_static_call<0, Size>(functor_dot{}, result, x, y);
+                    scalar_type result = x.at(0) * y.at(0);
+                    detail::static_for_with_static_call<1, Size>(functor_dot{}, result, x, y);
                     return result;
                 }
 
                 static vector_type call_normalize(vector_arg_type x)
                 {
                     using namespace std;
-                    scalar_type dot = call_dot(x, x);
-                    return vector_type(x) * rsqrt(dot);
+                    return construct_static(functor_mul{}, x, inversesqrt(call_dot(x, x)));
                 }
 
                 static typename std::conditional<Size == 3, vector_type, not_available>::type call_cross(const vector_type& x, const vector_type& y)
@@ -478,6 +610,86 @@ namespace swizzle
                     return vector_type(rx, ry, rz);
                 }
 
+                static typename std::conditional<(Size > 1), ::swizzle::glsl::matrix<VectorType, ScalarType, Size, Size, std::true_type>, not_available>::type call_outerProduct(vector_arg_type c, vector_arg_type r)
+                {
+                    ::swizzle::glsl::matrix<VectorType, ScalarType, Size, Size, std::true_type> result;
+                    detail::static_for<0, Size>([&](size_t col) -> void { result.column(col) = c * r[col]; });
+                    return result;
+                }
+
+                static bool_vector_type call_isnan(vector_arg_type x)
+                {
+                    using namespace std;
+                    return construct<bool>([&](size_t i) -> bool { return isnan(x[i]); });
+                }
+
+                static bool_vector_type call_isinf(vector_arg_type x)
+                {
+                    using namespace std;
+                    return construct<bool>([&](size_t i) -> bool { return isinf(x[i]); });
+                }
+
+                // Bit-level functions; types of results are defined by detail::bits_traits. These
+                // are templates only to postpone the traits lookup until they are actually used.
+                // Scalar versions are brought in with using-declarations: with a using-directive they
+                // would be hidden by SIMD overloads in swizzle::detail, if there are any.
+
+                template <class T = scalar_type>
+                static VectorType<typename bits_traits<T>::int_type, Size> call_floatBitsToInt(vector_arg_type x)
+                {
+                    using std::floatBitsToInt;
+                    return construct<typename bits_traits<T>::int_type>([&](size_t i) { return floatBitsToInt(x[i]); });
+                }
+
+                template <class T = scalar_type>
+                static VectorType<typename bits_traits<T>::uint_type, Size> call_floatBitsToUint(vector_arg_type x)
+                {
+                    using std::floatBitsToUint;
+                    return construct<typename bits_traits<T>::uint_type>([&](size_t i) { return floatBitsToUint(x[i]); });
+                }
+
+                template <class T = scalar_type>
+                static VectorType<typename bits_traits<T>::float_type, Size> call_intBitsToFloat(vector_arg_type x)
+                {
+                    using std::intBitsToFloat;
+                    return construct<typename bits_traits<T>::float_type>([&](size_t i) { return intBitsToFloat(x[i]); });
+                }
+
+                template <class T = scalar_type>
+                static VectorType<typename bits_traits<T>::float_type, Size> call_uintBitsToFloat(vector_arg_type x)
+                {
+                    using std::uintBitsToFloat;
+                    return construct<typename bits_traits<T>::float_type>([&](size_t i) { return uintBitsToFloat(x[i]); });
+                }
+
+                template <class T = scalar_type>
+                static typename bits_traits<T>::uint_type call_packUnorm4x8(typename std::conditional<Size == 4, vector_arg_type, not_available>::type x)
+                {
+                    using std::packUnorm4x8;
+                    return packUnorm4x8(x[0], x[1], x[2], x[3]);
+                }
+
+                template <class T = scalar_type>
+                static VectorType<typename bits_traits<T>::float_type, 4> call_unpackUnorm4x8(typename std::conditional<Size == 1, vector_arg_type, not_available>::type p)
+                {
+                    using std::unpackUnorm4x8;
+                    return VectorType<typename bits_traits<T>::float_type, 4>(unpackUnorm4x8(p[0], 0u), unpackUnorm4x8(p[0], 1u), unpackUnorm4x8(p[0], 2u), unpackUnorm4x8(p[0], 3u));
+                }
+
+                template <class T = scalar_type>
+                static typename bits_traits<T>::uint_type call_packHalf2x16(typename std::conditional<Size == 2, vector_arg_type, not_available>::type x)
+                {
+                    using std::packHalf2x16;
+                    return packHalf2x16(x[0], x[1]);
+                }
+
+                template <class T = scalar_type>
+                static VectorType<typename bits_traits<T>::float_type, 2> call_unpackHalf2x16(typename std::conditional<Size == 1, vector_arg_type, not_available>::type p)
+                {
+                    using std::unpackHalf2x16;
+                    return VectorType<typename bits_traits<T>::float_type, 2>(unpackHalf2x16(p[0], 0u), unpackHalf2x16(p[0], 1u));
+                }
+
                 static bool_vector_type call_lessThan(vector_arg_type x, vector_arg_type y)
                 {
                     return construct<bool>([&](size_t i) -> bool { return x[i] < y[i]; });
@@ -2,10 +2,12 @@
 // Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
 #pragma once
 
+#include <initializer_list>
 #include <type_traits>
 #include <swizzle/detail/utils.h>
 #include <swizzle/detail/vector_traits.h>
 #include <swizzle/detail/vector_inout_wrapper.h>
+#include <swizzle/detail/instrumentation.h>
 
 namespace swizzle
 {
@@ -16,6 +18,9 @@ namespace swizzle
         //! of its, with -1 meaning "don't use".
         //! The type is convertible to the vector. It also forwards all unary arithmetic operators. Binary
         //! operations hopefully fallback to the vector ones.
+        //! There is a class per swizzle pattern and vector type (hundreds of them), all instantiated by merely
+        //! using the vector, so the class is kept lean: no helper types, and everything depending on indices
+        //! lives in function bodies, which get instantiated only when called.
         template <class VectorType, class DataType, size_t... indices>
         class indexed_proxy
         {
@@ -28,7 +33,7 @@ namespace swizzle
             static_assert(num_of_components >= 2, "Must be at least 2 components");
 
             // Is this proxy writable? All indices must be different, except for -1s
-            static const bool is_writable = are_unique<indices...>::value;
+            static const bool is_writable = are_unique_indices<indices...>();
 
             // Use the traits to define vector and scalar
             typedef VectorType vector_type;
@@ -39,8 +44,10 @@ namespace swizzle
             //! Convert proxy into a vector.
             vector_type decay() const
             {
+                CXXSWIZZLE_INSTRUMENT("swizzle", "decay");
                 vector_type result;
-                decay_helper<0, indices...> {result, m_data};
+                size_t component = 0;
+                (void)std::initializer_list<int>{ (result.at(component++, std::true_type()) = m_data[indices], 0)... };
                 return result;
             }
 
@@ -68,7 +75,8 @@ namespace swizzle
             //! Assignment only enabled if proxy is writable -> has unique indexes
             indexed_proxy& operator=(const typename std::conditional<is_writable, vector_type, operation_not_available>::type& vec)
             {
-                decay_helper<0, indices...> {vec, m_data};
+                size_t component = 0;
+                (void)std::initializer_list<int>{ (m_data[indices] = vec.at(component++, std::true_type()), 0)... };
                 return *this;
             }
 
@@ -99,40 +107,6 @@ namespace swizzle
             {
                 return operator=( decay() / std::forward<T>(o) );
             }
-
-        private:
-            //! Helper type, converts vector to or from data
-            template <size_t VectorIndex, size_t DataIndex, size_t... DataIndexTail>
-            struct decay_helper
-            {
-                //! Convert data into vector.
-                decay_helper(VectorType& vec, const DataType& data)
-                {
-                    vec[VectorIndex] = data[DataIndex];
-                    decay_helper<VectorIndex + 1, DataIndexTail...>(vec, data);
-                }
-                //! Convert vector into data.
-                decay_helper(const VectorType& vec, DataType& data)
-                {
-                    data[DataIndex] = vec.at(VectorIndex, std::true_type());
-                    decay_helper<VectorIndex + 1, DataIndexTail...>(vec, data);
-                }
-            };
-
-            //! Terminator.
-            template <size_t VectorIndex, size_t DataIndex>
-            struct decay_helper<VectorIndex, DataIndex>
-            {
-                decay_helper(VectorType& vec, const DataType& data)
-                {
-                    vec.at(VectorIndex, std::true_type()) = data[DataIndex];
-                }
-
-                decay_helper(const VectorType& vec, DataType& data)
-                {
-                    data[DataIndex] = vec.at(VectorIndex, std::true_type());
-                }
-            };
         };
 
 
@@ -0,0 +1,231 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Optional counting of calls of builtins (the functions of vector_functions.h), texture functions and
+// swizzle decays, to tell which of them a slow shader spends its time in. Enabled by defining
+// CXXSWIZZLE_INSTRUMENTATION; CXXSWIZZLE_INSTRUMENTATION_TIMING adds cycle counts (rdtsc, where available)
+// to call counts. Both need to be defined the same way for all the translation units of a program. When
+// disabled CXXSWIZZLE_INSTRUMENT expands to nothing, so there is no cost at all.
+//
+// Counters are per thread, so counting does not synchronise threads; collect() sums them over threads
+// and needs to be called while none of them runs instrumented code, e.g. between frames.
+#pragma once
+
+#if defined(CXXSWIZZLE_INSTRUMENTATION_TIMING) && !defined(CXXSWIZZLE_INSTRUMENTATION)
+#define CXXSWIZZLE_INSTRUMENTATION
+#endif
+
+#ifdef CXXSWIZZLE_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef CXXSWIZZLE_INSTRUMENTATION_TIMING
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define CXXSWIZZLE_DETAIL_RDTSC() __rdtsc()
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define CXXSWIZZLE_DETAIL_RDTSC() __rdtsc()
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace swizzle
+{
+    namespace detail
+    {
+        namespace instrumentation
+        {
+            //! Functions that can be told apart; the ones past the limit are all counted as "(other)".
+            static const size_t max_functions = 256;
+
+            //! Counters of a function, summed over threads.
+            struct function_counters
+            {
+                const char* category;
+                const char* name;
+                uint64_t calls;
+                //! Cycles spent in the function itself, i.e. not in instrumented functions it called; 0 if
+                //! timing is disabled.
+                uint64_t cycles;
+            };
+
+            //! Whether cycles get counted.
+            inline bool timing_enabled()
+            {
+#ifdef CXXSWIZZLE_INSTRUMENTATION_TIMING
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            inline uint64_t timestamp()
+            {
+#if defined(CXXSWIZZLE_DETAIL_RDTSC)
+                return CXXSWIZZLE_DETAIL_RDTSC();
+#elif defined(CXXSWIZZLE_INSTRUMENTATION_TIMING)
+                return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#else
+                return 0;
+#endif
+            }
+
+            //! Counters of a thread. Written by their thread only; atomics just make reading them from
+            //! collect() well defined, hence relaxed loads and stores rather than read-modify-writes.
+            struct thread_counters
+            {
+                std::atomic<uint64_t> calls[max_functions];
+                std::atomic<uint64_t> cycles[max_functions];
+                //! Cycles of the instrumented calls made by the current one so far.
+                uint64_t nested_cycles;
+            };
+
+            struct registry
+            {
+                std::mutex mutex;
+                //! Category and name of each id; id 0 is "(other)".
+                std::vector<std::pair<const char*, const char*>> functions;
+                //! Counters of all the threads that have ever counted; never freed, so that counts of threads
+                //! that have finished are not lost.
+                std::vector<std::unique_ptr<thread_counters>> threads;
+
+                static registry& get()
+                {
+                    static registry s_registry;
+                    return s_registry;
+                }
+            };
+
+            //! Id of a function, the same for all of its call sites (and template instances).
+            inline unsigned function_id(const char* category, const char* name)
+            {
+                registry& r = registry::get();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                if (r.functions.empty())
+                {
+                    r.functions.emplace_back("", "(other)");
+                }
+                for (size_t i = 1; i < r.functions.size(); ++i)
+                {
+                    if (std::strcmp(r.functions[i].first, category) == 0 && std::strcmp(r.functions[i].second, name) == 0)
+                    {
+                        return static_cast<unsigned>(i);
+                    }
+                }
+                if (r.functions.size() == max_functions)
+                {
+                    return 0;
+                }
+                r.functions.emplace_back(category, name);
+                return static_cast<unsigned>(r.functions.size() - 1);
+            }
+
+            inline thread_counters& local_counters()
+            {
+                static thread_local thread_counters* s_counters = []()
+                {
+                    std::unique_ptr<thread_counters> counters(new thread_counters());
+                    for (size_t i = 0; i < max_functions; ++i)
+                    {
+                        counters->calls[i].store(0, std::memory_order_relaxed);
+                        counters->cycles[i].store(0, std::memory_order_relaxed);
+                    }
+                    counters->nested_cycles = 0;
+
+                    registry& r = registry::get();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.threads.push_back(std::move(counters));
+                    return r.threads.back().get();
+                }();
+                return *s_counters;
+            }
+
+            //! Counts a call for as long as it lives.
+            class scope
+            {
+            public:
+                explicit scope(unsigned id)
+                    : m_id(id)
+                    , m_counters(local_counters())
+                {
+                    std::atomic<uint64_t>& calls = m_counters.calls[id];
+                    calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#ifdef CXXSWIZZLE_INSTRUMENTATION_TIMING
+                    m_outer_nested_cycles = m_counters.nested_cycles;
+                    m_counters.nested_cycles = 0;
+                    m_start = timestamp();
+#endif
+                }
+
+                ~scope()
+                {
+#ifdef CXXSWIZZLE_INSTRUMENTATION_TIMING
+                    uint64_t elapsed = timestamp() - m_start;
+                    std::atomic<uint64_t>& cycles = m_counters.cycles[m_id];
+                    cycles.store(cycles.load(std::memory_order_relaxed) + (elapsed - std::min(elapsed, m_counters.nested_cycles)), std::memory_order_relaxed);
+                    m_counters.nested_cycles = m_outer_nested_cycles + elapsed;
+#endif
+                }
+
+                scope(const scope&) = delete;
+                scope& operator=(const scope&) = delete;
+
+            private:
+                unsigned m_id;
+                thread_counters& m_counters;
+#ifdef CXXSWIZZLE_INSTRUMENTATION_TIMING
+                uint64_t m_outer_nested_cycles;
+                uint64_t m_start;
+#endif
+            };
+
+            //! Counters of all the functions called at least once since the last reset, summed over threads,
+            //! most expensive (or, without timing, most called) first. Resets them if reset is true.
+            inline std::vector<function_counters> collect(bool reset)
+            {
+                registry& r = registry::get();
+                std::lock_guard<std::mutex> lock(r.mutex);
+
+                std::vector<function_counters> result;
+                for (size_t i = 0; i < r.functions.size(); ++i)
+                {
+                    function_counters sum = { r.functions[i].first, r.functions[i].second, 0, 0 };
+                    for (auto& counters : r.threads)
+                    {
+                        sum.calls += reset ? counters->calls[i].exchange(0, std::memory_order_relaxed) : counters->calls[i].load(std::memory_order_relaxed);
+                        sum.cycles += reset ? counters->cycles[i].exchange(0, std::memory_order_relaxed) : counters->cycles[i].load(std::memory_order_relaxed);
+                    }
+                    if (sum.calls)
+                    {
+                        result.push_back(sum);
+                    }
+                }
+
+                std::stable_sort(result.begin(), result.end(), [](const function_counters& a, const function_counters& b)
+                {
+                    return a.cycles != b.cycles ? a.cycles > b.cycles : a.calls > b.calls;
+                });
+                return result;
+            }
+        }
+    }
+}
+
+//! Counts the call of the enclosing function as the function name of category; use once per scope.
+#define CXXSWIZZLE_INSTRUMENT(category, name) \
+    static const unsigned cxxswizzle_instrument_id = ::swizzle::detail::instrumentation::function_id(category, name); \
+    ::swizzle::detail::instrumentation::scope cxxswizzle_instrument_scope(cxxswizzle_instrument_id)
+
+#else
+
+#define CXXSWIZZLE_INSTRUMENT(category, name) ((void)0)
+
+#endif
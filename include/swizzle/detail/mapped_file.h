@@ -0,0 +1,90 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace swizzle
+{
+    namespace detail
+    {
+        //! A whole file mapped read-only. Pages are shared between all the processes mapping the same file
+        //! and get loaded on first access only.
+        struct mapped_file
+        {
+            //! Null if the file could not be mapped (or is empty).
+            std::shared_ptr<const void> data;
+            size_t size;
+
+            static mapped_file open(const std::string& path)
+            {
+                mapped_file result = { nullptr, 0 };
+
+#ifdef _WIN32
+                HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                {
+                    return result;
+                }
+
+                LARGE_INTEGER size;
+                HANDLE mapping = nullptr;
+                if (::GetFileSizeEx(file, &size) && size.QuadPart > 0)
+                {
+                    mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                }
+                ::CloseHandle(file);
+                if (!mapping)
+                {
+                    return result;
+                }
+
+                // the view keeps the mapping alive
+                const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                ::CloseHandle(mapping);
+                if (view)
+                {
+                    result.data.reset(view, [](const void* p) { ::UnmapViewOfFile(p); });
+                    result.size = static_cast<size_t>(size.QuadPart);
+                }
+#else
+                int file = ::open(path.c_str(), O_RDONLY);
+                if (file < 0)
+                {
+                    return result;
+                }
+
+                struct stat info;
+                void* view = MAP_FAILED;
+                if (::fstat(file, &info) == 0 && info.st_size > 0)
+                {
+                    view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+                }
+                // the mapping stays valid after closing
+                ::close(file);
+                if (view != MAP_FAILED)
+                {
+                    size_t size = static_cast<size_t>(info.st_size);
+                    result.data.reset(view, [size](const void* p) { ::munmap(const_cast<void*>(p), size); });
+                    result.size = size;
+                }
+#endif
+                return result;
+            }
+        };
+    }
+}
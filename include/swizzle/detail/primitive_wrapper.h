@@ -105,6 +105,14 @@ namespace swizzle
             {
                 return rsqrt(x.data);
             }
+            inline friend this_type inversesqrt(this_arg x)
+            {
+                return inversesqrt(x.data);
+            }
+            inline friend this_type mad(this_arg a, this_arg b, this_arg c)
+            {
+                return mad(a.data, b.data, c.data);
+            }
 
             inline friend this_type sign(this_arg x)
             {
@@ -126,6 +134,26 @@ namespace swizzle
             {
                 return mod(x.data, y.data);
             }
+            inline friend this_type trunc(this_arg x)
+            {
+                return trunc(x.data);
+            }
+            inline friend this_type round(this_arg x)
+            {
+                return round(x.data);
+            }
+            inline friend this_type roundEven(this_arg x)
+            {
+                return roundEven(x.data);
+            }
+            inline friend bool_type isnan(this_arg x)
+            {
+                return isnan(x.data);
+            }
+            inline friend bool_type isinf(this_arg x)
+            {
+                return isinf(x.data);
+            }
 
             inline friend this_type min(this_arg x, this_arg y)
             {
@@ -0,0 +1,443 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <swizzle/glsl/scalar_support.h>
+#include <swizzle/detail/vector_traits.h>
+
+//! Binary function of a uniform and a varying (in any order; the uniform gets broadcast) or a literal
+//! (without these literals would be ambiguous).
+#define CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY(name) \
+    inline friend varying_type name(this_arg a, varying_arg b) { return name(varying_type(a.data), b); } \
+    inline friend varying_type name(varying_arg a, this_arg b) { return name(a, varying_type(b.data)); } \
+    inline friend this_type name(this_arg a, external_type_arg b) { return name(a, this_type(b)); } \
+    inline friend this_type name(external_type_arg a, this_arg b) { return name(this_type(a), b); }
+
+namespace swizzle
+{
+    namespace detail
+    {
+        //! A scalar known to be the same across all the lanes of VaryingType (a primitive_wrapper), e.g. a uniform.
+        //! It is stored as a plain external_type: operations between uniforms stay scalar and comparisons give
+        //! real bools, so uniform-only conditions can be real branches. Mixing with VaryingType broadcasts
+        //! the value at the point of use.
+        template <typename VaryingType>
+        class uniform_wrapper
+        {
+        public:
+            typedef VaryingType varying_type;
+            typedef typename VaryingType::external_type external_type;
+            typedef typename VaryingType::bool_type varying_bool_type;
+            typedef uniform_wrapper this_type;
+
+            typedef const uniform_wrapper& this_arg;
+            typedef const varying_type& varying_arg;
+            typedef const external_type& external_type_arg;
+
+        private:
+            external_type data;
+
+        public:
+            uniform_wrapper()
+                : data()
+            {}
+
+            uniform_wrapper(external_type_arg data)
+                : data(data)
+            {}
+
+            // functions; all of them stay scalar
+
+            inline friend this_type radians(this_arg x)
+            {
+                return x.data * external_type(3.14159265358979323846 / 180);
+            }
+            inline friend this_type degrees(this_arg x)
+            {
+                return x.data * external_type(180 / 3.14159265358979323846);
+            }
+            inline friend this_type sin(this_arg x)
+            {
+                using namespace std;
+                return sin(x.data);
+            }
+            inline friend this_type cos(this_arg x)
+            {
+                using namespace std;
+                return cos(x.data);
+            }
+            inline friend this_type tan(this_arg x)
+            {
+                using namespace std;
+                return tan(x.data);
+            }
+            inline friend this_type asin(this_arg x)
+            {
+                using namespace std;
+                return asin(x.data);
+            }
+            inline friend this_type acos(this_arg x)
+            {
+                using namespace std;
+                return acos(x.data);
+            }
+            inline friend this_type atan(this_arg x)
+            {
+                using namespace std;
+                return atan(x.data);
+            }
+            inline friend this_type atan(this_arg y, this_arg x)
+            {
+                using namespace std;
+                return atan2(y.data, x.data);
+            }
+
+            inline friend this_type abs(this_arg x)
+            {
+                using namespace std;
+                return abs(x.data);
+            }
+            inline friend this_type pow(this_arg x, this_arg n)
+            {
+                using namespace std;
+                return pow(x.data, n.data);
+            }
+            inline friend this_type exp(this_arg x)
+            {
+                using namespace std;
+                return exp(x.data);
+            }
+            inline friend this_type log(this_arg x)
+            {
+                using namespace std;
+                return log(x.data);
+            }
+            inline friend this_type exp2(this_arg x)
+            {
+                using namespace std;
+                return exp2(x.data);
+            }
+            inline friend this_type log2(this_arg x)
+            {
+                using namespace std;
+                return log2(x.data);
+            }
+            inline friend this_type sqrt(this_arg x)
+            {
+                using namespace std;
+                return sqrt(x.data);
+            }
+            inline friend this_type inversesqrt(this_arg x)
+            {
+                using namespace std;
+                return inversesqrt(x.data);
+            }
+
+            inline friend this_type sign(this_arg x)
+            {
+                using namespace std;
+                return sign(x.data);
+            }
+            inline friend this_type fract(this_arg x)
+            {
+                using namespace std;
+                return fract(x.data);
+            }
+            inline friend this_type floor(this_arg x)
+            {
+                using namespace std;
+                return floor(x.data);
+            }
+            inline friend this_type ceil(this_arg x)
+            {
+                using namespace std;
+                return ceil(x.data);
+            }
+            inline friend this_type trunc(this_arg x)
+            {
+                using namespace std;
+                return trunc(x.data);
+            }
+            inline friend this_type round(this_arg x)
+            {
+                using namespace std;
+                return round(x.data);
+            }
+            inline friend this_type roundEven(this_arg x)
+            {
+                using namespace std;
+                return roundEven(x.data);
+            }
+            inline friend this_type mod(this_arg x, this_arg y)
+            {
+                using namespace std;
+                return x.data - y.data * floor(x.data / y.data);
+            }
+            inline friend this_type fma(this_arg a, this_arg b, this_arg c)
+            {
+                using namespace std;
+                return mad(a.data, b.data, c.data);
+            }
+
+            inline friend this_type min(this_arg x, this_arg y)
+            {
+                using namespace std;
+                return min(x.data, y.data);
+            }
+            inline friend this_type max(this_arg x, this_arg y)
+            {
+                using namespace std;
+                return max(x.data, y.data);
+            }
+            inline friend this_type clamp(this_arg x, this_arg a, this_arg b)
+            {
+                using namespace std;
+                return min(max(x.data, a.data), b.data);
+            }
+            inline friend this_type mix(this_arg x, this_arg y, this_arg a)
+            {
+                return x.data + a.data * (y.data - x.data);
+            }
+            inline friend this_type step(this_arg edge, this_arg x)
+            {
+                using namespace std;
+                return step(edge.data, x.data);
+            }
+            inline friend this_type smoothstep(this_arg edge0, this_arg edge1, this_arg x)
+            {
+                using namespace std;
+                external_type t = min(max((x.data - edge0.data) / (edge1.data - edge0.data), external_type(0)), external_type(1));
+                return t * t * (external_type(3) - external_type(2) * t);
+            }
+
+            // functions mixing uniforms and varyings
+
+            CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY(pow)
+            CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY(mod)
+            CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY(min)
+            CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY(max)
+            CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY(step)
+
+            // unary operators
+
+            this_type operator-() const
+            {
+                return -data;
+            }
+
+            this_type& operator+=(this_arg other)
+            {
+                data += other.data;
+                return *this;
+            }
+            this_type& operator-=(this_arg other)
+            {
+                data -= other.data;
+                return *this;
+            }
+            this_type& operator*=(this_arg other)
+            {
+                data *= other.data;
+                return *this;
+            }
+            this_type& operator/=(this_arg other)
+            {
+                data /= other.data;
+                return *this;
+            }
+
+            // binary operators; uniforms with uniforms (or literals) stay uniform
+
+            inline friend this_type operator+(this_arg a, this_arg b)
+            {
+                return a.data + b.data;
+            }
+            inline friend this_type operator-(this_arg a, this_arg b)
+            {
+                return a.data - b.data;
+            }
+            inline friend this_type operator*(this_arg a, this_arg b)
+            {
+                return a.data * b.data;
+            }
+            inline friend this_type operator/(this_arg a, this_arg b)
+            {
+                return a.data / b.data;
+            }
+
+            inline friend this_type operator+(this_arg a, external_type_arg b)
+            {
+                return a.data + b;
+            }
+            inline friend this_type operator+(external_type_arg a, this_arg b)
+            {
+                return a + b.data;
+            }
+            inline friend this_type operator-(this_arg a, external_type_arg b)
+            {
+                return a.data - b;
+            }
+            inline friend this_type operator-(external_type_arg a, this_arg b)
+            {
+                return a - b.data;
+            }
+            inline friend this_type operator*(this_arg a, external_type_arg b)
+            {
+                return a.data * b;
+            }
+            inline friend this_type operator*(external_type_arg a, this_arg b)
+            {
+                return a * b.data;
+            }
+            inline friend this_type operator/(this_arg a, external_type_arg b)
+            {
+                return a.data / b;
+            }
+            inline friend this_type operator/(external_type_arg a, this_arg b)
+            {
+                return a / b.data;
+            }
+
+            // ... while mixing with varyings broadcasts
+
+            inline friend varying_type operator+(this_arg a, varying_arg b)
+            {
+                return a.data + b;
+            }
+            inline friend varying_type operator+(varying_arg a, this_arg b)
+            {
+                return a + b.data;
+            }
+            inline friend varying_type operator-(this_arg a, varying_arg b)
+            {
+                return a.data - b;
+            }
+            inline friend varying_type operator-(varying_arg a, this_arg b)
+            {
+                return a - b.data;
+            }
+            inline friend varying_type operator*(this_arg a, varying_arg b)
+            {
+                return a.data * b;
+            }
+            inline friend varying_type operator*(varying_arg a, this_arg b)
+            {
+                return a * b.data;
+            }
+            inline friend varying_type operator/(this_arg a, varying_arg b)
+            {
+                return a.data / b;
+            }
+            inline friend varying_type operator/(varying_arg a, this_arg b)
+            {
+                return a / b.data;
+            }
+
+            // casts
+
+            //! Broadcast.
+            inline operator varying_type() const
+            {
+                return varying_type(data);
+            }
+
+            //! To avoid ambiguities with varyings, cast to the scalar is explicit.
+            inline explicit operator external_type() const
+            {
+                return data;
+            }
+
+            // comparisons
+
+            inline friend bool operator>(this_arg a, this_arg b)
+            {
+                return a.data > b.data;
+            }
+            inline friend bool operator>=(this_arg a, this_arg b)
+            {
+                return a.data >= b.data;
+            }
+            inline friend bool operator<(this_arg a, this_arg b)
+            {
+                return a.data < b.data;
+            }
+            inline friend bool operator<=(this_arg a, this_arg b)
+            {
+                return a.data <= b.data;
+            }
+            inline friend bool operator==(this_arg a, this_arg b)
+            {
+                return a.data == b.data;
+            }
+            inline friend bool operator!=(this_arg a, this_arg b)
+            {
+                return a.data != b.data;
+            }
+
+            inline friend varying_bool_type operator>(this_arg a, varying_arg b)
+            {
+                return varying_type(a.data) > b;
+            }
+            inline friend varying_bool_type operator>(varying_arg a, this_arg b)
+            {
+                return a > varying_type(b.data);
+            }
+            inline friend varying_bool_type operator<(this_arg a, varying_arg b)
+            {
+                return varying_type(a.data) < b;
+            }
+            inline friend varying_bool_type operator<(varying_arg a, this_arg b)
+            {
+                return a < varying_type(b.data);
+            }
+            inline friend varying_bool_type operator>=(this_arg a, varying_arg b)
+            {
+                return varying_type(a.data) >= b;
+            }
+            inline friend varying_bool_type operator>=(varying_arg a, this_arg b)
+            {
+                return a >= varying_type(b.data);
+            }
+            inline friend varying_bool_type operator<=(this_arg a, varying_arg b)
+            {
+                return varying_type(a.data) <= b;
+            }
+            inline friend varying_bool_type operator<=(varying_arg a, this_arg b)
+            {
+                return a <= varying_type(b.data);
+            }
+            inline friend varying_bool_type operator==(this_arg a, varying_arg b)
+            {
+                return varying_type(a.data) == b;
+            }
+            inline friend varying_bool_type operator==(varying_arg a, this_arg b)
+            {
+                return a == varying_type(b.data);
+            }
+            inline friend varying_bool_type operator!=(this_arg a, varying_arg b)
+            {
+                return varying_type(a.data) != b;
+            }
+            inline friend varying_bool_type operator!=(varying_arg a, this_arg b)
+            {
+                return a != varying_type(b.data);
+            }
+
+            // for CxxSwizzle ADL-magic; wherever a vector is needed the value gets broadcast
+
+            varying_type decay() const
+            {
+                return varying_type(data);
+            }
+        };
+
+        //! Uniforms are seen as one-component vectors of their varying counterparts.
+        template <typename VaryingType>
+        struct get_vector_type_impl< uniform_wrapper<VaryingType> > : get_vector_type_impl<VaryingType>
+        {};
+    }
+}
+
+#undef CXXSWIZZLE_DETAIL_UNIFORM_MIXED_BINARY
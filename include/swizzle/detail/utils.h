@@ -35,6 +35,26 @@ namespace swizzle
         {};
 
 
+        //! Same as C++14's std::index_sequence, which C++11 lacks.
+        template <size_t... Index>
+        struct index_sequence
+        {};
+
+        template <size_t N, size_t... Index>
+        struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, Index...>
+        {};
+
+        template <size_t... Index>
+        struct make_index_sequence_impl<0, Index...>
+        {
+            typedef index_sequence<Index...> type;
+        };
+
+        //! index_sequence<0, 1, ..., N - 1>
+        template <size_t N>
+        using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+
         //! A type to indicate that operation is not available for some combination of input types.
         struct operation_not_available;
         template <int> struct operation_not_available_n;
@@ -150,33 +170,42 @@ namespace swizzle
             static const bool value = Predicate<Head>::value;
         };
 
-        //! Does the sequence contain "What"?
-        template <size_t What, size_t Head, size_t... Tail>
-        struct contains
-        {
-            static const bool value = What == Head || contains<What, Tail...>::value;
-        };
+        //! Are all the types (references and cv-qualifiers aside) arithmetic?
+        template <class... T>
+        struct are_arithmetic : std::true_type
+        {};
 
-        template <size_t What, size_t Head>
-        struct contains<What, Head>
-        {
-            static const bool value = What == Head;
-        };
+        template <class Head, class... Tail>
+        struct are_arithmetic<Head, Tail...> : std::integral_constant<bool, 
+            std::is_arithmetic<typename remove_reference_cv<Head>::type>::value && are_arithmetic<Tail...>::value>
+        {};
 
+        //! Is value one of values?
+        template <size_t value>
+        constexpr bool is_index_in()
+        {
+            return false;
+        }
 
-        //! Are all elements unique?
-        template <size_t Head, size_t... Tail>
-        struct are_unique
+        template <size_t value, size_t head, size_t... tail>
+        constexpr bool is_index_in()
         {
-            static const bool value = !contains<Head, Tail...>::value && are_unique<Tail...>::value;
-        };
+            return value == head || is_index_in<value, tail...>();
+        }
 
-        template <size_t value1, size_t value2>
-        struct are_unique<value1, value2>
+        //! Are all elements unique? A function rather than a trait: it is evaluated for every swizzle
+        //! pattern and instantiates no types.
+        template <size_t last>
+        constexpr bool are_unique_indices()
         {
-            static const bool value = value1 != value2;
-        };
+            return true;
+        }
 
+        template <size_t head, size_t next, size_t... tail>
+        constexpr bool are_unique_indices()
+        {
+            return !is_index_in<head, next, tail...>() && are_unique_indices<next, tail...>();
+        }
 
         //! Last template parameter.
         template <class Head, class... T>
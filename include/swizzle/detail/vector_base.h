@@ -6,35 +6,48 @@ namespace swizzle
 {
     namespace detail
     {
-        template <size_t Size, template <size_t...> class TProxyGenerator, class TData>
+        //! Components (of type TScalar) and swizzles (of type TProxy<indices...>) of a vector, sharing TData.
+        //! TProxy is meant to be an alias template, so that a swizzle pattern costs the compiler a single
+        //! class instantiation (the proxy's) rather than one of a generator class too; there are 340 patterns
+        //! in a 4-component vector.
+        template <size_t Size, template <size_t...> class TProxy, class TScalar, class TData>
         struct vector_base;
 
-        template <template <size_t...> class TProxyGenerator, class TData>
-        struct vector_base<1, TProxyGenerator, TData>
+        template <template <size_t...> class TProxy, class TScalar, class TData>
+        struct vector_base<1, TProxy, TScalar, TData>
         {
             union
             {
                 TData m_data;
                 struct
                 {
-                    typename TProxyGenerator<0>::type x;
+                    TScalar x;
                 };
                 struct
                 {
-                    typename TProxyGenerator<0>::type r;
+                    TScalar r;
                 };
                 struct
                 {
-                    typename TProxyGenerator<0>::type s;
+                    TScalar s;
                 };
-                typename TProxyGenerator<0, 0>::type xx, rr, ss;
-                typename TProxyGenerator<0, 0, 0>::type xxx, rrr, sss;
-                typename TProxyGenerator<0, 0, 0, 0>::type xxxx, rrrr, ssss;
+                TProxy<0, 0> xx, rr, ss;
+                TProxy<0, 0, 0> xxx, rrr, sss;
+                TProxy<0, 0, 0, 0> xxxx, rrrr, ssss;
             };
+
+            //! Zeroing; initialises the data member of the union, so that it can be used in constant expressions.
+            constexpr vector_base()
+                : m_data()
+            {}
+
+            constexpr vector_base(const TData& data)
+                : m_data(data)
+            {}
         };
 
-        template <template <size_t...> class TProxyGenerator, class TData>
-        struct vector_base<2, TProxyGenerator, TData>
+        template <template <size_t...> class TProxy, class TScalar, class TData>
+        struct vector_base<2, TProxy, TScalar, TData>
         {
             union
             {
@@ -42,55 +55,63 @@ namespace swizzle
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type x;
-                    typename TProxyGenerator<1>::type y;
+                    TScalar x;
+                    TScalar y;
                 };
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type r;
-                    typename TProxyGenerator<1>::type g;
+                    TScalar r;
+                    TScalar g;
                 };
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type s;
-                    typename TProxyGenerator<1>::type t;
+                    TScalar s;
+                    TScalar t;
                 };
 
-                typename TProxyGenerator<0,0>::type xx, rr, ss;
-                typename TProxyGenerator<0,1>::type xy, rg, st;
-                typename TProxyGenerator<1,0>::type yx, gr, ts;
-                typename TProxyGenerator<1,1>::type yy, gg, tt;
-                typename TProxyGenerator<0,0,0>::type xxx, rrr, sss;
-                typename TProxyGenerator<0,0,1>::type xxy, rrg, sst;
-                typename TProxyGenerator<0,1,0>::type xyx, rgr, sts;
-                typename TProxyGenerator<0,1,1>::type xyy, rgg, stt;
-                typename TProxyGenerator<1,0,0>::type yxx, grr, tss;
-                typename TProxyGenerator<1,0,1>::type yxy, grg, tst;
-                typename TProxyGenerator<1,1,0>::type yyx, ggr, tts;
-                typename TProxyGenerator<1,1,1>::type yyy, ggg, ttt;
-                typename TProxyGenerator<0,0,0,0>::type xxxx, rrrr, ssss;
-                typename TProxyGenerator<0,0,0,1>::type xxxy, rrrg, ssst;
-                typename TProxyGenerator<0,0,1,0>::type xxyx, rrgr, ssts;
-                typename TProxyGenerator<0,0,1,1>::type xxyy, rrgg, sstt;
-                typename TProxyGenerator<0,1,0,0>::type xyxx, rgrr, stss;
-                typename TProxyGenerator<0,1,0,1>::type xyxy, rgrg, stst;
-                typename TProxyGenerator<0,1,1,0>::type xyyx, rggr, stts;
-                typename TProxyGenerator<0,1,1,1>::type xyyy, rggg, sttt;
-                typename TProxyGenerator<1,0,0,0>::type yxxx, grrr, tsss;
-                typename TProxyGenerator<1,0,0,1>::type yxxy, grrg, tsst;
-                typename TProxyGenerator<1,0,1,0>::type yxyx, grgr, tsts;
-                typename TProxyGenerator<1,0,1,1>::type yxyy, grgg, tstt;
-                typename TProxyGenerator<1,1,0,0>::type yyxx, ggrr, ttss;
-                typename TProxyGenerator<1,1,0,1>::type yyxy, ggrg, ttst;
-                typename TProxyGenerator<1,1,1,0>::type yyyx, gggr, ttts;
-                typename TProxyGenerator<1,1,1,1>::type yyyy, gggg, tttt;
+                TProxy<0,0> xx, rr, ss;
+                TProxy<0,1> xy, rg, st;
+                TProxy<1,0> yx, gr, ts;
+                TProxy<1,1> yy, gg, tt;
+                TProxy<0,0,0> xxx, rrr, sss;
+                TProxy<0,0,1> xxy, rrg, sst;
+                TProxy<0,1,0> xyx, rgr, sts;
+                TProxy<0,1,1> xyy, rgg, stt;
+                TProxy<1,0,0> yxx, grr, tss;
+                TProxy<1,0,1> yxy, grg, tst;
+                TProxy<1,1,0> yyx, ggr, tts;
+                TProxy<1,1,1> yyy, ggg, ttt;
+                TProxy<0,0,0,0> xxxx, rrrr, ssss;
+                TProxy<0,0,0,1> xxxy, rrrg, ssst;
+                TProxy<0,0,1,0> xxyx, rrgr, ssts;
+                TProxy<0,0,1,1> xxyy, rrgg, sstt;
+                TProxy<0,1,0,0> xyxx, rgrr, stss;
+                TProxy<0,1,0,1> xyxy, rgrg, stst;
+                TProxy<0,1,1,0> xyyx, rggr, stts;
+                TProxy<0,1,1,1> xyyy, rggg, sttt;
+                TProxy<1,0,0,0> yxxx, grrr, tsss;
+                TProxy<1,0,0,1> yxxy, grrg, tsst;
+                TProxy<1,0,1,0> yxyx, grgr, tsts;
+                TProxy<1,0,1,1> yxyy, grgg, tstt;
+                TProxy<1,1,0,0> yyxx, ggrr, ttss;
+                TProxy<1,1,0,1> yyxy, ggrg, ttst;
+                TProxy<1,1,1,0> yyyx, gggr, ttts;
+                TProxy<1,1,1,1> yyyy, gggg, tttt;
             };
+
+            constexpr vector_base()
+                : m_data()
+            {}
+
+            constexpr vector_base(const TData& data)
+                : m_data(data)
+            {}
         };
 
-        template <template <size_t...> class TProxyGenerator, class TData>
-        struct vector_base<3, TProxyGenerator, TData>
+        template <template <size_t...> class TProxy, class TScalar, class TData>
+        struct vector_base<3, TProxy, TScalar, TData>
         {
             union
             {
@@ -98,147 +119,155 @@ namespace swizzle
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type x;
-                    typename TProxyGenerator<1>::type y;
-                    typename TProxyGenerator<2>::type z;
+                    TScalar x;
+                    TScalar y;
+                    TScalar z;
                 };
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type r;
-                    typename TProxyGenerator<1>::type g;
-                    typename TProxyGenerator<2>::type b;
+                    TScalar r;
+                    TScalar g;
+                    TScalar b;
                 };
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type s;
-                    typename TProxyGenerator<1>::type t;
-                    typename TProxyGenerator<2>::type p;
+                    TScalar s;
+                    TScalar t;
+                    TScalar p;
                 };
 
-                typename TProxyGenerator<0,0>::type xx, rr, ss;
-                typename TProxyGenerator<0,1>::type xy, rg, st;
-                typename TProxyGenerator<0,2>::type xz, rb, sp;
-                typename TProxyGenerator<1,0>::type yx, gr, ts;
-                typename TProxyGenerator<1,1>::type yy, gg, tt;
-                typename TProxyGenerator<1,2>::type yz, gb, tp;
-                typename TProxyGenerator<2,0>::type zx, br, ps;
-                typename TProxyGenerator<2,1>::type zy, bg, pt;
-                typename TProxyGenerator<2,2>::type zz, bb, pp;
-                typename TProxyGenerator<0,0,0>::type xxx, rrr, sss;
-                typename TProxyGenerator<0,0,1>::type xxy, rrg, sst;
-                typename TProxyGenerator<0,0,2>::type xxz, rrb, ssp;
-                typename TProxyGenerator<0,1,0>::type xyx, rgr, sts;
-                typename TProxyGenerator<0,1,1>::type xyy, rgg, stt;
-                typename TProxyGenerator<0,1,2>::type xyz, rgb, stp;
-                typename TProxyGenerator<0,2,0>::type xzx, rbr, sps;
-                typename TProxyGenerator<0,2,1>::type xzy, rbg, spt;
-                typename TProxyGenerator<0,2,2>::type xzz, rbb, spp;
-                typename TProxyGenerator<1,0,0>::type yxx, grr, tss;
-                typename TProxyGenerator<1,0,1>::type yxy, grg, tst;
-                typename TProxyGenerator<1,0,2>::type yxz, grb, tsp;
-                typename TProxyGenerator<1,1,0>::type yyx, ggr, tts;
-                typename TProxyGenerator<1,1,1>::type yyy, ggg, ttt;
-                typename TProxyGenerator<1,1,2>::type yyz, ggb, ttp;
-                typename TProxyGenerator<1,2,0>::type yzx, gbr, tps;
-                typename TProxyGenerator<1,2,1>::type yzy, gbg, tpt;
-                typename TProxyGenerator<1,2,2>::type yzz, gbb, tpp;
-                typename TProxyGenerator<2,0,0>::type zxx, brr, pss;
-                typename TProxyGenerator<2,0,1>::type zxy, brg, pst;
-                typename TProxyGenerator<2,0,2>::type zxz, brb, psp;
-                typename TProxyGenerator<2,1,0>::type zyx, bgr, pts;
-                typename TProxyGenerator<2,1,1>::type zyy, bgg, ptt;
-                typename TProxyGenerator<2,1,2>::type zyz, bgb, ptp;
-                typename TProxyGenerator<2,2,0>::type zzx, bbr, pps;
-                typename TProxyGenerator<2,2,1>::type zzy, bbg, ppt;
-                typename TProxyGenerator<2,2,2>::type zzz, bbb, ppp;
-                typename TProxyGenerator<0,0,0,0>::type xxxx, rrrr, ssss;
-                typename TProxyGenerator<0,0,0,1>::type xxxy, rrrg, ssst;
-                typename TProxyGenerator<0,0,0,2>::type xxxz, rrrb, sssp;
-                typename TProxyGenerator<0,0,1,0>::type xxyx, rrgr, ssts;
-                typename TProxyGenerator<0,0,1,1>::type xxyy, rrgg, sstt;
-                typename TProxyGenerator<0,0,1,2>::type xxyz, rrgb, sstp;
-                typename TProxyGenerator<0,0,2,0>::type xxzx, rrbr, ssps;
-                typename TProxyGenerator<0,0,2,1>::type xxzy, rrbg, sspt;
-                typename TProxyGenerator<0,0,2,2>::type xxzz, rrbb, sspp;
-                typename TProxyGenerator<0,1,0,0>::type xyxx, rgrr, stss;
-                typename TProxyGenerator<0,1,0,1>::type xyxy, rgrg, stst;
-                typename TProxyGenerator<0,1,0,2>::type xyxz, rgrb, stsp;
-                typename TProxyGenerator<0,1,1,0>::type xyyx, rggr, stts;
-                typename TProxyGenerator<0,1,1,1>::type xyyy, rggg, sttt;
-                typename TProxyGenerator<0,1,1,2>::type xyyz, rggb, sttp;
-                typename TProxyGenerator<0,1,2,0>::type xyzx, rgbr, stps;
-                typename TProxyGenerator<0,1,2,1>::type xyzy, rgbg, stpt;
-                typename TProxyGenerator<0,1,2,2>::type xyzz, rgbb, stpp;
-                typename TProxyGenerator<0,2,0,0>::type xzxx, rbrr, spss;
-                typename TProxyGenerator<0,2,0,1>::type xzxy, rbrg, spst;
-                typename TProxyGenerator<0,2,0,2>::type xzxz, rbrb, spsp;
-                typename TProxyGenerator<0,2,1,0>::type xzyx, rbgr, spts;
-                typename TProxyGenerator<0,2,1,1>::type xzyy, rbgg, sptt;
-                typename TProxyGenerator<0,2,1,2>::type xzyz, rbgb, sptp;
-                typename TProxyGenerator<0,2,2,0>::type xzzx, rbbr, spps;
-                typename TProxyGenerator<0,2,2,1>::type xzzy, rbbg, sppt;
-                typename TProxyGenerator<0,2,2,2>::type xzzz, rbbb, sppp;
-                typename TProxyGenerator<1,0,0,0>::type yxxx, grrr, tsss;
-                typename TProxyGenerator<1,0,0,1>::type yxxy, grrg, tsst;
-                typename TProxyGenerator<1,0,0,2>::type yxxz, grrb, tssp;
-                typename TProxyGenerator<1,0,1,0>::type yxyx, grgr, tsts;
-                typename TProxyGenerator<1,0,1,1>::type yxyy, grgg, tstt;
-                typename TProxyGenerator<1,0,1,2>::type yxyz, grgb, tstp;
-                typename TProxyGenerator<1,0,2,0>::type yxzx, grbr, tsps;
-                typename TProxyGenerator<1,0,2,1>::type yxzy, grbg, tspt;
-                typename TProxyGenerator<1,0,2,2>::type yxzz, grbb, tspp;
-                typename TProxyGenerator<1,1,0,0>::type yyxx, ggrr, ttss;
-                typename TProxyGenerator<1,1,0,1>::type yyxy, ggrg, ttst;
-                typename TProxyGenerator<1,1,0,2>::type yyxz, ggrb, ttsp;
-                typename TProxyGenerator<1,1,1,0>::type yyyx, gggr, ttts;
-                typename TProxyGenerator<1,1,1,1>::type yyyy, gggg, tttt;
-                typename TProxyGenerator<1,1,1,2>::type yyyz, gggb, tttp;
-                typename TProxyGenerator<1,1,2,0>::type yyzx, ggbr, ttps;
-                typename TProxyGenerator<1,1,2,1>::type yyzy, ggbg, ttpt;
-                typename TProxyGenerator<1,1,2,2>::type yyzz, ggbb, ttpp;
-                typename TProxyGenerator<1,2,0,0>::type yzxx, gbrr, tpss;
-                typename TProxyGenerator<1,2,0,1>::type yzxy, gbrg, tpst;
-                typename TProxyGenerator<1,2,0,2>::type yzxz, gbrb, tpsp;
-                typename TProxyGenerator<1,2,1,0>::type yzyx, gbgr, tpts;
-                typename TProxyGenerator<1,2,1,1>::type yzyy, gbgg, tptt;
-                typename TProxyGenerator<1,2,1,2>::type yzyz, gbgb, tptp;
-                typename TProxyGenerator<1,2,2,0>::type yzzx, gbbr, tpps;
-                typename TProxyGenerator<1,2,2,1>::type yzzy, gbbg, tppt;
-                typename TProxyGenerator<1,2,2,2>::type yzzz, gbbb, tppp;
-                typename TProxyGenerator<2,0,0,0>::type zxxx, brrr, psss;
-                typename TProxyGenerator<2,0,0,1>::type zxxy, brrg, psst;
-                typename TProxyGenerator<2,0,0,2>::type zxxz, brrb, pssp;
-                typename TProxyGenerator<2,0,1,0>::type zxyx, brgr, psts;
-                typename TProxyGenerator<2,0,1,1>::type zxyy, brgg, pstt;
-                typename TProxyGenerator<2,0,1,2>::type zxyz, brgb, pstp;
-                typename TProxyGenerator<2,0,2,0>::type zxzx, brbr, psps;
-                typename TProxyGenerator<2,0,2,1>::type zxzy, brbg, pspt;
-                typename TProxyGenerator<2,0,2,2>::type zxzz, brbb, pspp;
-                typename TProxyGenerator<2,1,0,0>::type zyxx, bgrr, ptss;
-                typename TProxyGenerator<2,1,0,1>::type zyxy, bgrg, ptst;
-                typename TProxyGenerator<2,1,0,2>::type zyxz, bgrb, ptsp;
-                typename TProxyGenerator<2,1,1,0>::type zyyx, bggr, ptts;
-                typename TProxyGenerator<2,1,1,1>::type zyyy, bggg, pttt;
-                typename TProxyGenerator<2,1,1,2>::type zyyz, bggb, pttp;
-                typename TProxyGenerator<2,1,2,0>::type zyzx, bgbr, ptps;
-                typename TProxyGenerator<2,1,2,1>::type zyzy, bgbg, ptpt;
-                typename TProxyGenerator<2,1,2,2>::type zyzz, bgbb, ptpp;
-                typename TProxyGenerator<2,2,0,0>::type zzxx, bbrr, ppss;
-                typename TProxyGenerator<2,2,0,1>::type zzxy, bbrg, ppst;
-                typename TProxyGenerator<2,2,0,2>::type zzxz, bbrb, ppsp;
-                typename TProxyGenerator<2,2,1,0>::type zzyx, bbgr, ppts;
-                typename TProxyGenerator<2,2,1,1>::type zzyy, bbgg, pptt;
-                typename TProxyGenerator<2,2,1,2>::type zzyz, bbgb, pptp;
-                typename TProxyGenerator<2,2,2,0>::type zzzx, bbbr, ppps;
-                typename TProxyGenerator<2,2,2,1>::type zzzy, bbbg, pppt;
-                typename TProxyGenerator<2,2,2,2>::type zzzz, bbbb, pppp;
+                TProxy<0,0> xx, rr, ss;
+                TProxy<0,1> xy, rg, st;
+                TProxy<0,2> xz, rb, sp;
+                TProxy<1,0> yx, gr, ts;
+                TProxy<1,1> yy, gg, tt;
+                TProxy<1,2> yz, gb, tp;
+                TProxy<2,0> zx, br, ps;
+                TProxy<2,1> zy, bg, pt;
+                TProxy<2,2> zz, bb, pp;
+                TProxy<0,0,0> xxx, rrr, sss;
+                TProxy<0,0,1> xxy, rrg, sst;
+                TProxy<0,0,2> xxz, rrb, ssp;
+                TProxy<0,1,0> xyx, rgr, sts;
+                TProxy<0,1,1> xyy, rgg, stt;
+                TProxy<0,1,2> xyz, rgb, stp;
+                TProxy<0,2,0> xzx, rbr, sps;
+                TProxy<0,2,1> xzy, rbg, spt;
+                TProxy<0,2,2> xzz, rbb, spp;
+                TProxy<1,0,0> yxx, grr, tss;
+                TProxy<1,0,1> yxy, grg, tst;
+                TProxy<1,0,2> yxz, grb, tsp;
+                TProxy<1,1,0> yyx, ggr, tts;
+                TProxy<1,1,1> yyy, ggg, ttt;
+                TProxy<1,1,2> yyz, ggb, ttp;
+                TProxy<1,2,0> yzx, gbr, tps;
+                TProxy<1,2,1> yzy, gbg, tpt;
+                TProxy<1,2,2> yzz, gbb, tpp;
+                TProxy<2,0,0> zxx, brr, pss;
+                TProxy<2,0,1> zxy, brg, pst;
+                TProxy<2,0,2> zxz, brb, psp;
+                TProxy<2,1,0> zyx, bgr, pts;
+                TProxy<2,1,1> zyy, bgg, ptt;
+                TProxy<2,1,2> zyz, bgb, ptp;
+                TProxy<2,2,0> zzx, bbr, pps;
+                TProxy<2,2,1> zzy, bbg, ppt;
+                TProxy<2,2,2> zzz, bbb, ppp;
+                TProxy<0,0,0,0> xxxx, rrrr, ssss;
+                TProxy<0,0,0,1> xxxy, rrrg, ssst;
+                TProxy<0,0,0,2> xxxz, rrrb, sssp;
+                TProxy<0,0,1,0> xxyx, rrgr, ssts;
+                TProxy<0,0,1,1> xxyy, rrgg, sstt;
+                TProxy<0,0,1,2> xxyz, rrgb, sstp;
+                TProxy<0,0,2,0> xxzx, rrbr, ssps;
+                TProxy<0,0,2,1> xxzy, rrbg, sspt;
+                TProxy<0,0,2,2> xxzz, rrbb, sspp;
+                TProxy<0,1,0,0> xyxx, rgrr, stss;
+                TProxy<0,1,0,1> xyxy, rgrg, stst;
+                TProxy<0,1,0,2> xyxz, rgrb, stsp;
+                TProxy<0,1,1,0> xyyx, rggr, stts;
+                TProxy<0,1,1,1> xyyy, rggg, sttt;
+                TProxy<0,1,1,2> xyyz, rggb, sttp;
+                TProxy<0,1,2,0> xyzx, rgbr, stps;
+                TProxy<0,1,2,1> xyzy, rgbg, stpt;
+                TProxy<0,1,2,2> xyzz, rgbb, stpp;
+                TProxy<0,2,0,0> xzxx, rbrr, spss;
+                TProxy<0,2,0,1> xzxy, rbrg, spst;
+                TProxy<0,2,0,2> xzxz, rbrb, spsp;
+                TProxy<0,2,1,0> xzyx, rbgr, spts;
+                TProxy<0,2,1,1> xzyy, rbgg, sptt;
+                TProxy<0,2,1,2> xzyz, rbgb, sptp;
+                TProxy<0,2,2,0> xzzx, rbbr, spps;
+                TProxy<0,2,2,1> xzzy, rbbg, sppt;
+                TProxy<0,2,2,2> xzzz, rbbb, sppp;
+                TProxy<1,0,0,0> yxxx, grrr, tsss;
+                TProxy<1,0,0,1> yxxy, grrg, tsst;
+                TProxy<1,0,0,2> yxxz, grrb, tssp;
+                TProxy<1,0,1,0> yxyx, grgr, tsts;
+                TProxy<1,0,1,1> yxyy, grgg, tstt;
+                TProxy<1,0,1,2> yxyz, grgb, tstp;
+                TProxy<1,0,2,0> yxzx, grbr, tsps;
+                TProxy<1,0,2,1> yxzy, grbg, tspt;
+                TProxy<1,0,2,2> yxzz, grbb, tspp;
+                TProxy<1,1,0,0> yyxx, ggrr, ttss;
+                TProxy<1,1,0,1> yyxy, ggrg, ttst;
+                TProxy<1,1,0,2> yyxz, ggrb, ttsp;
+                TProxy<1,1,1,0> yyyx, gggr, ttts;
+                TProxy<1,1,1,1> yyyy, gggg, tttt;
+                TProxy<1,1,1,2> yyyz, gggb, tttp;
+                TProxy<1,1,2,0> yyzx, ggbr, ttps;
+                TProxy<1,1,2,1> yyzy, ggbg, ttpt;
+                TProxy<1,1,2,2> yyzz, ggbb, ttpp;
+                TProxy<1,2,0,0> yzxx, gbrr, tpss;
+                TProxy<1,2,0,1> yzxy, gbrg, tpst;
+                TProxy<1,2,0,2> yzxz, gbrb, tpsp;
+                TProxy<1,2,1,0> yzyx, gbgr, tpts;
+                TProxy<1,2,1,1> yzyy, gbgg, tptt;
+                TProxy<1,2,1,2> yzyz, gbgb, tptp;
+                TProxy<1,2,2,0> yzzx, gbbr, tpps;
+                TProxy<1,2,2,1> yzzy, gbbg, tppt;
+                TProxy<1,2,2,2> yzzz, gbbb, tppp;
+                TProxy<2,0,0,0> zxxx, brrr, psss;
+                TProxy<2,0,0,1> zxxy, brrg, psst;
+                TProxy<2,0,0,2> zxxz, brrb, pssp;
+                TProxy<2,0,1,0> zxyx, brgr, psts;
+                TProxy<2,0,1,1> zxyy, brgg, pstt;
+                TProxy<2,0,1,2> zxyz, brgb, pstp;
+                TProxy<2,0,2,0> zxzx, brbr, psps;
+                TProxy<2,0,2,1> zxzy, brbg, pspt;
+                TProxy<2,0,2,2> zxzz, brbb, pspp;
+                TProxy<2,1,0,0> zyxx, bgrr, ptss;
+                TProxy<2,1,0,1> zyxy, bgrg, ptst;
+                TProxy<2,1,0,2> zyxz, bgrb, ptsp;
+                TProxy<2,1,1,0> zyyx, bggr, ptts;
+                TProxy<2,1,1,1> zyyy, bggg, pttt;
+                TProxy<2,1,1,2> zyyz, bggb, pttp;
+                TProxy<2,1,2,0> zyzx, bgbr, ptps;
+                TProxy<2,1,2,1> zyzy, bgbg, ptpt;
+                TProxy<2,1,2,2> zyzz, bgbb, ptpp;
+                TProxy<2,2,0,0> zzxx, bbrr, ppss;
+                TProxy<2,2,0,1> zzxy, bbrg, ppst;
+                TProxy<2,2,0,2> zzxz, bbrb, ppsp;
+                TProxy<2,2,1,0> zzyx, bbgr, ppts;
+                TProxy<2,2,1,1> zzyy, bbgg, pptt;
+                TProxy<2,2,1,2> zzyz, bbgb, pptp;
+                TProxy<2,2,2,0> zzzx, bbbr, ppps;
+                TProxy<2,2,2,1> zzzy, bbbg, pppt;
+                TProxy<2,2,2,2> zzzz, bbbb, pppp;
             };
+
+            constexpr vector_base()
+                : m_data()
+            {}
+
+            constexpr vector_base(const TData& data)
+                : m_data(data)
+            {}
         };
 
-        template <template <size_t...> class TProxyGenerator, class TData>
-        struct vector_base<4, TProxyGenerator, TData>
+        template <template <size_t...> class TProxy, class TScalar, class TData>
+        struct vector_base<4, TProxy, TScalar, TData>
         {
             union
             {
@@ -246,365 +275,373 @@ namespace swizzle
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type x;
-                    typename TProxyGenerator<1>::type y;
-                    typename TProxyGenerator<2>::type z;
-                    typename TProxyGenerator<3>::type w;
+                    TScalar x;
+                    TScalar y;
+                    TScalar z;
+                    TScalar w;
                 };
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type r;
-                    typename TProxyGenerator<1>::type g;
-                    typename TProxyGenerator<2>::type b;
-                    typename TProxyGenerator<3>::type a;
+                    TScalar r;
+                    TScalar g;
+                    TScalar b;
+                    TScalar a;
                 };
 
                 struct
                 {
-                    typename TProxyGenerator<0>::type s;
-                    typename TProxyGenerator<1>::type t;
-                    typename TProxyGenerator<2>::type p;
-                    typename TProxyGenerator<3>::type q;
+                    TScalar s;
+                    TScalar t;
+                    TScalar p;
+                    TScalar q;
                 };
 
-                typename TProxyGenerator<0,0>::type xx, rr, ss;
-                typename TProxyGenerator<0,1>::type xy, rg, st;
-                typename TProxyGenerator<0,2>::type xz, rb, sp;
-                typename TProxyGenerator<0,3>::type xw, ra, sq;
-                typename TProxyGenerator<1,0>::type yx, gr, ts;
-                typename TProxyGenerator<1,1>::type yy, gg, tt;
-                typename TProxyGenerator<1,2>::type yz, gb, tp;
-                typename TProxyGenerator<1,3>::type yw, ga, tq;
-                typename TProxyGenerator<2,0>::type zx, br, ps;
-                typename TProxyGenerator<2,1>::type zy, bg, pt;
-                typename TProxyGenerator<2,2>::type zz, bb, pp;
-                typename TProxyGenerator<2,3>::type zw, ba, pq;
-                typename TProxyGenerator<3,0>::type wx, ar, qs;
-                typename TProxyGenerator<3,1>::type wy, ag, qt;
-                typename TProxyGenerator<3,2>::type wz, ab, qp;
-                typename TProxyGenerator<3,3>::type ww, aa, qq;
-                typename TProxyGenerator<0,0,0>::type xxx, rrr, sss;
-                typename TProxyGenerator<0,0,1>::type xxy, rrg, sst;
-                typename TProxyGenerator<0,0,2>::type xxz, rrb, ssp;
-                typename TProxyGenerator<0,0,3>::type xxw, rra, ssq;
-                typename TProxyGenerator<0,1,0>::type xyx, rgr, sts;
-                typename TProxyGenerator<0,1,1>::type xyy, rgg, stt;
-                typename TProxyGenerator<0,1,2>::type xyz, rgb, stp;
-                typename TProxyGenerator<0,1,3>::type xyw, rga, stq;
-                typename TProxyGenerator<0,2,0>::type xzx, rbr, sps;
-                typename TProxyGenerator<0,2,1>::type xzy, rbg, spt;
-                typename TProxyGenerator<0,2,2>::type xzz, rbb, spp;
-                typename TProxyGenerator<0,2,3>::type xzw, rba, spq;
-                typename TProxyGenerator<0,3,0>::type xwx, rar, sqs;
-                typename TProxyGenerator<0,3,1>::type xwy, rag, sqt;
-                typename TProxyGenerator<0,3,2>::type xwz, rab, sqp;
-                typename TProxyGenerator<0,3,3>::type xww, raa, sqq;
-                typename TProxyGenerator<1,0,0>::type yxx, grr, tss;
-                typename TProxyGenerator<1,0,1>::type yxy, grg, tst;
-                typename TProxyGenerator<1,0,2>::type yxz, grb, tsp;
-                typename TProxyGenerator<1,0,3>::type yxw, gra, tsq;
-                typename TProxyGenerator<1,1,0>::type yyx, ggr, tts;
-                typename TProxyGenerator<1,1,1>::type yyy, ggg, ttt;
-                typename TProxyGenerator<1,1,2>::type yyz, ggb, ttp;
-                typename TProxyGenerator<1,1,3>::type yyw, gga, ttq;
-                typename TProxyGenerator<1,2,0>::type yzx, gbr, tps;
-                typename TProxyGenerator<1,2,1>::type yzy, gbg, tpt;
-                typename TProxyGenerator<1,2,2>::type yzz, gbb, tpp;
-                typename TProxyGenerator<1,2,3>::type yzw, gba, tpq;
-                typename TProxyGenerator<1,3,0>::type ywx, gar, tqs;
-                typename TProxyGenerator<1,3,1>::type ywy, gag, tqt;
-                typename TProxyGenerator<1,3,2>::type ywz, gab, tqp;
-                typename TProxyGenerator<1,3,3>::type yww, gaa, tqq;
-                typename TProxyGenerator<2,0,0>::type zxx, brr, pss;
-                typename TProxyGenerator<2,0,1>::type zxy, brg, pst;
-                typename TProxyGenerator<2,0,2>::type zxz, brb, psp;
-                typename TProxyGenerator<2,0,3>::type zxw, bra, psq;
-                typename TProxyGenerator<2,1,0>::type zyx, bgr, pts;
-                typename TProxyGenerator<2,1,1>::type zyy, bgg, ptt;
-                typename TProxyGenerator<2,1,2>::type zyz, bgb, ptp;
-                typename TProxyGenerator<2,1,3>::type zyw, bga, ptq;
-                typename TProxyGenerator<2,2,0>::type zzx, bbr, pps;
-                typename TProxyGenerator<2,2,1>::type zzy, bbg, ppt;
-                typename TProxyGenerator<2,2,2>::type zzz, bbb, ppp;
-                typename TProxyGenerator<2,2,3>::type zzw, bba, ppq;
-                typename TProxyGenerator<2,3,0>::type zwx, bar, pqs;
-                typename TProxyGenerator<2,3,1>::type zwy, bag, pqt;
-                typename TProxyGenerator<2,3,2>::type zwz, bab, pqp;
-                typename TProxyGenerator<2,3,3>::type zww, baa, pqq;
-                typename TProxyGenerator<3,0,0>::type wxx, arr, qss;
-                typename TProxyGenerator<3,0,1>::type wxy, arg, qst;
-                typename TProxyGenerator<3,0,2>::type wxz, arb, qsp;
-                typename TProxyGenerator<3,0,3>::type wxw, ara, qsq;
-                typename TProxyGenerator<3,1,0>::type wyx, agr, qts;
-                typename TProxyGenerator<3,1,1>::type wyy, agg, qtt;
-                typename TProxyGenerator<3,1,2>::type wyz, agb, qtp;
-                typename TProxyGenerator<3,1,3>::type wyw, aga, qtq;
-                typename TProxyGenerator<3,2,0>::type wzx, abr, qps;
-                typename TProxyGenerator<3,2,1>::type wzy, abg, qpt;
-                typename TProxyGenerator<3,2,2>::type wzz, abb, qpp;
-                typename TProxyGenerator<3,2,3>::type wzw, aba, qpq;
-                typename TProxyGenerator<3,3,0>::type wwx, aar, qqs;
-                typename TProxyGenerator<3,3,1>::type wwy, aag, qqt;
-                typename TProxyGenerator<3,3,2>::type wwz, aab, qqp;
-                typename TProxyGenerator<3,3,3>::type www, aaa, qqq;
-                typename TProxyGenerator<0,0,0,0>::type xxxx, rrrr, ssss;
-                typename TProxyGenerator<0,0,0,1>::type xxxy, rrrg, ssst;
-                typename TProxyGenerator<0,0,0,2>::type xxxz, rrrb, sssp;
-                typename TProxyGenerator<0,0,0,3>::type xxxw, rrra, sssq;
-                typename TProxyGenerator<0,0,1,0>::type xxyx, rrgr, ssts;
-                typename TProxyGenerator<0,0,1,1>::type xxyy, rrgg, sstt;
-                typename TProxyGenerator<0,0,1,2>::type xxyz, rrgb, sstp;
-                typename TProxyGenerator<0,0,1,3>::type xxyw, rrga, sstq;
-                typename TProxyGenerator<0,0,2,0>::type xxzx, rrbr, ssps;
-                typename TProxyGenerator<0,0,2,1>::type xxzy, rrbg, sspt;
-                typename TProxyGenerator<0,0,2,2>::type xxzz, rrbb, sspp;
-                typename TProxyGenerator<0,0,2,3>::type xxzw, rrba, sspq;
-                typename TProxyGenerator<0,0,3,0>::type xxwx, rrar, ssqs;
-                typename TProxyGenerator<0,0,3,1>::type xxwy, rrag, ssqt;
-                typename TProxyGenerator<0,0,3,2>::type xxwz, rrab, ssqp;
-                typename TProxyGenerator<0,0,3,3>::type xxww, rraa, ssqq;
-                typename TProxyGenerator<0,1,0,0>::type xyxx, rgrr, stss;
-                typename TProxyGenerator<0,1,0,1>::type xyxy, rgrg, stst;
-                typename TProxyGenerator<0,1,0,2>::type xyxz, rgrb, stsp;
-                typename TProxyGenerator<0,1,0,3>::type xyxw, rgra, stsq;
-                typename TProxyGenerator<0,1,1,0>::type xyyx, rggr, stts;
-                typename TProxyGenerator<0,1,1,1>::type xyyy, rggg, sttt;
-                typename TProxyGenerator<0,1,1,2>::type xyyz, rggb, sttp;
-                typename TProxyGenerator<0,1,1,3>::type xyyw, rgga, sttq;
-                typename TProxyGenerator<0,1,2,0>::type xyzx, rgbr, stps;
-                typename TProxyGenerator<0,1,2,1>::type xyzy, rgbg, stpt;
-                typename TProxyGenerator<0,1,2,2>::type xyzz, rgbb, stpp;
-                typename TProxyGenerator<0,1,2,3>::type xyzw, rgba, stpq;
-                typename TProxyGenerator<0,1,3,0>::type xywx, rgar, stqs;
-                typename TProxyGenerator<0,1,3,1>::type xywy, rgag, stqt;
-                typename TProxyGenerator<0,1,3,2>::type xywz, rgab, stqp;
-                typename TProxyGenerator<0,1,3,3>::type xyww, rgaa, stqq;
-                typename TProxyGenerator<0,2,0,0>::type xzxx, rbrr, spss;
-                typename TProxyGenerator<0,2,0,1>::type xzxy, rbrg, spst;
-                typename TProxyGenerator<0,2,0,2>::type xzxz, rbrb, spsp;
-                typename TProxyGenerator<0,2,0,3>::type xzxw, rbra, spsq;
-                typename TProxyGenerator<0,2,1,0>::type xzyx, rbgr, spts;
-                typename TProxyGenerator<0,2,1,1>::type xzyy, rbgg, sptt;
-                typename TProxyGenerator<0,2,1,2>::type xzyz, rbgb, sptp;
-                typename TProxyGenerator<0,2,1,3>::type xzyw, rbga, sptq;
-                typename TProxyGenerator<0,2,2,0>::type xzzx, rbbr, spps;
-                typename TProxyGenerator<0,2,2,1>::type xzzy, rbbg, sppt;
-                typename TProxyGenerator<0,2,2,2>::type xzzz, rbbb, sppp;
-                typename TProxyGenerator<0,2,2,3>::type xzzw, rbba, sppq;
-                typename TProxyGenerator<0,2,3,0>::type xzwx, rbar, spqs;
-                typename TProxyGenerator<0,2,3,1>::type xzwy, rbag, spqt;
-                typename TProxyGenerator<0,2,3,2>::type xzwz, rbab, spqp;
-                typename TProxyGenerator<0,2,3,3>::type xzww, rbaa, spqq;
-                typename TProxyGenerator<0,3,0,0>::type xwxx, rarr, sqss;
-                typename TProxyGenerator<0,3,0,1>::type xwxy, rarg, sqst;
-                typename TProxyGenerator<0,3,0,2>::type xwxz, rarb, sqsp;
-                typename TProxyGenerator<0,3,0,3>::type xwxw, rara, sqsq;
-                typename TProxyGenerator<0,3,1,0>::type xwyx, ragr, sqts;
-                typename TProxyGenerator<0,3,1,1>::type xwyy, ragg, sqtt;
-                typename TProxyGenerator<0,3,1,2>::type xwyz, ragb, sqtp;
-                typename TProxyGenerator<0,3,1,3>::type xwyw, raga, sqtq;
-                typename TProxyGenerator<0,3,2,0>::type xwzx, rabr, sqps;
-                typename TProxyGenerator<0,3,2,1>::type xwzy, rabg, sqpt;
-                typename TProxyGenerator<0,3,2,2>::type xwzz, rabb, sqpp;
-                typename TProxyGenerator<0,3,2,3>::type xwzw, raba, sqpq;
-                typename TProxyGenerator<0,3,3,0>::type xwwx, raar, sqqs;
-                typename TProxyGenerator<0,3,3,1>::type xwwy, raag, sqqt;
-                typename TProxyGenerator<0,3,3,2>::type xwwz, raab, sqqp;
-                typename TProxyGenerator<0,3,3,3>::type xwww, raaa, sqqq;
-                typename TProxyGenerator<1,0,0,0>::type yxxx, grrr, tsss;
-                typename TProxyGenerator<1,0,0,1>::type yxxy, grrg, tsst;
-                typename TProxyGenerator<1,0,0,2>::type yxxz, grrb, tssp;
-                typename TProxyGenerator<1,0,0,3>::type yxxw, grra, tssq;
-                typename TProxyGenerator<1,0,1,0>::type yxyx, grgr, tsts;
-                typename TProxyGenerator<1,0,1,1>::type yxyy, grgg, tstt;
-                typename TProxyGenerator<1,0,1,2>::type yxyz, grgb, tstp;
-                typename TProxyGenerator<1,0,1,3>::type yxyw, grga, tstq;
-                typename TProxyGenerator<1,0,2,0>::type yxzx, grbr, tsps;
-                typename TProxyGenerator<1,0,2,1>::type yxzy, grbg, tspt;
-                typename TProxyGenerator<1,0,2,2>::type yxzz, grbb, tspp;
-                typename TProxyGenerator<1,0,2,3>::type yxzw, grba, tspq;
-                typename TProxyGenerator<1,0,3,0>::type yxwx, grar, tsqs;
-                typename TProxyGenerator<1,0,3,1>::type yxwy, grag, tsqt;
-                typename TProxyGenerator<1,0,3,2>::type yxwz, grab, tsqp;
-                typename TProxyGenerator<1,0,3,3>::type yxww, graa, tsqq;
-                typename TProxyGenerator<1,1,0,0>::type yyxx, ggrr, ttss;
-                typename TProxyGenerator<1,1,0,1>::type yyxy, ggrg, ttst;
-                typename TProxyGenerator<1,1,0,2>::type yyxz, ggrb, ttsp;
-                typename TProxyGenerator<1,1,0,3>::type yyxw, ggra, ttsq;
-                typename TProxyGenerator<1,1,1,0>::type yyyx, gggr, ttts;
-                typename TProxyGenerator<1,1,1,1>::type yyyy, gggg, tttt;
-                typename TProxyGenerator<1,1,1,2>::type yyyz, gggb, tttp;
-                typename TProxyGenerator<1,1,1,3>::type yyyw, ggga, tttq;
-                typename TProxyGenerator<1,1,2,0>::type yyzx, ggbr, ttps;
-                typename TProxyGenerator<1,1,2,1>::type yyzy, ggbg, ttpt;
-                typename TProxyGenerator<1,1,2,2>::type yyzz, ggbb, ttpp;
-                typename TProxyGenerator<1,1,2,3>::type yyzw, ggba, ttpq;
-                typename TProxyGenerator<1,1,3,0>::type yywx, ggar, ttqs;
-                typename TProxyGenerator<1,1,3,1>::type yywy, ggag, ttqt;
-                typename TProxyGenerator<1,1,3,2>::type yywz, ggab, ttqp;
-                typename TProxyGenerator<1,1,3,3>::type yyww, ggaa, ttqq;
-                typename TProxyGenerator<1,2,0,0>::type yzxx, gbrr, tpss;
-                typename TProxyGenerator<1,2,0,1>::type yzxy, gbrg, tpst;
-                typename TProxyGenerator<1,2,0,2>::type yzxz, gbrb, tpsp;
-                typename TProxyGenerator<1,2,0,3>::type yzxw, gbra, tpsq;
-                typename TProxyGenerator<1,2,1,0>::type yzyx, gbgr, tpts;
-                typename TProxyGenerator<1,2,1,1>::type yzyy, gbgg, tptt;
-                typename TProxyGenerator<1,2,1,2>::type yzyz, gbgb, tptp;
-                typename TProxyGenerator<1,2,1,3>::type yzyw, gbga, tptq;
-                typename TProxyGenerator<1,2,2,0>::type yzzx, gbbr, tpps;
-                typename TProxyGenerator<1,2,2,1>::type yzzy, gbbg, tppt;
-                typename TProxyGenerator<1,2,2,2>::type yzzz, gbbb, tppp;
-                typename TProxyGenerator<1,2,2,3>::type yzzw, gbba, tppq;
-                typename TProxyGenerator<1,2,3,0>::type yzwx, gbar, tpqs;
-                typename TProxyGenerator<1,2,3,1>::type yzwy, gbag, tpqt;
-                typename TProxyGenerator<1,2,3,2>::type yzwz, gbab, tpqp;
-                typename TProxyGenerator<1,2,3,3>::type yzww, gbaa, tpqq;
-                typename TProxyGenerator<1,3,0,0>::type ywxx, garr, tqss;
-                typename TProxyGenerator<1,3,0,1>::type ywxy, garg, tqst;
-                typename TProxyGenerator<1,3,0,2>::type ywxz, garb, tqsp;
-                typename TProxyGenerator<1,3,0,3>::type ywxw, gara, tqsq;
-                typename TProxyGenerator<1,3,1,0>::type ywyx, gagr, tqts;
-                typename TProxyGenerator<1,3,1,1>::type ywyy, gagg, tqtt;
-                typename TProxyGenerator<1,3,1,2>::type ywyz, gagb, tqtp;
-                typename TProxyGenerator<1,3,1,3>::type ywyw, gaga, tqtq;
-                typename TProxyGenerator<1,3,2,0>::type ywzx, gabr, tqps;
-                typename TProxyGenerator<1,3,2,1>::type ywzy, gabg, tqpt;
-                typename TProxyGenerator<1,3,2,2>::type ywzz, gabb, tqpp;
-                typename TProxyGenerator<1,3,2,3>::type ywzw, gaba, tqpq;
-                typename TProxyGenerator<1,3,3,0>::type ywwx, gaar, tqqs;
-                typename TProxyGenerator<1,3,3,1>::type ywwy, gaag, tqqt;
-                typename TProxyGenerator<1,3,3,2>::type ywwz, gaab, tqqp;
-                typename TProxyGenerator<1,3,3,3>::type ywww, gaaa, tqqq;
-                typename TProxyGenerator<2,0,0,0>::type zxxx, brrr, psss;
-                typename TProxyGenerator<2,0,0,1>::type zxxy, brrg, psst;
-                typename TProxyGenerator<2,0,0,2>::type zxxz, brrb, pssp;
-                typename TProxyGenerator<2,0,0,3>::type zxxw, brra, pssq;
-                typename TProxyGenerator<2,0,1,0>::type zxyx, brgr, psts;
-                typename TProxyGenerator<2,0,1,1>::type zxyy, brgg, pstt;
-                typename TProxyGenerator<2,0,1,2>::type zxyz, brgb, pstp;
-                typename TProxyGenerator<2,0,1,3>::type zxyw, brga, pstq;
-                typename TProxyGenerator<2,0,2,0>::type zxzx, brbr, psps;
-                typename TProxyGenerator<2,0,2,1>::type zxzy, brbg, pspt;
-                typename TProxyGenerator<2,0,2,2>::type zxzz, brbb, pspp;
-                typename TProxyGenerator<2,0,2,3>::type zxzw, brba, pspq;
-                typename TProxyGenerator<2,0,3,0>::type zxwx, brar, psqs;
-                typename TProxyGenerator<2,0,3,1>::type zxwy, brag, psqt;
-                typename TProxyGenerator<2,0,3,2>::type zxwz, brab, psqp;
-                typename TProxyGenerator<2,0,3,3>::type zxww, braa, psqq;
-                typename TProxyGenerator<2,1,0,0>::type zyxx, bgrr, ptss;
-                typename TProxyGenerator<2,1,0,1>::type zyxy, bgrg, ptst;
-                typename TProxyGenerator<2,1,0,2>::type zyxz, bgrb, ptsp;
-                typename TProxyGenerator<2,1,0,3>::type zyxw, bgra, ptsq;
-                typename TProxyGenerator<2,1,1,0>::type zyyx, bggr, ptts;
-                typename TProxyGenerator<2,1,1,1>::type zyyy, bggg, pttt;
-                typename TProxyGenerator<2,1,1,2>::type zyyz, bggb, pttp;
-                typename TProxyGenerator<2,1,1,3>::type zyyw, bgga, pttq;
-                typename TProxyGenerator<2,1,2,0>::type zyzx, bgbr, ptps;
-                typename TProxyGenerator<2,1,2,1>::type zyzy, bgbg, ptpt;
-                typename TProxyGenerator<2,1,2,2>::type zyzz, bgbb, ptpp;
-                typename TProxyGenerator<2,1,2,3>::type zyzw, bgba, ptpq;
-                typename TProxyGenerator<2,1,3,0>::type zywx, bgar, ptqs;
-                typename TProxyGenerator<2,1,3,1>::type zywy, bgag, ptqt;
-                typename TProxyGenerator<2,1,3,2>::type zywz, bgab, ptqp;
-                typename TProxyGenerator<2,1,3,3>::type zyww, bgaa, ptqq;
-                typename TProxyGenerator<2,2,0,0>::type zzxx, bbrr, ppss;
-                typename TProxyGenerator<2,2,0,1>::type zzxy, bbrg, ppst;
-                typename TProxyGenerator<2,2,0,2>::type zzxz, bbrb, ppsp;
-                typename TProxyGenerator<2,2,0,3>::type zzxw, bbra, ppsq;
-                typename TProxyGenerator<2,2,1,0>::type zzyx, bbgr, ppts;
-                typename TProxyGenerator<2,2,1,1>::type zzyy, bbgg, pptt;
-                typename TProxyGenerator<2,2,1,2>::type zzyz, bbgb, pptp;
-                typename TProxyGenerator<2,2,1,3>::type zzyw, bbga, pptq;
-                typename TProxyGenerator<2,2,2,0>::type zzzx, bbbr, ppps;
-                typename TProxyGenerator<2,2,2,1>::type zzzy, bbbg, pppt;
-                typename TProxyGenerator<2,2,2,2>::type zzzz, bbbb, pppp;
-                typename TProxyGenerator<2,2,2,3>::type zzzw, bbba, pppq;
-                typename TProxyGenerator<2,2,3,0>::type zzwx, bbar, ppqs;
-                typename TProxyGenerator<2,2,3,1>::type zzwy, bbag, ppqt;
-                typename TProxyGenerator<2,2,3,2>::type zzwz, bbab, ppqp;
-                typename TProxyGenerator<2,2,3,3>::type zzww, bbaa, ppqq;
-                typename TProxyGenerator<2,3,0,0>::type zwxx, barr, pqss;
-                typename TProxyGenerator<2,3,0,1>::type zwxy, barg, pqst;
-                typename TProxyGenerator<2,3,0,2>::type zwxz, barb, pqsp;
-                typename TProxyGenerator<2,3,0,3>::type zwxw, bara, pqsq;
-                typename TProxyGenerator<2,3,1,0>::type zwyx, bagr, pqts;
-                typename TProxyGenerator<2,3,1,1>::type zwyy, bagg, pqtt;
-                typename TProxyGenerator<2,3,1,2>::type zwyz, bagb, pqtp;
-                typename TProxyGenerator<2,3,1,3>::type zwyw, baga, pqtq;
-                typename TProxyGenerator<2,3,2,0>::type zwzx, babr, pqps;
-                typename TProxyGenerator<2,3,2,1>::type zwzy, babg, pqpt;
-                typename TProxyGenerator<2,3,2,2>::type zwzz, babb, pqpp;
-                typename TProxyGenerator<2,3,2,3>::type zwzw, baba, pqpq;
-                typename TProxyGenerator<2,3,3,0>::type zwwx, baar, pqqs;
-                typename TProxyGenerator<2,3,3,1>::type zwwy, baag, pqqt;
-                typename TProxyGenerator<2,3,3,2>::type zwwz, baab, pqqp;
-                typename TProxyGenerator<2,3,3,3>::type zwww, baaa, pqqq;
-                typename TProxyGenerator<3,0,0,0>::type wxxx, arrr, qsss;
-                typename TProxyGenerator<3,0,0,1>::type wxxy, arrg, qsst;
-                typename TProxyGenerator<3,0,0,2>::type wxxz, arrb, qssp;
-                typename TProxyGenerator<3,0,0,3>::type wxxw, arra, qssq;
-                typename TProxyGenerator<3,0,1,0>::type wxyx, argr, qsts;
-                typename TProxyGenerator<3,0,1,1>::type wxyy, argg, qstt;
-                typename TProxyGenerator<3,0,1,2>::type wxyz, argb, qstp;
-                typename TProxyGenerator<3,0,1,3>::type wxyw, arga, qstq;
-                typename TProxyGenerator<3,0,2,0>::type wxzx, arbr, qsps;
-                typename TProxyGenerator<3,0,2,1>::type wxzy, arbg, qspt;
-                typename TProxyGenerator<3,0,2,2>::type wxzz, arbb, qspp;
-                typename TProxyGenerator<3,0,2,3>::type wxzw, arba, qspq;
-                typename TProxyGenerator<3,0,3,0>::type wxwx, arar, qsqs;
-                typename TProxyGenerator<3,0,3,1>::type wxwy, arag, qsqt;
-                typename TProxyGenerator<3,0,3,2>::type wxwz, arab, qsqp;
-                typename TProxyGenerator<3,0,3,3>::type wxww, araa, qsqq;
-                typename TProxyGenerator<3,1,0,0>::type wyxx, agrr, qtss;
-                typename TProxyGenerator<3,1,0,1>::type wyxy, agrg, qtst;
-                typename TProxyGenerator<3,1,0,2>::type wyxz, agrb, qtsp;
-                typename TProxyGenerator<3,1,0,3>::type wyxw, agra, qtsq;
-                typename TProxyGenerator<3,1,1,0>::type wyyx, aggr, qtts;
-                typename TProxyGenerator<3,1,1,1>::type wyyy, aggg, qttt;
-                typename TProxyGenerator<3,1,1,2>::type wyyz, aggb, qttp;
-                typename TProxyGenerator<3,1,1,3>::type wyyw, agga, qttq;
-                typename TProxyGenerator<3,1,2,0>::type wyzx, agbr, qtps;
-                typename TProxyGenerator<3,1,2,1>::type wyzy, agbg, qtpt;
-                typename TProxyGenerator<3,1,2,2>::type wyzz, agbb, qtpp;
-                typename TProxyGenerator<3,1,2,3>::type wyzw, agba, qtpq;
-                typename TProxyGenerator<3,1,3,0>::type wywx, agar, qtqs;
-                typename TProxyGenerator<3,1,3,1>::type wywy, agag, qtqt;
-                typename TProxyGenerator<3,1,3,2>::type wywz, agab, qtqp;
-                typename TProxyGenerator<3,1,3,3>::type wyww, agaa, qtqq;
-                typename TProxyGenerator<3,2,0,0>::type wzxx, abrr, qpss;
-                typename TProxyGenerator<3,2,0,1>::type wzxy, abrg, qpst;
-                typename TProxyGenerator<3,2,0,2>::type wzxz, abrb, qpsp;
-                typename TProxyGenerator<3,2,0,3>::type wzxw, abra, qpsq;
-                typename TProxyGenerator<3,2,1,0>::type wzyx, abgr, qpts;
-                typename TProxyGenerator<3,2,1,1>::type wzyy, abgg, qptt;
-                typename TProxyGenerator<3,2,1,2>::type wzyz, abgb, qptp;
-                typename TProxyGenerator<3,2,1,3>::type wzyw, abga, qptq;
-                typename TProxyGenerator<3,2,2,0>::type wzzx, abbr, qpps;
-                typename TProxyGenerator<3,2,2,1>::type wzzy, abbg, qppt;
-                typename TProxyGenerator<3,2,2,2>::type wzzz, abbb, qppp;
-                typename TProxyGenerator<3,2,2,3>::type wzzw, abba, qppq;
-                typename TProxyGenerator<3,2,3,0>::type wzwx, abar, qpqs;
-                typename TProxyGenerator<3,2,3,1>::type wzwy, abag, qpqt;
-                typename TProxyGenerator<3,2,3,2>::type wzwz, abab, qpqp;
-                typename TProxyGenerator<3,2,3,3>::type wzww, abaa, qpqq;
-                typename TProxyGenerator<3,3,0,0>::type wwxx, aarr, qqss;
-                typename TProxyGenerator<3,3,0,1>::type wwxy, aarg, qqst;
-                typename TProxyGenerator<3,3,0,2>::type wwxz, aarb, qqsp;
-                typename TProxyGenerator<3,3,0,3>::type wwxw, aara, qqsq;
-                typename TProxyGenerator<3,3,1,0>::type wwyx, aagr, qqts;
-                typename TProxyGenerator<3,3,1,1>::type wwyy, aagg, qqtt;
-                typename TProxyGenerator<3,3,1,2>::type wwyz, aagb, qqtp;
-                typename TProxyGenerator<3,3,1,3>::type wwyw, aaga, qqtq;
-                typename TProxyGenerator<3,3,2,0>::type wwzx, aabr, qqps;
-                typename TProxyGenerator<3,3,2,1>::type wwzy, aabg, qqpt;
-                typename TProxyGenerator<3,3,2,2>::type wwzz, aabb, qqpp;
-                typename TProxyGenerator<3,3,2,3>::type wwzw, aaba, qqpq;
-                typename TProxyGenerator<3,3,3,0>::type wwwx, aaar, qqqs;
-                typename TProxyGenerator<3,3,3,1>::type wwwy, aaag, qqqt;
-                typename TProxyGenerator<3,3,3,2>::type wwwz, aaab, qqqp;
-                typename TProxyGenerator<3,3,3,3>::type wwww, aaaa, qqqq;
+                TProxy<0,0> xx, rr, ss;
+                TProxy<0,1> xy, rg, st;
+                TProxy<0,2> xz, rb, sp;
+                TProxy<0,3> xw, ra, sq;
+                TProxy<1,0> yx, gr, ts;
+                TProxy<1,1> yy, gg, tt;
+                TProxy<1,2> yz, gb, tp;
+                TProxy<1,3> yw, ga, tq;
+                TProxy<2,0> zx, br, ps;
+                TProxy<2,1> zy, bg, pt;
+                TProxy<2,2> zz, bb, pp;
+                TProxy<2,3> zw, ba, pq;
+                TProxy<3,0> wx, ar, qs;
+                TProxy<3,1> wy, ag, qt;
+                TProxy<3,2> wz, ab, qp;
+                TProxy<3,3> ww, aa, qq;
+                TProxy<0,0,0> xxx, rrr, sss;
+                TProxy<0,0,1> xxy, rrg, sst;
+                TProxy<0,0,2> xxz, rrb, ssp;
+                TProxy<0,0,3> xxw, rra, ssq;
+                TProxy<0,1,0> xyx, rgr, sts;
+                TProxy<0,1,1> xyy, rgg, stt;
+                TProxy<0,1,2> xyz, rgb, stp;
+                TProxy<0,1,3> xyw, rga, stq;
+                TProxy<0,2,0> xzx, rbr, sps;
+                TProxy<0,2,1> xzy, rbg, spt;
+                TProxy<0,2,2> xzz, rbb, spp;
+                TProxy<0,2,3> xzw, rba, spq;
+                TProxy<0,3,0> xwx, rar, sqs;
+                TProxy<0,3,1> xwy, rag, sqt;
+                TProxy<0,3,2> xwz, rab, sqp;
+                TProxy<0,3,3> xww, raa, sqq;
+                TProxy<1,0,0> yxx, grr, tss;
+                TProxy<1,0,1> yxy, grg, tst;
+                TProxy<1,0,2> yxz, grb, tsp;
+                TProxy<1,0,3> yxw, gra, tsq;
+                TProxy<1,1,0> yyx, ggr, tts;
+                TProxy<1,1,1> yyy, ggg, ttt;
+                TProxy<1,1,2> yyz, ggb, ttp;
+                TProxy<1,1,3> yyw, gga, ttq;
+                TProxy<1,2,0> yzx, gbr, tps;
+                TProxy<1,2,1> yzy, gbg, tpt;
+                TProxy<1,2,2> yzz, gbb, tpp;
+                TProxy<1,2,3> yzw, gba, tpq;
+                TProxy<1,3,0> ywx, gar, tqs;
+                TProxy<1,3,1> ywy, gag, tqt;
+                TProxy<1,3,2> ywz, gab, tqp;
+                TProxy<1,3,3> yww, gaa, tqq;
+                TProxy<2,0,0> zxx, brr, pss;
+                TProxy<2,0,1> zxy, brg, pst;
+                TProxy<2,0,2> zxz, brb, psp;
+                TProxy<2,0,3> zxw, bra, psq;
+                TProxy<2,1,0> zyx, bgr, pts;
+                TProxy<2,1,1> zyy, bgg, ptt;
+                TProxy<2,1,2> zyz, bgb, ptp;
+                TProxy<2,1,3> zyw, bga, ptq;
+                TProxy<2,2,0> zzx, bbr, pps;
+                TProxy<2,2,1> zzy, bbg, ppt;
+                TProxy<2,2,2> zzz, bbb, ppp;
+                TProxy<2,2,3> zzw, bba, ppq;
+                TProxy<2,3,0> zwx, bar, pqs;
+                TProxy<2,3,1> zwy, bag, pqt;
+                TProxy<2,3,2> zwz, bab, pqp;
+                TProxy<2,3,3> zww, baa, pqq;
+                TProxy<3,0,0> wxx, arr, qss;
+                TProxy<3,0,1> wxy, arg, qst;
+                TProxy<3,0,2> wxz, arb, qsp;
+                TProxy<3,0,3> wxw, ara, qsq;
+                TProxy<3,1,0> wyx, agr, qts;
+                TProxy<3,1,1> wyy, agg, qtt;
+                TProxy<3,1,2> wyz, agb, qtp;
+                TProxy<3,1,3> wyw, aga, qtq;
+                TProxy<3,2,0> wzx, abr, qps;
+                TProxy<3,2,1> wzy, abg, qpt;
+                TProxy<3,2,2> wzz, abb, qpp;
+                TProxy<3,2,3> wzw, aba, qpq;
+                TProxy<3,3,0> wwx, aar, qqs;
+                TProxy<3,3,1> wwy, aag, qqt;
+                TProxy<3,3,2> wwz, aab, qqp;
+                TProxy<3,3,3> www, aaa, qqq;
+                TProxy<0,0,0,0> xxxx, rrrr, ssss;
+                TProxy<0,0,0,1> xxxy, rrrg, ssst;
+                TProxy<0,0,0,2> xxxz, rrrb, sssp;
+                TProxy<0,0,0,3> xxxw, rrra, sssq;
+                TProxy<0,0,1,0> xxyx, rrgr, ssts;
+                TProxy<0,0,1,1> xxyy, rrgg, sstt;
+                TProxy<0,0,1,2> xxyz, rrgb, sstp;
+                TProxy<0,0,1,3> xxyw, rrga, sstq;
+                TProxy<0,0,2,0> xxzx, rrbr, ssps;
+                TProxy<0,0,2,1> xxzy, rrbg, sspt;
+                TProxy<0,0,2,2> xxzz, rrbb, sspp;
+                TProxy<0,0,2,3> xxzw, rrba, sspq;
+                TProxy<0,0,3,0> xxwx, rrar, ssqs;
+                TProxy<0,0,3,1> xxwy, rrag, ssqt;
+                TProxy<0,0,3,2> xxwz, rrab, ssqp;
+                TProxy<0,0,3,3> xxww, rraa, ssqq;
+                TProxy<0,1,0,0> xyxx, rgrr, stss;
+                TProxy<0,1,0,1> xyxy, rgrg, stst;
+                TProxy<0,1,0,2> xyxz, rgrb, stsp;
+                TProxy<0,1,0,3> xyxw, rgra, stsq;
+                TProxy<0,1,1,0> xyyx, rggr, stts;
+                TProxy<0,1,1,1> xyyy, rggg, sttt;
+                TProxy<0,1,1,2> xyyz, rggb, sttp;
+                TProxy<0,1,1,3> xyyw, rgga, sttq;
+                TProxy<0,1,2,0> xyzx, rgbr, stps;
+                TProxy<0,1,2,1> xyzy, rgbg, stpt;
+                TProxy<0,1,2,2> xyzz, rgbb, stpp;
+                TProxy<0,1,2,3> xyzw, rgba, stpq;
+                TProxy<0,1,3,0> xywx, rgar, stqs;
+                TProxy<0,1,3,1> xywy, rgag, stqt;
+                TProxy<0,1,3,2> xywz, rgab, stqp;
+                TProxy<0,1,3,3> xyww, rgaa, stqq;
+                TProxy<0,2,0,0> xzxx, rbrr, spss;
+                TProxy<0,2,0,1> xzxy, rbrg, spst;
+                TProxy<0,2,0,2> xzxz, rbrb, spsp;
+                TProxy<0,2,0,3> xzxw, rbra, spsq;
+                TProxy<0,2,1,0> xzyx, rbgr, spts;
+                TProxy<0,2,1,1> xzyy, rbgg, sptt;
+                TProxy<0,2,1,2> xzyz, rbgb, sptp;
+                TProxy<0,2,1,3> xzyw, rbga, sptq;
+                TProxy<0,2,2,0> xzzx, rbbr, spps;
+                TProxy<0,2,2,1> xzzy, rbbg, sppt;
+                TProxy<0,2,2,2> xzzz, rbbb, sppp;
+                TProxy<0,2,2,3> xzzw, rbba, sppq;
+                TProxy<0,2,3,0> xzwx, rbar, spqs;
+                TProxy<0,2,3,1> xzwy, rbag, spqt;
+                TProxy<0,2,3,2> xzwz, rbab, spqp;
+                TProxy<0,2,3,3> xzww, rbaa, spqq;
+                TProxy<0,3,0,0> xwxx, rarr, sqss;
+                TProxy<0,3,0,1> xwxy, rarg, sqst;
+                TProxy<0,3,0,2> xwxz, rarb, sqsp;
+                TProxy<0,3,0,3> xwxw, rara, sqsq;
+                TProxy<0,3,1,0> xwyx, ragr, sqts;
+                TProxy<0,3,1,1> xwyy, ragg, sqtt;
+                TProxy<0,3,1,2> xwyz, ragb, sqtp;
+                TProxy<0,3,1,3> xwyw, raga, sqtq;
+                TProxy<0,3,2,0> xwzx, rabr, sqps;
+                TProxy<0,3,2,1> xwzy, rabg, sqpt;
+                TProxy<0,3,2,2> xwzz, rabb, sqpp;
+                TProxy<0,3,2,3> xwzw, raba, sqpq;
+                TProxy<0,3,3,0> xwwx, raar, sqqs;
+                TProxy<0,3,3,1> xwwy, raag, sqqt;
+                TProxy<0,3,3,2> xwwz, raab, sqqp;
+                TProxy<0,3,3,3> xwww, raaa, sqqq;
+                TProxy<1,0,0,0> yxxx, grrr, tsss;
+                TProxy<1,0,0,1> yxxy, grrg, tsst;
+                TProxy<1,0,0,2> yxxz, grrb, tssp;
+                TProxy<1,0,0,3> yxxw, grra, tssq;
+                TProxy<1,0,1,0> yxyx, grgr, tsts;
+                TProxy<1,0,1,1> yxyy, grgg, tstt;
+                TProxy<1,0,1,2> yxyz, grgb, tstp;
+                TProxy<1,0,1,3> yxyw, grga, tstq;
+                TProxy<1,0,2,0> yxzx, grbr, tsps;
+                TProxy<1,0,2,1> yxzy, grbg, tspt;
+                TProxy<1,0,2,2> yxzz, grbb, tspp;
+                TProxy<1,0,2,3> yxzw, grba, tspq;
+                TProxy<1,0,3,0> yxwx, grar, tsqs;
+                TProxy<1,0,3,1> yxwy, grag, tsqt;
+                TProxy<1,0,3,2> yxwz, grab, tsqp;
+                TProxy<1,0,3,3> yxww, graa, tsqq;
+                TProxy<1,1,0,0> yyxx, ggrr, ttss;
+                TProxy<1,1,0,1> yyxy, ggrg, ttst;
+                TProxy<1,1,0,2> yyxz, ggrb, ttsp;
+                TProxy<1,1,0,3> yyxw, ggra, ttsq;
+                TProxy<1,1,1,0> yyyx, gggr, ttts;
+                TProxy<1,1,1,1> yyyy, gggg, tttt;
+                TProxy<1,1,1,2> yyyz, gggb, tttp;
+                TProxy<1,1,1,3> yyyw, ggga, tttq;
+                TProxy<1,1,2,0> yyzx, ggbr, ttps;
+                TProxy<1,1,2,1> yyzy, ggbg, ttpt;
+                TProxy<1,1,2,2> yyzz, ggbb, ttpp;
+                TProxy<1,1,2,3> yyzw, ggba, ttpq;
+                TProxy<1,1,3,0> yywx, ggar, ttqs;
+                TProxy<1,1,3,1> yywy, ggag, ttqt;
+                TProxy<1,1,3,2> yywz, ggab, ttqp;
+                TProxy<1,1,3,3> yyww, ggaa, ttqq;
+                TProxy<1,2,0,0> yzxx, gbrr, tpss;
+                TProxy<1,2,0,1> yzxy, gbrg, tpst;
+                TProxy<1,2,0,2> yzxz, gbrb, tpsp;
+                TProxy<1,2,0,3> yzxw, gbra, tpsq;
+                TProxy<1,2,1,0> yzyx, gbgr, tpts;
+                TProxy<1,2,1,1> yzyy, gbgg, tptt;
+                TProxy<1,2,1,2> yzyz, gbgb, tptp;
+                TProxy<1,2,1,3> yzyw, gbga, tptq;
+                TProxy<1,2,2,0> yzzx, gbbr, tpps;
+                TProxy<1,2,2,1> yzzy, gbbg, tppt;
+                TProxy<1,2,2,2> yzzz, gbbb, tppp;
+                TProxy<1,2,2,3> yzzw, gbba, tppq;
+                TProxy<1,2,3,0> yzwx, gbar, tpqs;
+                TProxy<1,2,3,1> yzwy, gbag, tpqt;
+                TProxy<1,2,3,2> yzwz, gbab, tpqp;
+                TProxy<1,2,3,3> yzww, gbaa, tpqq;
+                TProxy<1,3,0,0> ywxx, garr, tqss;
+                TProxy<1,3,0,1> ywxy, garg, tqst;
+                TProxy<1,3,0,2> ywxz, garb, tqsp;
+                TProxy<1,3,0,3> ywxw, gara, tqsq;
+                TProxy<1,3,1,0> ywyx, gagr, tqts;
+                TProxy<1,3,1,1> ywyy, gagg, tqtt;
+                TProxy<1,3,1,2> ywyz, gagb, tqtp;
+                TProxy<1,3,1,3> ywyw, gaga, tqtq;
+                TProxy<1,3,2,0> ywzx, gabr, tqps;
+                TProxy<1,3,2,1> ywzy, gabg, tqpt;
+                TProxy<1,3,2,2> ywzz, gabb, tqpp;
+                TProxy<1,3,2,3> ywzw, gaba, tqpq;
+                TProxy<1,3,3,0> ywwx, gaar, tqqs;
+                TProxy<1,3,3,1> ywwy, gaag, tqqt;
+                TProxy<1,3,3,2> ywwz, gaab, tqqp;
+                TProxy<1,3,3,3> ywww, gaaa, tqqq;
+                TProxy<2,0,0,0> zxxx, brrr, psss;
+                TProxy<2,0,0,1> zxxy, brrg, psst;
+                TProxy<2,0,0,2> zxxz, brrb, pssp;
+                TProxy<2,0,0,3> zxxw, brra, pssq;
+                TProxy<2,0,1,0> zxyx, brgr, psts;
+                TProxy<2,0,1,1> zxyy, brgg, pstt;
+                TProxy<2,0,1,2> zxyz, brgb, pstp;
+                TProxy<2,0,1,3> zxyw, brga, pstq;
+                TProxy<2,0,2,0> zxzx, brbr, psps;
+                TProxy<2,0,2,1> zxzy, brbg, pspt;
+                TProxy<2,0,2,2> zxzz, brbb, pspp;
+                TProxy<2,0,2,3> zxzw, brba, pspq;
+                TProxy<2,0,3,0> zxwx, brar, psqs;
+                TProxy<2,0,3,1> zxwy, brag, psqt;
+                TProxy<2,0,3,2> zxwz, brab, psqp;
+                TProxy<2,0,3,3> zxww, braa, psqq;
+                TProxy<2,1,0,0> zyxx, bgrr, ptss;
+                TProxy<2,1,0,1> zyxy, bgrg, ptst;
+                TProxy<2,1,0,2> zyxz, bgrb, ptsp;
+                TProxy<2,1,0,3> zyxw, bgra, ptsq;
+                TProxy<2,1,1,0> zyyx, bggr, ptts;
+                TProxy<2,1,1,1> zyyy, bggg, pttt;
+                TProxy<2,1,1,2> zyyz, bggb, pttp;
+                TProxy<2,1,1,3> zyyw, bgga, pttq;
+                TProxy<2,1,2,0> zyzx, bgbr, ptps;
+                TProxy<2,1,2,1> zyzy, bgbg, ptpt;
+                TProxy<2,1,2,2> zyzz, bgbb, ptpp;
+                TProxy<2,1,2,3> zyzw, bgba, ptpq;
+                TProxy<2,1,3,0> zywx, bgar, ptqs;
+                TProxy<2,1,3,1> zywy, bgag, ptqt;
+                TProxy<2,1,3,2> zywz, bgab, ptqp;
+                TProxy<2,1,3,3> zyww, bgaa, ptqq;
+                TProxy<2,2,0,0> zzxx, bbrr, ppss;
+                TProxy<2,2,0,1> zzxy, bbrg, ppst;
+                TProxy<2,2,0,2> zzxz, bbrb, ppsp;
+                TProxy<2,2,0,3> zzxw, bbra, ppsq;
+                TProxy<2,2,1,0> zzyx, bbgr, ppts;
+                TProxy<2,2,1,1> zzyy, bbgg, pptt;
+                TProxy<2,2,1,2> zzyz, bbgb, pptp;
+                TProxy<2,2,1,3> zzyw, bbga, pptq;
+                TProxy<2,2,2,0> zzzx, bbbr, ppps;
+                TProxy<2,2,2,1> zzzy, bbbg, pppt;
+                TProxy<2,2,2,2> zzzz, bbbb, pppp;
+                TProxy<2,2,2,3> zzzw, bbba, pppq;
+                TProxy<2,2,3,0> zzwx, bbar, ppqs;
+                TProxy<2,2,3,1> zzwy, bbag, ppqt;
+                TProxy<2,2,3,2> zzwz, bbab, ppqp;
+                TProxy<2,2,3,3> zzww, bbaa, ppqq;
+                TProxy<2,3,0,0> zwxx, barr, pqss;
+                TProxy<2,3,0,1> zwxy, barg, pqst;
+                TProxy<2,3,0,2> zwxz, barb, pqsp;
+                TProxy<2,3,0,3> zwxw, bara, pqsq;
+                TProxy<2,3,1,0> zwyx, bagr, pqts;
+                TProxy<2,3,1,1> zwyy, bagg, pqtt;
+                TProxy<2,3,1,2> zwyz, bagb, pqtp;
+                TProxy<2,3,1,3> zwyw, baga, pqtq;
+                TProxy<2,3,2,0> zwzx, babr, pqps;
+                TProxy<2,3,2,1> zwzy, babg, pqpt;
+                TProxy<2,3,2,2> zwzz, babb, pqpp;
+                TProxy<2,3,2,3> zwzw, baba, pqpq;
+                TProxy<2,3,3,0> zwwx, baar, pqqs;
+                TProxy<2,3,3,1> zwwy, baag, pqqt;
+                TProxy<2,3,3,2> zwwz, baab, pqqp;
+                TProxy<2,3,3,3> zwww, baaa, pqqq;
+                TProxy<3,0,0,0> wxxx, arrr, qsss;
+                TProxy<3,0,0,1> wxxy, arrg, qsst;
+                TProxy<3,0,0,2> wxxz, arrb, qssp;
+                TProxy<3,0,0,3> wxxw, arra, qssq;
+                TProxy<3,0,1,0> wxyx, argr, qsts;
+                TProxy<3,0,1,1> wxyy, argg, qstt;
+                TProxy<3,0,1,2> wxyz, argb, qstp;
+                TProxy<3,0,1,3> wxyw, arga, qstq;
+                TProxy<3,0,2,0> wxzx, arbr, qsps;
+                TProxy<3,0,2,1> wxzy, arbg, qspt;
+                TProxy<3,0,2,2> wxzz, arbb, qspp;
+                TProxy<3,0,2,3> wxzw, arba, qspq;
+                TProxy<3,0,3,0> wxwx, arar, qsqs;
+                TProxy<3,0,3,1> wxwy, arag, qsqt;
+                TProxy<3,0,3,2> wxwz, arab, qsqp;
+                TProxy<3,0,3,3> wxww, araa, qsqq;
+                TProxy<3,1,0,0> wyxx, agrr, qtss;
+                TProxy<3,1,0,1> wyxy, agrg, qtst;
+                TProxy<3,1,0,2> wyxz, agrb, qtsp;
+                TProxy<3,1,0,3> wyxw, agra, qtsq;
+                TProxy<3,1,1,0> wyyx, aggr, qtts;
+                TProxy<3,1,1,1> wyyy, aggg, qttt;
+                TProxy<3,1,1,2> wyyz, aggb, qttp;
+                TProxy<3,1,1,3> wyyw, agga, qttq;
+                TProxy<3,1,2,0> wyzx, agbr, qtps;
+                TProxy<3,1,2,1> wyzy, agbg, qtpt;
+                TProxy<3,1,2,2> wyzz, agbb, qtpp;
+                TProxy<3,1,2,3> wyzw, agba, qtpq;
+                TProxy<3,1,3,0> wywx, agar, qtqs;
+                TProxy<3,1,3,1> wywy, agag, qtqt;
+                TProxy<3,1,3,2> wywz, agab, qtqp;
+                TProxy<3,1,3,3> wyww, agaa, qtqq;
+                TProxy<3,2,0,0> wzxx, abrr, qpss;
+                TProxy<3,2,0,1> wzxy, abrg, qpst;
+                TProxy<3,2,0,2> wzxz, abrb, qpsp;
+                TProxy<3,2,0,3> wzxw, abra, qpsq;
+                TProxy<3,2,1,0> wzyx, abgr, qpts;
+                TProxy<3,2,1,1> wzyy, abgg, qptt;
+                TProxy<3,2,1,2> wzyz, abgb, qptp;
+                TProxy<3,2,1,3> wzyw, abga, qptq;
+                TProxy<3,2,2,0> wzzx, abbr, qpps;
+                TProxy<3,2,2,1> wzzy, abbg, qppt;
+                TProxy<3,2,2,2> wzzz, abbb, qppp;
+                TProxy<3,2,2,3> wzzw, abba, qppq;
+                TProxy<3,2,3,0> wzwx, abar, qpqs;
+                TProxy<3,2,3,1> wzwy, abag, qpqt;
+                TProxy<3,2,3,2> wzwz, abab, qpqp;
+                TProxy<3,2,3,3> wzww, abaa, qpqq;
+                TProxy<3,3,0,0> wwxx, aarr, qqss;
+                TProxy<3,3,0,1> wwxy, aarg, qqst;
+                TProxy<3,3,0,2> wwxz, aarb, qqsp;
+                TProxy<3,3,0,3> wwxw, aara, qqsq;
+                TProxy<3,3,1,0> wwyx, aagr, qqts;
+                TProxy<3,3,1,1> wwyy, aagg, qqtt;
+                TProxy<3,3,1,2> wwyz, aagb, qqtp;
+                TProxy<3,3,1,3> wwyw, aaga, qqtq;
+                TProxy<3,3,2,0> wwzx, aabr, qqps;
+                TProxy<3,3,2,1> wwzy, aabg, qqpt;
+                TProxy<3,3,2,2> wwzz, aabb, qqpp;
+                TProxy<3,3,2,3> wwzw, aaba, qqpq;
+                TProxy<3,3,3,0> wwwx, aaar, qqqs;
+                TProxy<3,3,3,1> wwwy, aaag, qqqt;
+                TProxy<3,3,3,2> wwwz, aaab, qqqp;
+                TProxy<3,3,3,3> wwww, aaaa, qqqq;
             };
+
+            constexpr vector_base()
+                : m_data()
+            {}
+
+            constexpr vector_base(const TData& data)
+                : m_data(data)
+            {}
         };
     }
 }
\ No newline at end of file
@@ -15,6 +15,13 @@ namespace swizzle
         struct get_vector_type_impl
         {};
 
+        //! Type to specialise for scalar types that can be reinterpreted bitwise (floatBitsToInt & co.);
+        //! it should define nested int_type, uint_type and float_type, all of them same size as T.
+        //! Non-specialised version does not define them, failing any function relying on it.
+        template <class T>
+        struct bits_traits
+        {};
+
         //! Used for graceful SFINAE - becomes true_type if get_vector_type_impl defines nested type.
         template <class T>
         struct has_vector_type_impl : std::integral_constant<bool, has_type< get_vector_type_impl< typename remove_reference_cv<T>::type > >::value >
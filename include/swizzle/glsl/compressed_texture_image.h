@@ -0,0 +1,248 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <swizzle/detail/bc7_decoder.h>
+#include <swizzle/detail/block_cache.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Block compression formats; all of them encode 4x4 texel blocks.
+        enum class compressed_format
+        {
+            //! 8 bytes per block: two RGB565 endpoints and 2 bit indices; 1 bit alpha.
+            bc1,
+            //! 8 bytes per block: two 8 bit endpoints and 3 bit indices; sampled as (r, 0, 0, 1).
+            bc4,
+            //! 16 bytes per block: RGBA with 8 modes, up to 3 partitions.
+            bc7
+        };
+
+        //! A 2D texture kept block-compressed, i.e. 4-8 times smaller than a decoded one, for samplers that decode
+        //! just the texels they touch (see compressed_texture_sampler.h). Blocks are expected to be laid out
+        //! the way DDS and KTX files have them: level after level, row of blocks after row of blocks, top-down.
+        //! Samplers flip rows, so that texel (0, 0) is the bottom-left one like with texture_image.
+        class compressed_texture_image
+        {
+        public:
+            //! Blocks are read in 32 bit words.
+            typedef unsigned word_type;
+            //! A packed RGBA8 texel.
+            typedef uint32_t texel_type;
+
+            static const unsigned block_size = 4;
+
+            struct level_info
+            {
+                unsigned width;
+                unsigned height;
+                //! In blocks, from data().
+                size_t offset;
+                //! Blocks per row.
+                unsigned pitch;
+            };
+
+            compressed_texture_image()
+                : m_format(compressed_format::bc1)
+                , m_id(detail::next_block_cache_owner())
+            {}
+
+            //! Takes size bytes of blocks of the given number of levels (each half the size of the previous one).
+            compressed_texture_image(compressed_format format, unsigned width, unsigned height, unsigned levels, const void* blocks, size_t size)
+                : m_format(format)
+                , m_id(detail::next_block_cache_owner())
+            {
+                size_t count = 0;
+                for (unsigned i = 0; i < levels; ++i)
+                {
+                    level_info level = { std::max(width >> i, 1u), std::max(height >> i, 1u), count, 0 };
+                    level.pitch = (level.width + block_size - 1) / block_size;
+                    count += static_cast<size_t>(level.pitch) * ((level.height + block_size - 1) / block_size);
+                    m_levels.push_back(level);
+                }
+
+                if (!width || !height || !levels || size != count * block_bytes())
+                {
+                    throw std::invalid_argument("Block count does not match texture size");
+                }
+
+                // with an extra word, so that unaligned SIMD loads never go past the end
+                m_words.resize(size / sizeof(word_type) + 1);
+                std::memcpy(m_words.data(), blocks, size);
+            }
+
+            compressed_format format() const
+            {
+                return m_format;
+            }
+
+            unsigned width(unsigned level = 0) const
+            {
+                return m_levels[level].width;
+            }
+
+            unsigned height(unsigned level = 0) const
+            {
+                return m_levels[level].height;
+            }
+
+            //! Number of levels, 0 for empty images.
+            unsigned levels() const
+            {
+                return static_cast<unsigned>(m_levels.size());
+            }
+
+            const level_info& level(unsigned level) const
+            {
+                return m_levels[level];
+            }
+
+            bool empty() const
+            {
+                return m_levels.empty();
+            }
+
+            //! Blocks of all the levels, one after another.
+            const word_type* data() const
+            {
+                return m_words.data();
+            }
+
+            size_t block_bytes() const
+            {
+                return m_format == compressed_format::bc7 ? 16 : 8;
+            }
+
+            //! The decoded texel as packed RGBA8; slow, meant for tests and tools.
+            texel_type texel(unsigned x, unsigned y, unsigned level = 0) const
+            {
+                const level_info& info = m_levels[level];
+                unsigned row = info.height - 1 - y;
+                texel_type texels[16];
+                decode_block(info.offset + static_cast<size_t>(row / block_size) * info.pitch + x / block_size, texels);
+                return texels[(row % block_size) * block_size + x % block_size];
+            }
+
+            //! Decodes a whole block, rows top-down.
+            void decode_block(size_t block, texel_type texels[16]) const
+            {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(m_words.data()) + block * block_bytes();
+                switch (m_format)
+                {
+                case compressed_format::bc1:
+                    decode_bc1(bytes, texels);
+                    break;
+                case compressed_format::bc4:
+                    decode_bc4(bytes, texels);
+                    break;
+                case compressed_format::bc7:
+                default:
+                    detail::bc7_decoder::decode(bytes, texels);
+                    break;
+                }
+            }
+
+            //! A texel of a block (0-15, top-down), going through the per-thread cache of decoded blocks.
+            texel_type cached_texel(size_t block, unsigned texel) const
+            {
+                const compressed_texture_image* image = this;
+                return block_cache::lookup(m_id, block, [image](size_t block, texel_type* texels) { image->decode_block(block, texels); })[texel];
+            }
+
+            //! Hits and misses of cached_texel calls of the calling thread.
+            static detail::block_cache_stats& cache_stats()
+            {
+                return block_cache::stats();
+            }
+
+        private:
+            typedef detail::block_cache<texel_type, 64> block_cache;
+
+            static texel_type expand565(unsigned color)
+            {
+                unsigned r = (color >> 11) & 31u, g = (color >> 5) & 63u, b = color & 31u;
+                return ((r << 3) | (r >> 2)) | (((g << 2) | (g >> 4)) << 8) | (((b << 3) | (b >> 2)) << 16) | 0xff000000u;
+            }
+
+            //! Per channel (a * wa + b * wb) / (wa + wb), rounded.
+            static texel_type blend(texel_type a, texel_type b, unsigned wa, unsigned wb)
+            {
+                texel_type result = 0;
+                for (unsigned shift = 0; shift < 32; shift += 8)
+                {
+                    unsigned value = (((a >> shift) & 0xffu) * wa + ((b >> shift) & 0xffu) * wb + (wa + wb) / 2) / (wa + wb);
+                    result |= value << shift;
+                }
+                return result;
+            }
+
+            static void decode_bc1(const uint8_t* block, texel_type texels[16])
+            {
+                unsigned c0 = block[0] | (block[1] << 8);
+                unsigned c1 = block[2] | (block[3] << 8);
+                texel_type colors[4] = { expand565(c0), expand565(c1) };
+                if (c0 > c1)
+                {
+                    colors[2] = blend(colors[0], colors[1], 2, 1);
+                    colors[3] = blend(colors[0], colors[1], 1, 2);
+                }
+                else
+                {
+                    colors[2] = blend(colors[0], colors[1], 1, 1);
+                    colors[3] = 0;
+                }
+
+                for (unsigned i = 0; i < 16; ++i)
+                {
+                    texels[i] = colors[(block[4 + i / 4] >> ((i % 4) * 2)) & 3u];
+                }
+            }
+
+            static void decode_bc4(const uint8_t* block, texel_type texels[16])
+            {
+                unsigned r0 = block[0], r1 = block[1];
+                unsigned values[8] = { r0, r1 };
+                if (r0 > r1)
+                {
+                    for (unsigned i = 2; i < 8; ++i)
+                    {
+                        values[i] = ((8 - i) * r0 + (i - 1) * r1 + 3) / 7;
+                    }
+                }
+                else
+                {
+                    for (unsigned i = 2; i < 6; ++i)
+                    {
+                        values[i] = ((6 - i) * r0 + (i - 1) * r1 + 2) / 5;
+                    }
+                    values[6] = 0;
+                    values[7] = 255;
+                }
+
+                uint64_t indices = 0;
+                for (unsigned i = 0; i < 6; ++i)
+                {
+                    indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+                }
+                for (unsigned i = 0; i < 16; ++i)
+                {
+                    texels[i] = values[(indices >> (i * 3)) & 7u] | 0xff000000u;
+                }
+            }
+
+            compressed_format m_format;
+            //! Identifies blocks in the cache.
+            unsigned m_id;
+            std::vector<level_info> m_levels;
+            std::vector<word_type> m_words;
+        };
+    }
+}
@@ -0,0 +1,147 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <swizzle/glsl/texture_sampler.h>
+#include <swizzle/glsl/compressed_texture_image.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Decodes just the texels that get sampled. BC1 and BC4 are decoded for all the lanes at once: a lane
+        //! gathers its block's endpoints and index bits and then it is all vector math. BC7 has modes and
+        //! partitions that differ from lane to lane, so each lane looks its block up in the per-thread cache of
+        //! decoded blocks (see compressed_texture_image::cached_texel); bilinear footprints rarely leave a block,
+        //! so hits are the norm. With caching enabled BC1 and BC4 go through the cache too.
+        template <class FloatType>
+        class texel_fetcher<compressed_texture_image, FloatType>
+        {
+        public:
+            typedef FloatType float_type;
+            typedef typename detail::bits_traits<FloatType>::uint_type uint_type;
+            typedef vector<FloatType, 3> vec3_type;
+            typedef vector<FloatType, 4> vec4_type;
+
+            explicit texel_fetcher(const compressed_texture_image& image)
+                : m_image(&image)
+                , m_format(image.format())
+                , m_cached(false)
+            {
+                // addresses are 32 bit; cached texels are addressed in sixteenths of a block
+                if (!image.empty() && image.level(image.levels() - 1).offset >= 0x0fffffffu)
+                {
+                    throw std::invalid_argument("Texture is too large to be sampled");
+                }
+            }
+
+            bool single_channel() const
+            {
+                return m_format == compressed_format::bc4;
+            }
+
+            void set_cached(bool cached)
+            {
+                m_cached = cached;
+            }
+
+            template <class Texel>
+            Texel fetch(const uint_type& offset, const uint_type& pitch, const float_type& height, const float_type& x, const float_type& y) const
+            {
+                using namespace std;
+
+                const float size = static_cast<float>(compressed_texture_image::block_size);
+
+                // blocks go top-down
+                float_type row = height - 1.0f - y;
+                float_type block_x = floor(x * (1.0f / size));
+                float_type block_y = floor(row * (1.0f / size));
+                float_type texel = mad(row - block_y * size, float_type(size), x - block_x * size);
+                return decode(offset + floatToUint(block_y) * pitch + floatToUint(block_x), texel, static_cast<Texel*>(nullptr));
+            }
+
+        private:
+            //! Weight of the second endpoint: indices 0 and 1 are the endpoints, the following ones are spread
+            //! evenly in between (divisions being the number of steps between endpoints).
+            static float_type endpoint_weight(const float_type& index, const float_type& divisions)
+            {
+                using namespace std;
+                float_type second = step(0.5f, index) - step(1.5f, index);
+                return max(index - 1.0f, float_type(0.0f)) / divisions + second;
+            }
+
+            //! Channel of bits width at offset, expanded to 8 bits by replication and normalised.
+            static float_type expand(const uint_type& value, unsigned offset, unsigned bits)
+            {
+                using namespace std;
+                float_type channel = uintToFloat(bitfieldExtract(value, offset, bits));
+                return (channel * static_cast<float>(1u << (8 - bits)) + floor(channel * (1.0f / static_cast<float>(1u << (2 * bits - 8))))) * (1.0f / 255.0f);
+            }
+
+            uint_type cached_texels(const uint_type& block, const float_type& texel) const
+            {
+                using namespace std;
+                const compressed_texture_image* image = m_image;
+                return gatherWith([image](unsigned i) { return image->cached_texel(i / 16, i % 16); }, block * 16u + floatToUint(texel));
+            }
+
+            float_type decode(const uint_type& block, const float_type& texel, float_type*) const
+            {
+                using namespace std;
+
+                if (m_cached)
+                {
+                    return unpackUnorm4x8(cached_texels(block, texel), 0);
+                }
+
+                // two endpoints, then 3 bit indices; 8 of them take 3 bytes
+                uint_type first = block * 8u;
+                uint_type endpoints = gatherByte(m_image->data(), first);
+                float_type half = step(8.0f, texel);
+                uint_type bits = gatherByte(m_image->data(), first + floatToUint(mad(half, float_type(3.0f), float_type(2.0f))));
+                float_type index = uintToFloat(bitfieldExtract(bits, floatToUint((texel - half * 8.0f) * 3.0f), 3));
+
+                float_type r0 = uintToFloat(bitfieldExtract(endpoints, 0, 8));
+                float_type r1 = uintToFloat(bitfieldExtract(endpoints, 8, 8));
+                // r0 > r1: 6 values in between, otherwise 4 plus 0 and 1
+                float_type eight = step(r1 + 0.5f, r0);
+                float_type value = (r0 + (r1 - r0) * endpoint_weight(index, 5.0f + eight * 2.0f)) * (1.0f / 255.0f);
+                float_type extreme = step(5.5f, index) * (1.0f - eight);
+                return value + (index - 6.0f - value) * extreme;
+            }
+
+            vec4_type decode(const uint_type& block, const float_type& texel, vec4_type*) const
+            {
+                using namespace std;
+
+                if (m_cached || m_format != compressed_format::bc1)
+                {
+                    uint_type rgba = cached_texels(block, texel);
+                    return vec4_type(unpackUnorm4x8(rgba, 0), unpackUnorm4x8(rgba, 1), unpackUnorm4x8(rgba, 2), unpackUnorm4x8(rgba, 3));
+                }
+
+                // two RGB565 endpoints, then 2 bit indices
+                uint_type first = block * 2u;
+                uint_type endpoints = gather(m_image->data(), first);
+                uint_type bits = gather(m_image->data(), first + 1u);
+                float_type index = uintToFloat(bitfieldExtract(bits, floatToUint(texel * 2.0f), 2));
+
+                vec3_type c0(expand(endpoints, 11, 5), expand(endpoints, 5, 6), expand(endpoints, 0, 5));
+                vec3_type c1(expand(endpoints, 27, 5), expand(endpoints, 21, 6), expand(endpoints, 16, 5));
+                // c0 > c1: 2 colours in between, otherwise 1 plus transparent black
+                float_type four = step(uintToFloat(bitfieldExtract(endpoints, 16, 16)) + 0.5f, uintToFloat(bitfieldExtract(endpoints, 0, 16)));
+                float_type opaque = 1.0f - step(2.5f, index) * (1.0f - four);
+                vec3_type color = (c0 + (c1 - c0) * endpoint_weight(index, 2.0f + four)) * opaque;
+                return vec4_type(color, opaque);
+            }
+
+            const compressed_texture_image* m_image;
+            compressed_format m_format;
+            bool m_cached;
+        };
+
+        //! Samples compressed_texture_image, decoding on the fly.
+        template <class FloatType>
+        using basic_compressed_sampler2D = basic_sampler2D<FloatType, compressed_texture_image>;
+    }
+}
@@ -0,0 +1,128 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+//
+// Explicit instantiations of what every translation unit with shaders would otherwise instantiate (and
+// compile, if not inlined) again: functions behind the builtins for vectors of 1 to 4 components, matrix
+// functions of mat2 to mat4 and samplers, all for a given float type. Put
+//   CXXSWIZZLE_EXTERN_TEMPLATES(float_type)
+// at global scope of the header setting shader types up and
+//   CXXSWIZZLE_INSTANTIATE_TEMPLATES(float_type)
+// in a single translation unit including that header, e.g. of a static library; everything including the
+// header then needs to link with it.
+//
+// Compilers still instantiate inline functions declared extern when optimising, to be able to inline
+// them, so builds without optimisations gain the most. Whole vectors and matrices can't be instantiated:
+// their members that do not apply to some sizes or scalar types are declared with placeholder types and are
+// ill-formed once instantiated. Hence functions are listed one by one; friend operators (of
+// common_binary_operators and primitive_wrapper) can't be instantiated explicitly at all.
+#pragma once
+
+#include <swizzle/glsl/vector.h>
+#include <swizzle/glsl/matrix.h>
+#include <swizzle/glsl/texture_sampler.h>
+
+#define CXXSWIZZLE_DETAIL_VECTOR_OF(T, N) swizzle::glsl::vector<T, N>
+#define CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N) CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_functions_adapter
+#define CXXSWIZZLE_DETAIL_MATRIX_OF(T, N) swizzle::glsl::matrix<swizzle::glsl::vector, T, N, N>
+
+// Function shapes, as in vector_functions_adapter.h: V is a vector argument, S a scalar one.
+#define CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_VS(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_SV(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_VVV(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_VVS(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_VSS(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_SSV(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type);
+#define CXXSWIZZLE_DETAIL_INSTANCE_VSV(prefix, T, N, result, name) \
+    prefix template CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::result CXXSWIZZLE_DETAIL_FUNCTIONS_OF(T, N)::call_##name(CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::scalar_arg_type, CXXSWIZZLE_DETAIL_VECTOR_OF(T, N)::vector_arg_type);
+
+//! Functions of vectors of N components that every size has.
+#define CXXSWIZZLE_DETAIL_VECTOR_INSTANCES(prefix, T, N) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, radians) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, degrees) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, sin) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, cos) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, tan) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, asin) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, acos) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, atan) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, atan) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, abs) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, pow) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VS(prefix, T, N, vector_type, pow) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, exp) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, log) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, exp2) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, log2) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, sqrt) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, inversesqrt) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, sign) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, fract) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, floor) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, ceil) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, trunc) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, round) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, roundEven) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, mod) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VS(prefix, T, N, vector_type, mod) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, min) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VS(prefix, T, N, vector_type, min) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, max) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VS(prefix, T, N, vector_type, max) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVV(prefix, T, N, vector_type, clamp) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VSS(prefix, T, N, vector_type, clamp) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVV(prefix, T, N, vector_type, mix) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVS(prefix, T, N, vector_type, mix) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVV(prefix, T, N, vector_type, fma) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, step) \
+    CXXSWIZZLE_DETAIL_INSTANCE_SV(prefix, T, N, vector_type, step) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVV(prefix, T, N, vector_type, smoothstep) \
+    CXXSWIZZLE_DETAIL_INSTANCE_SSV(prefix, T, N, vector_type, smoothstep) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VS(prefix, T, N, vector_type, mul) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VSV(prefix, T, N, vector_type, mad) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, vector_type, reflect) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVS(prefix, T, N, vector_type, refract) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VVV(prefix, T, N, vector_type, faceforward) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, scalar_type, length) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, scalar_type, distance) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, N, scalar_type, dot) \
+    CXXSWIZZLE_DETAIL_INSTANCE_V(prefix, T, N, vector_type, normalize)
+
+//! Functions of square matrices of N columns.
+#define CXXSWIZZLE_DETAIL_MATRIX_INSTANCES(prefix, T, N) \
+    prefix template CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::column_type CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::mul(const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&, const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::row_type&); \
+    prefix template CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::row_type CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::mul(const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::column_type&, const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&); \
+    prefix template CXXSWIZZLE_DETAIL_MATRIX_OF(T, N) CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::mul<N>(const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&, const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&); \
+    prefix template CXXSWIZZLE_DETAIL_MATRIX_OF(T, N) CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::call_transpose(const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&); \
+    prefix template CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::scalar_type CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::call_determinant(const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&); \
+    prefix template CXXSWIZZLE_DETAIL_MATRIX_OF(T, N) CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)::call_inverse(const CXXSWIZZLE_DETAIL_MATRIX_OF(T, N)&);
+
+#define CXXSWIZZLE_DETAIL_TEMPLATE_INSTANCES(prefix, T) \
+    CXXSWIZZLE_DETAIL_VECTOR_INSTANCES(prefix, T, 1) \
+    CXXSWIZZLE_DETAIL_VECTOR_INSTANCES(prefix, T, 2) \
+    CXXSWIZZLE_DETAIL_VECTOR_INSTANCES(prefix, T, 3) \
+    CXXSWIZZLE_DETAIL_VECTOR_INSTANCES(prefix, T, 4) \
+    CXXSWIZZLE_DETAIL_INSTANCE_VV(prefix, T, 3, vector_type, cross) \
+    CXXSWIZZLE_DETAIL_MATRIX_INSTANCES(prefix, T, 2) \
+    CXXSWIZZLE_DETAIL_MATRIX_INSTANCES(prefix, T, 3) \
+    CXXSWIZZLE_DETAIL_MATRIX_INSTANCES(prefix, T, 4) \
+    prefix template class swizzle::glsl::texel_fetcher<swizzle::glsl::texture_image, T>; \
+    prefix template class swizzle::glsl::basic_sampler_base<T, swizzle::glsl::texture_image>; \
+    prefix template class swizzle::glsl::basic_sampler2D<T>; \
+    prefix template class swizzle::glsl::basic_sampler3D<T>; \
+    prefix template class swizzle::glsl::basic_samplerCube<T>;
+
+//! Declares the instances for the float type T; they must be defined with CXXSWIZZLE_INSTANTIATE_TEMPLATES.
+#define CXXSWIZZLE_EXTERN_TEMPLATES(T) CXXSWIZZLE_DETAIL_TEMPLATE_INSTANCES(extern, T)
+
+//! Defines the instances for the float type T.
+#define CXXSWIZZLE_INSTANTIATE_TEMPLATES(T) CXXSWIZZLE_DETAIL_TEMPLATE_INSTANCES(, T)
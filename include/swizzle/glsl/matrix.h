@@ -29,18 +29,29 @@ namespace swizzle
             static const size_t n_dimension = N;
             static const size_t m_dimension = M;
 
+        private:
+            typedef std::array<scalar_type, N * M> cells_type;
+
+            template <class... T>
+            struct is_constant_initialisable : std::integral_constant<bool,
+                sizeof...(T) == N * M && std::is_arithmetic<scalar_type>::value && detail::are_arithmetic<T...>::value>
+            {};
+
         // CONSTRUCTION
         public:
 
             //! Default zeroing constructor.
-            matrix()
+            constexpr matrix()
+                : m_data()
             {}
 
             //! Copying constructor
-            matrix(const matrix& other)
-            {
-                m_data = other.m_data;
-            }
+            constexpr matrix(const matrix& other)
+                : m_data(other.m_data)
+            {}
+
+            //! Copying assignment; declared since the copying constructor is.
+            matrix& operator=(const matrix&) = default;
 
             //! Constructor for matrices smaller than current one
             template <size_t OtherM, size_t OtherN>
@@ -66,16 +77,22 @@ namespace swizzle
             }
 
             //! Init with s diagonally
-            matrix(const scalar_type& s)
-            {
-                const size_t min_dim = N > M ? M : N;
-                detail::static_for<0, min_dim>([&](size_t i) -> void { m_data[i][i] = s; });
-            }
+            constexpr matrix(const scalar_type& s)
+                : matrix(s, detail::make_index_sequence<M>())
+            {}
+
+            //! Constructor from N*M arithmetic values (column by column); it's constexpr, so that constant
+            //! matrices are folded at compile time.
+            template <class... T, class = typename std::enable_if<is_constant_initialisable<T...>::value>::type>
+            constexpr explicit matrix(T... ts)
+                : matrix(detail::make_index_sequence<M>(), cells_type{ { static_cast<scalar_type>(ts)... } })
+            {}
 
             template <class T0, class... T,
                 class = typename std::enable_if< 
                     !(N*M <= detail::get_total_size<T0, T...>::value - detail::get_total_size<typename detail::last<T0, T...>::type >::value) &&
-                    (N*M <= detail::get_total_size<T0, T...>::value),
+                    (N*M <= detail::get_total_size<T0, T...>::value) &&
+                    !is_constant_initialisable<T0, T...>::value,
                     void>::type 
                 >
             explicit matrix(T0&& t0, T&&... ts)
@@ -93,7 +110,7 @@ namespace swizzle
             }
 
             //! Row accessor.
-            const column_type& operator[](size_t i) const
+            constexpr const column_type& operator[](size_t i) const
             {
                 return m_data[i];
             }
@@ -178,6 +195,46 @@ namespace swizzle
                 return mul(col, m);
             }
 
+            // Functions; these are friends, so that they are found with ADL the same way
+            // vector_functions.h functions are.
+
+            friend matrix<VectorType, ScalarType, M, N> transpose(const matrix& m)
+            {
+                return m.call_transpose(m);
+            }
+
+            friend scalar_type determinant(const matrix& m)
+            {
+                return m.call_determinant(m);
+            }
+
+            friend matrix inverse(const matrix& m)
+            {
+                return m.call_inverse(m);
+            }
+
+            // Non-GLSL extensions for hot paths.
+
+            //! transpose(m) * v without creating the transposed matrix; for rotations this is the
+            //! inverse transform.
+            friend row_type transpose_mul(const matrix& m, const column_type& v)
+            {
+                return mul(v, m);
+            }
+
+            //! transpose(m1) * m2
+            template <size_t OtherM>
+            friend matrix<VectorType, ScalarType, M, OtherM> transpose_mul(const matrix& m1, const matrix<VectorType, ScalarType, N, OtherM>& m2)
+            {
+                return mul_transposed(m1, m2);
+            }
+
+            //! m * vec(p, 1) for Nx(N+1) matrices, e.g. mat3x4 * vec3.
+            friend column_type transform_point(const matrix& m, const VectorType<ScalarType, M - 1>& p)
+            {
+                return mul_affine(m, p);
+            }
+
         // UTILITY FUNCTIONS
         public:
 
@@ -208,25 +265,30 @@ namespace swizzle
                 return m_data[col][row];
             }
 
-            const scalar_type& cell(size_t row, size_t col) const
+            constexpr const scalar_type& cell(size_t row, size_t col) const
             {
                 return m_data[col][row];
             }
 
-            //! Matrix-vector multiplication.
-            static column_type mul(const matrix_type& m, const row_type& v)
+            //! For CxxSwizzle ADL-magic
+            matrix decay() const
             {
-                column_type result;
+                return *this;
+            }
 
-                detail::static_for<0, N>([&](size_t row) -> void
+            //! Matrix-vector multiplication. Columns are scaled by v's components and accumulated,
+            //! so there are no row gathers; each step is a single mad per component.
+            static column_type mul(const matrix_type& m, const row_type& v)
+            {
+                column_type result = column_type::call_mul(m[0], v[0]);
+                detail::static_for<1, M>([&](size_t col) -> void
                 {
-                    result[row] = v.call_dot(v, m.row(row));
+                    result = column_type::call_mad(m[col], v[col], result);
                 });
-
                 return result;
             }
 
-            //! Matrix-matrix multiplication.
+            //! Matrix-matrix multiplication; every column of the result is m1 * m2.column(col).
             template <size_t OtherM>
             static matrix<VectorType, ScalarType, N, OtherM> mul(const matrix_type& m1, const matrix<VectorType, ScalarType, M, OtherM>& m2)
             {
@@ -234,13 +296,14 @@ namespace swizzle
 
                 detail::static_for<0, OtherM>([&](size_t col) -> void
                 {
-                    result.column(col) = m1 * m2.column(col);
+                    result.column(col) = mul(m1, m2.column(col));
                 });
 
                 return result;
             }
 
-            //! Matrix-vector multiplication.
+            //! Vector-matrix multiplication. Same as transpose(m) * v: every component is a dot
+            //! with a column, which is contiguous already.
             static row_type mul(const column_type& v, const matrix& m)
             {
                 row_type result;
@@ -253,8 +316,185 @@ namespace swizzle
                 return result;
             }
 
+            //! transpose(m1) * m2 without creating the transposed matrix.
+            template <size_t OtherM>
+            static matrix<VectorType, ScalarType, M, OtherM> mul_transposed(const matrix_type& m1, const matrix<VectorType, ScalarType, N, OtherM>& m2)
+            {
+                matrix<VectorType, ScalarType, M, OtherM> result;
+
+                detail::static_for<0, OtherM>([&](size_t col) -> void
+                {
+                    result.column(col) = mul(m2.column(col), m1);
+                });
+
+                return result;
+            }
+
+            //! Affine transform of a point: the last column is a translation and the point's missing
+            //! coordinate is assumed to be 1, e.g. mat3x4 * vec3 is mat4 * vec4(p, 1) without the last row.
+            static column_type mul_affine(const matrix_type& m, const VectorType<ScalarType, M - 1>& p)
+            {
+                static_assert(M == N + 1, "Affine transform needs NxN+1 matrix");
+                column_type result = m[M - 1];
+                detail::static_for<0, M - 1>([&](size_t col) -> void
+                {
+                    result = column_type::call_mad(m[col], p[col], result);
+                });
+                return result;
+            }
+
+            static matrix<VectorType, ScalarType, M, N> call_transpose(const matrix_type& m)
+            {
+                matrix<VectorType, ScalarType, M, N> result;
+                detail::static_for<0, N>([&](size_t row) -> void
+                {
+                    detail::static_for<0, M>([&](size_t col) -> void { result.cell(col, row) = m.cell(row, col); });
+                });
+                return result;
+            }
+
+            //! Determinant and inverse use plain cofactor expansion; no pivoting means no branches,
+            //! so for SIMD scalar types each lane simply gets its own matrix inverted.
+            static scalar_type call_determinant(const matrix_type& m)
+            {
+                static_assert(N == M, "Determinant is only defined for square matrices");
+                return determinant(m, std::integral_constant<size_t, N>());
+            }
+
+            //! For singular matrices the result is undefined, just like in GLSL.
+            static matrix_type call_inverse(const matrix_type& m)
+            {
+                static_assert(N == M, "Inverse is only defined for square matrices");
+                return inverse(m, std::integral_constant<size_t, N>());
+            }
+
         private:
 
+            template <size_t... Col>
+            constexpr matrix(const scalar_type& s, detail::index_sequence<Col...>)
+                : m_data{ { diagonal_column(s, Col, detail::make_index_sequence<N>())... } }
+            {}
+
+            template <size_t... Row>
+            static constexpr column_type diagonal_column(const scalar_type& s, size_t col, detail::index_sequence<Row...>)
+            {
+                return column_type((Row == col ? s : scalar_type(0))...);
+            }
+
+            template <size_t... Col>
+            constexpr matrix(detail::index_sequence<Col...>, const cells_type& cells)
+                : m_data{ { column_from_cells(cells, Col, detail::make_index_sequence<N>())... } }
+            {}
+
+            template <size_t... Row>
+            static constexpr column_type column_from_cells(const cells_type& cells, size_t col, detail::index_sequence<Row...>)
+            {
+                return column_type(cells[col * N + Row]...);
+            }
+
+            static scalar_type determinant(const matrix_type& m, std::integral_constant<size_t, 2>)
+            {
+                return m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            }
+
+            static scalar_type determinant(const matrix_type& m, std::integral_constant<size_t, 3>)
+            {
+                return 
+                    m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2]) -
+                    m[1][0] * (m[0][1] * m[2][2] - m[2][1] * m[0][2]) +
+                    m[2][0] * (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
+            }
+
+            static scalar_type determinant(const matrix_type& m, std::integral_constant<size_t, 4>)
+            {
+                scalar_type sub_factor00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+                scalar_type sub_factor01 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+                scalar_type sub_factor02 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+                scalar_type sub_factor03 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+                scalar_type sub_factor04 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+                scalar_type sub_factor05 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+                column_type cofactors(
+                      m[1][1] * sub_factor00 - m[1][2] * sub_factor01 + m[1][3] * sub_factor02,
+                    -(m[1][0] * sub_factor00 - m[1][2] * sub_factor03 + m[1][3] * sub_factor04),
+                      m[1][0] * sub_factor01 - m[1][1] * sub_factor03 + m[1][3] * sub_factor05,
+                    -(m[1][0] * sub_factor02 - m[1][1] * sub_factor04 + m[1][2] * sub_factor05));
+
+                return column_type::call_dot(m[0], cofactors);
+            }
+
+            static matrix_type inverse(const matrix_type& m, std::integral_constant<size_t, 2>)
+            {
+                scalar_type one_over_det = scalar_type(1) / determinant(m, std::integral_constant<size_t, 2>());
+                return matrix_type(
+                     m[1][1] * one_over_det, -m[0][1] * one_over_det,
+                    -m[1][0] * one_over_det,  m[0][0] * one_over_det);
+            }
+
+            static matrix_type inverse(const matrix_type& m, std::integral_constant<size_t, 3>)
+            {
+                scalar_type one_over_det = scalar_type(1) / determinant(m, std::integral_constant<size_t, 3>());
+                matrix_type result;
+                result[0][0] =  (m[1][1] * m[2][2] - m[2][1] * m[1][2]) * one_over_det;
+                result[1][0] = -(m[1][0] * m[2][2] - m[2][0] * m[1][2]) * one_over_det;
+                result[2][0] =  (m[1][0] * m[2][1] - m[2][0] * m[1][1]) * one_over_det;
+                result[0][1] = -(m[0][1] * m[2][2] - m[2][1] * m[0][2]) * one_over_det;
+                result[1][1] =  (m[0][0] * m[2][2] - m[2][0] * m[0][2]) * one_over_det;
+                result[2][1] = -(m[0][0] * m[2][1] - m[2][0] * m[0][1]) * one_over_det;
+                result[0][2] =  (m[0][1] * m[1][2] - m[1][1] * m[0][2]) * one_over_det;
+                result[1][2] = -(m[0][0] * m[1][2] - m[1][0] * m[0][2]) * one_over_det;
+                result[2][2] =  (m[0][0] * m[1][1] - m[1][0] * m[0][1]) * one_over_det;
+                return result;
+            }
+
+            static matrix_type inverse(const matrix_type& m, std::integral_constant<size_t, 4>)
+            {
+                // 2x2 sub-determinants, shared between cofactors
+                scalar_type coef00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+                scalar_type coef02 = m[1][2] * m[3][3] - m[3][2] * m[1][3];
+                scalar_type coef03 = m[1][2] * m[2][3] - m[2][2] * m[1][3];
+                scalar_type coef04 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+                scalar_type coef06 = m[1][1] * m[3][3] - m[3][1] * m[1][3];
+                scalar_type coef07 = m[1][1] * m[2][3] - m[2][1] * m[1][3];
+                scalar_type coef08 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+                scalar_type coef10 = m[1][1] * m[3][2] - m[3][1] * m[1][2];
+                scalar_type coef11 = m[1][1] * m[2][2] - m[2][1] * m[1][2];
+                scalar_type coef12 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+                scalar_type coef14 = m[1][0] * m[3][3] - m[3][0] * m[1][3];
+                scalar_type coef15 = m[1][0] * m[2][3] - m[2][0] * m[1][3];
+                scalar_type coef16 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+                scalar_type coef18 = m[1][0] * m[3][2] - m[3][0] * m[1][2];
+                scalar_type coef19 = m[1][0] * m[2][2] - m[2][0] * m[1][2];
+                scalar_type coef20 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+                scalar_type coef22 = m[1][0] * m[3][1] - m[3][0] * m[1][1];
+                scalar_type coef23 = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+
+                column_type fac0(coef00, coef00, coef02, coef03);
+                column_type fac1(coef04, coef04, coef06, coef07);
+                column_type fac2(coef08, coef08, coef10, coef11);
+                column_type fac3(coef12, coef12, coef14, coef15);
+                column_type fac4(coef16, coef16, coef18, coef19);
+                column_type fac5(coef20, coef20, coef22, coef23);
+
+                column_type vec0(m[1][0], m[0][0], m[0][0], m[0][0]);
+                column_type vec1(m[1][1], m[0][1], m[0][1], m[0][1]);
+                column_type vec2(m[1][2], m[0][2], m[0][2], m[0][2]);
+                column_type vec3(m[1][3], m[0][3], m[0][3], m[0][3]);
+
+                const column_type sign_a(scalar_type(1), scalar_type(-1), scalar_type(1), scalar_type(-1));
+                const column_type sign_b(scalar_type(-1), scalar_type(1), scalar_type(-1), scalar_type(1));
+
+                matrix_type result(
+                    (vec1 * fac0 - vec2 * fac1 + vec3 * fac2) * sign_a,
+                    (vec0 * fac0 - vec2 * fac3 + vec3 * fac4) * sign_b,
+                    (vec0 * fac1 - vec1 * fac3 + vec3 * fac5) * sign_a,
+                    (vec0 * fac2 - vec1 * fac4 + vec2 * fac5) * sign_b);
+
+                column_type row0(result[0][0], result[1][0], result[2][0], result[3][0]);
+                scalar_type one_over_det = scalar_type(1) / column_type::call_dot(m[0], row0);
+                return result *= one_over_det;
+            }
+
             template <size_t offset, class T0, class... Tail>
             void construct(T0&& t0, Tail&&... tail)
             {
@@ -0,0 +1,110 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+// VC needs to come first, scalars need to come before vector.h
+#include <swizzle/glsl/simd_support_vc.h>
+#include <swizzle/glsl/scalar_support.h>
+#include <swizzle/glsl/vector.h>
+#include <swizzle/glsl/matrix.h>
+#include <cstddef>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Batched matrix functions, for CPU-side work like skinning or culling. Arrays of plain float
+        //! matrices are processed vc_float<>::internal_type::Size at a time, each lane handling its own
+        //! matrix; matrix functions are branchless, so lanes never diverge.
+        namespace batch
+        {
+            namespace detail
+            {
+                typedef ::swizzle::glsl::vc_float<> simd_type;
+                typedef simd_type::internal_type raw_type;
+
+                template <template <class, size_t> class VectorType, size_t N, size_t M>
+                using simd_matrix = matrix<VectorType, simd_type, N, M>;
+
+                //! Loads count matrices (at most raw_type::Size) into lanes; the rest of lanes gets
+                //! the last matrix, so that no garbage (NaNs, denormals) slows things down.
+                template <template <class, size_t> class VectorType, size_t N, size_t M>
+                inline void load(simd_matrix<VectorType, N, M>& target, const matrix<VectorType, float, N, M>* source, size_t count)
+                {
+                    for (size_t col = 0; col < M; ++col)
+                    {
+                        for (size_t row = 0; row < N; ++row)
+                        {
+                            raw_type cell;
+                            for (size_t lane = 0; lane < raw_type::Size; ++lane)
+                            {
+                                cell[lane] = source[lane < count ? lane : count - 1][col][row];
+                            }
+                            target[col][row] = cell;
+                        }
+                    }
+                }
+
+                template <template <class, size_t> class VectorType, size_t N, size_t M>
+                inline void store(matrix<VectorType, float, N, M>* target, const simd_matrix<VectorType, N, M>& source, size_t count)
+                {
+                    for (size_t col = 0; col < M; ++col)
+                    {
+                        for (size_t row = 0; row < N; ++row)
+                        {
+                            raw_type cell = static_cast<raw_type>(source[col][row]);
+                            for (size_t lane = 0; lane < count; ++lane)
+                            {
+                                target[lane][col][row] = cell[lane];
+                            }
+                        }
+                    }
+                }
+
+                inline void store(float* target, const simd_type& source, size_t count)
+                {
+                    raw_type value = static_cast<raw_type>(source);
+                    for (size_t lane = 0; lane < count; ++lane)
+                    {
+                        target[lane] = value[lane];
+                    }
+                }
+            }
+
+            //! Applies func to count matrices from input and writes results to output. func gets a matrix
+            //! of vc_float<> and returns either a matrix of vc_float<> or a vc_float<>; output needs to be
+            //! an array of float counterparts. Input and output may be the same array.
+            template <template <class, size_t> class VectorType, size_t N, size_t M, class OutputType, class Func>
+            inline void transform(const matrix<VectorType, float, N, M>* input, OutputType* output, size_t count, Func func)
+            {
+                const size_t lanes = detail::raw_type::Size;
+                detail::simd_matrix<VectorType, N, M> m;
+
+                for (size_t i = 0; i < count; i += lanes)
+                {
+                    size_t chunk = count - i < lanes ? count - i : lanes;
+                    detail::load(m, input + i, chunk);
+                    detail::store(output + i, func(m), chunk);
+                }
+            }
+
+            template <template <class, size_t> class VectorType, size_t N>
+            inline void inverse(const matrix<VectorType, float, N, N>* input, matrix<VectorType, float, N, N>* output, size_t count)
+            {
+                transform(input, output, count, [](const detail::simd_matrix<VectorType, N, N>& m) { return inverse(m); });
+            }
+
+            template <template <class, size_t> class VectorType, size_t N, size_t M>
+            inline void transpose(const matrix<VectorType, float, N, M>* input, matrix<VectorType, float, M, N>* output, size_t count)
+            {
+                transform(input, output, count, [](const detail::simd_matrix<VectorType, N, M>& m) { return transpose(m); });
+            }
+
+            template <template <class, size_t> class VectorType, size_t N>
+            inline void determinant(const matrix<VectorType, float, N, N>* input, float* output, size_t count)
+            {
+                transform(input, output, count, [](const detail::simd_matrix<VectorType, N, N>& m) { return determinant(m); });
+            }
+        }
+    }
+}
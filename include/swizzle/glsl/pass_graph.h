@@ -0,0 +1,161 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <swizzle/glsl/render_target.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Passes of a frame, Shadertoy style: each one renders rows of a render_target (or of the screen)
+        //! and may sample targets of other passes. Passes are grouped in waves: a pass goes to the wave after
+        //! the last one of its inputs, so passes of a wave are independent of each other and get rendered
+        //! concurrently. Targets are swapped once their wave is done, hence later waves sample output of the
+        //! same frame and everything else (the pass' own target included) samples the previous frame.
+        class pass_graph
+        {
+        public:
+            struct pass
+            {
+                std::string name;
+                //! Null for passes rendering elsewhere, e.g. to the screen.
+                std::shared_ptr<render_target> target;
+                //! Rows of passes with no target; the others render all the rows of their target.
+                unsigned rows;
+                //! Called once a frame, before any of the rows and not concurrently with anything; the place to
+                //! bind inputs, i.e. to create samplers of their targets' current fronts.
+                std::function<void()> begin;
+                //! Renders a row; called concurrently for rows of the pass and of other passes of the wave.
+                std::function<void(unsigned row)> render_row;
+                //! Passes (added earlier) whose output of the same frame this one samples.
+                std::vector<size_t> inputs;
+            };
+
+            //! Returns the index of the pass. Inputs need to be added first, so there are no cycles.
+            size_t add(pass p)
+            {
+                if (!p.render_row)
+                {
+                    throw std::invalid_argument("Pass needs to render rows");
+                }
+
+                size_t wave = 0;
+                for (size_t input : p.inputs)
+                {
+                    if (input >= m_passes.size())
+                    {
+                        throw std::invalid_argument("Inputs of a pass need to be added before it");
+                    }
+                    wave = std::max(wave, m_wave_of[input] + 1);
+                }
+
+                if (wave == m_waves.size())
+                {
+                    m_waves.emplace_back();
+                }
+                m_waves[wave].push_back(m_passes.size());
+                m_wave_of.push_back(wave);
+                m_passes.push_back(std::move(p));
+                return m_passes.size() - 1;
+            }
+
+            size_t size() const
+            {
+                return m_passes.size();
+            }
+
+            pass& operator[](size_t index)
+            {
+                return m_passes[index];
+            }
+
+            const pass& operator[](size_t index) const
+            {
+                return m_passes[index];
+            }
+
+            //! Indices of passes, wave after wave.
+            const std::vector<std::vector<size_t>>& waves() const
+            {
+                return m_waves;
+            }
+
+            //! Renders a frame, calling parallel_for(count, func) once a wave; func(i) needs to be called for
+            //! each i in [0;count), from any threads. All the rows of all the passes of the wave are there,
+            //! so independent passes share the threads rather than waiting for each other.
+            template <class ParallelFor>
+            void render_frame(ParallelFor parallel_for)
+            {
+                for (const std::vector<size_t>& wave : m_waves)
+                {
+                    for (size_t index : wave)
+                    {
+                        if (m_passes[index].begin)
+                        {
+                            m_passes[index].begin();
+                        }
+                    }
+
+                    size_t count = 0;
+                    for (size_t index : wave)
+                    {
+                        count += rows(m_passes[index]);
+                    }
+
+                    const std::vector<pass>& passes = m_passes;
+                    parallel_for(count, [&](size_t i)
+                    {
+                        for (size_t index : wave)
+                        {
+                            unsigned pass_rows = rows(passes[index]);
+                            if (i < pass_rows)
+                            {
+                                passes[index].render_row(static_cast<unsigned>(i));
+                                return;
+                            }
+                            i -= pass_rows;
+                        }
+                    });
+
+                    for (size_t index : wave)
+                    {
+                        if (m_passes[index].target)
+                        {
+                            m_passes[index].target->swap();
+                        }
+                    }
+                }
+            }
+
+            //! Renders a frame on the calling thread.
+            void render_frame()
+            {
+                render_frame([](size_t count, const std::function<void(size_t)>& func)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        func(i);
+                    }
+                });
+            }
+
+        private:
+            static unsigned rows(const pass& p)
+            {
+                return p.target ? p.target->height() : p.rows;
+            }
+
+            std::vector<pass> m_passes;
+            std::vector<size_t> m_wave_of;
+            std::vector<std::vector<size_t>> m_waves;
+        };
+    }
+}
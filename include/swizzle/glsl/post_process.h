@@ -0,0 +1,214 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <swizzle/glsl/vector.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Built-in post-process stages. A stage is a functor taking a batch of colours and their fragment
+        //! coordinates, i.e. void operator()(vector<T, 4>& color, const vector<T, 2>& frag_coord) const, and
+        //! changing the colour in place. Only RGB is touched; colours are expected to be linear until gamma.
+        namespace post
+        {
+            //! Multiplies colours by a scale, e.g. exp2(stops).
+            struct exposure
+            {
+                explicit exposure(float scale)
+                    : scale(scale)
+                {}
+
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>&) const
+                {
+                    T s(scale);
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        color[i] = color[i] * s;
+                    }
+                }
+
+                float scale;
+            };
+
+            //! Multiplies each channel by its own gain.
+            struct tint
+            {
+                tint(float r, float g, float b)
+                {
+                    gain[0] = r;
+                    gain[1] = g;
+                    gain[2] = b;
+                }
+
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>&) const
+                {
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        color[i] = color[i] * T(gain[i]);
+                    }
+                }
+
+                float gain[3];
+            };
+
+            //! Saturation (0 is grey, 1 leaves colours as they are) and contrast around mid grey.
+            struct grade
+            {
+                explicit grade(float saturation, float contrast = 1.0f)
+                    : saturation(saturation)
+                    , contrast(contrast)
+                {}
+
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>&) const
+                {
+                    T luma = color[0] * T(0.2126f) + color[1] * T(0.7152f) + color[2] * T(0.0722f);
+                    T s(saturation);
+                    T c(contrast);
+                    T half(0.5f);
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        T saturated = luma + (color[i] - luma) * s;
+                        color[i] = (saturated - half) * c + half;
+                    }
+                }
+
+                float saturation;
+                float contrast;
+            };
+
+            //! x / (1 + x): maps [0;inf) to [0;1).
+            struct tonemap_reinhard
+            {
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>&) const
+                {
+                    T one(1.0f);
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        color[i] = color[i] / (one + color[i]);
+                    }
+                }
+            };
+
+            //! Krzysztof Narkowicz's fit of the ACES filmic curve; saturates at about 11.
+            struct tonemap_aces
+            {
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>&) const
+                {
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        T x = color[i];
+                        color[i] = (x * (T(2.51f) * x + T(0.03f))) / (x * (T(2.43f) * x + T(0.59f)) + T(0.14f));
+                    }
+                }
+            };
+
+            //! Raises colours to 1/gamma; negative input is taken as black.
+            struct gamma
+            {
+                explicit gamma(float value = 2.2f)
+                    : inverse(1.0f / value)
+                {}
+
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>&) const
+                {
+                    using namespace std;
+                    T e(inverse);
+                    T zero(0.0f);
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        color[i] = pow(max(color[i], zero), e);
+                    }
+                }
+
+                float inverse;
+            };
+
+            //! Adds noise of the given amplitude (one step of 8 bit output by default), trading banding of
+            //! gradients for grain. The noise is Jorge Jimenez's interleaved gradient noise: a function of the
+            //! fragment coordinate only, so frames are stable and no state is shared between threads.
+            struct dither
+            {
+                explicit dither(float amplitude = 1.0f / 255.0f)
+                    : amplitude(amplitude)
+                {}
+
+                template <class T>
+                void operator()(vector<T, 4>& color, const vector<T, 2>& frag_coord) const
+                {
+                    using namespace std;
+                    T noise = fract(T(52.9829189f) * fract(frag_coord[0] * T(0.06711056f) + frag_coord[1] * T(0.00583715f)));
+                    T offset = (noise - T(0.5f)) * T(amplitude);
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        color[i] = color[i] + offset;
+                    }
+                }
+
+                float amplitude;
+            };
+        }
+
+        template <class Head, class Stage>
+        class post_process_chain;
+
+        //! A post-process pipeline, run on each batch of pixels between the shader and the pixel store, so
+        //! that all of its stages cost no extra pass over the frame. Stages are appended with then() and
+        //! called in that order; the chain is a compile-time type, so they get inlined into the render loop.
+        //! An empty one leaves colours as they are.
+        class post_process
+        {
+        public:
+            template <class Stage>
+            post_process_chain<post_process, Stage> then(Stage stage) const
+            {
+                return post_process_chain<post_process, Stage>(*this, std::move(stage));
+            }
+
+            template <class T>
+            void operator()(vector<T, 4>&, const vector<T, 2>&) const
+            {}
+
+            static const size_t stage_count = 0;
+        };
+
+        //! A post_process with one more stage; see post_process.
+        template <class Head, class Stage>
+        class post_process_chain
+        {
+        public:
+            post_process_chain(Head head, Stage stage)
+                : m_head(std::move(head))
+                , m_stage(std::move(stage))
+            {}
+
+            template <class Next>
+            post_process_chain<post_process_chain, Next> then(Next stage) const
+            {
+                return post_process_chain<post_process_chain, Next>(*this, std::move(stage));
+            }
+
+            template <class T>
+            void operator()(vector<T, 4>& color, const vector<T, 2>& frag_coord) const
+            {
+                m_head(color, frag_coord);
+                m_stage(color, frag_coord);
+            }
+
+            static const size_t stage_count = Head::stage_count + 1;
+
+        private:
+            Head m_head;
+            Stage m_stage;
+        };
+    }
+}
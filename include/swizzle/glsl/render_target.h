@@ -0,0 +1,100 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <swizzle/glsl/texture_image.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! A float RGBA image for passes of a pass_graph to render into and for other passes to sample. It is
+        //! double-buffered: a pass writes the back buffer while samplers read the front one, which makes
+        //! feedback (a pass sampling its own previous frame) possible. The front is an rgba32f texture_image
+        //! borrowing the buffer, so swapping copies nothing; each swap makes a new image, hence samplers need
+        //! to be recreated after it (and cached decoded blocks of the old one never get hit).
+        class render_target
+        {
+        public:
+            typedef texture_image::word_type word_type;
+
+            render_target(unsigned width, unsigned height)
+                : m_back(0)
+            {
+                resize(width, height);
+            }
+
+            unsigned width() const
+            {
+                return m_width;
+            }
+
+            unsigned height() const
+            {
+                return m_height;
+            }
+
+            //! Reallocates both buffers, cleared to transparent black.
+            void resize(unsigned width, unsigned height)
+            {
+                if (!width || !height)
+                {
+                    throw std::invalid_argument("Render target can not be empty");
+                }
+
+                m_width = width;
+                m_height = height;
+                for (auto& buffer : m_buffers)
+                {
+                    buffer = std::make_shared<std::vector<word_type>>(static_cast<size_t>(width) * height * 4, 0u);
+                }
+                publish_front();
+            }
+
+            //! Writes a pixel of the back buffer; rows go bottom-up, like gl_FragCoord.
+            void store(unsigned x, unsigned y, float r, float g, float b, float a)
+            {
+                using namespace std;
+
+                word_type* pixel = m_buffers[m_back]->data() + (static_cast<size_t>(y) * m_width + x) * 4;
+                pixel[0] = floatBitsToUint(r);
+                pixel[1] = floatBitsToUint(g);
+                pixel[2] = floatBitsToUint(b);
+                pixel[3] = floatBitsToUint(a);
+            }
+
+            //! What the last swap made visible; transparent black before the first one.
+            const std::shared_ptr<const texture_image>& front() const
+            {
+                return m_front;
+            }
+
+            //! Makes the back buffer the front one. Images returned by front() earlier stay valid, but the
+            //! buffer they borrow becomes the back one, i.e. they see the next frame being rendered.
+            void swap()
+            {
+                m_back ^= 1;
+                publish_front();
+            }
+
+        private:
+            void publish_front()
+            {
+                const std::shared_ptr<std::vector<word_type>>& buffer = m_buffers[m_back ^ 1];
+                std::vector<texture_image::level_info> levels(1,
+                    texture_image::level_info{ m_width, m_height, 1, 0, m_width, static_cast<size_t>(m_width) * m_height });
+                m_front = std::make_shared<texture_image>(texture_target::texture_2d, std::move(levels), texture_layout::linear,
+                    texture_format::rgba32f, buffer, buffer->data());
+            }
+
+            unsigned m_width;
+            unsigned m_height;
+            unsigned m_back;
+            std::shared_ptr<std::vector<word_type>> m_buffers[2];
+            std::shared_ptr<const texture_image> m_front;
+        };
+    }
+}
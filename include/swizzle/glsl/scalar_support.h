@@ -4,6 +4,7 @@
 
 #include <swizzle/detail/vector_traits.h>
 #include <cmath>
+#include <cstring>
 
 namespace swizzle
 {
@@ -49,6 +50,26 @@ namespace swizzle
         template <>
         struct get_vector_type_impl<unsigned short> : get_vector_type_impl_for_scalar<unsigned short>
         {};
+
+
+        struct bits_traits_for_scalar
+        {
+            typedef signed int int_type;
+            typedef unsigned int uint_type;
+            typedef float float_type;
+        };
+
+        template <>
+        struct bits_traits<float> : bits_traits_for_scalar
+        {};
+
+        template <>
+        struct bits_traits<signed int> : bits_traits_for_scalar
+        {};
+
+        template <>
+        struct bits_traits<unsigned int> : bits_traits_for_scalar
+        {};
     }
 }
 
@@ -75,4 +96,192 @@ namespace std
     {
         return x - floor(x);
     }
+
+    //! Multiply-add, used by geometric functions to build FMA chains. Deliberately not std::fma:
+    //! without hardware support that one falls back to (slow) software emulation, while this
+    //! gets contracted into a single instruction whenever the target has one.
+    template <typename T>
+    inline T mad(const T& a, const T& b, const T& c)
+    {
+        return a * b + c;
+    }
+
+    template <typename T>
+    inline T inversesqrt(const T& x)
+    {
+        return T(1) / sqrt(x);
+    }
+
+    inline float roundEven(float x)
+    {
+        // default rounding mode is to nearest even
+        return nearbyint(x);
+    }
+
+    inline int floatBitsToInt(float x)
+    {
+        int result;
+        memcpy(&result, &x, sizeof(x));
+        return result;
+    }
+
+    inline unsigned floatBitsToUint(float x)
+    {
+        unsigned result;
+        memcpy(&result, &x, sizeof(x));
+        return result;
+    }
+
+    inline float intBitsToFloat(int x)
+    {
+        float result;
+        memcpy(&result, &x, sizeof(x));
+        return result;
+    }
+
+    inline float uintBitsToFloat(unsigned x)
+    {
+        float result;
+        memcpy(&result, &x, sizeof(x));
+        return result;
+    }
+
+    inline unsigned packUnorm4x8(float x, float y, float z, float w)
+    {
+        auto pack = [](float v, unsigned shift) -> unsigned
+        {
+            return static_cast<unsigned>(nearbyint(fmin(fmax(v, 0.0f), 1.0f) * 255.0f)) << shift;
+        };
+        return pack(x, 0) | pack(y, 8) | pack(z, 16) | pack(w, 24);
+    }
+
+    //! Unpacks component-th byte.
+    inline float unpackUnorm4x8(unsigned packed, unsigned component)
+    {
+        return static_cast<float>((packed >> (component * 8)) & 0xff) / 255.0f;
+    }
+
+    //! Float to half conversion, rounding to nearest even. NaNs become quiet NaNs.
+    inline unsigned packHalf(float x)
+    {
+        const unsigned c_infinity = 255u << 23;
+        const unsigned c_half_overflow = (127u + 16u) << 23;
+        const unsigned c_half_normal_min = (127u - 14u) << 23;
+        const float c_denorm_magic = uintBitsToFloat(((127u - 15u) + (23u - 10u) + 1u) << 23);
+
+        unsigned bits = floatBitsToUint(x);
+        unsigned sign = (bits >> 16) & 0x8000u;
+        bits &= 0x7fffffffu;
+
+        unsigned result;
+        if (bits >= c_half_overflow)
+        {
+            result = bits > c_infinity ? 0x7e00u : 0x7c00u;
+        }
+        else if (bits < c_half_normal_min)
+        {
+            // let the FPU do the rounding of the denormal
+            result = floatBitsToUint(uintBitsToFloat(bits) + c_denorm_magic) - floatBitsToUint(c_denorm_magic);
+        }
+        else
+        {
+            unsigned mantissa_odd = (bits >> 13) & 1u;
+            bits += ((15u - 127u) << 23) + 0xfffu + mantissa_odd;
+            result = bits >> 13;
+        }
+        return result | sign;
+    }
+
+    inline float unpackHalf(unsigned x)
+    {
+        const unsigned c_shifted_exponent = 0x7c00u << 13;
+        const float c_magic = uintBitsToFloat(113u << 23);
+
+        unsigned bits = (x & 0x7fffu) << 13;
+        unsigned exponent = bits & c_shifted_exponent;
+        bits += (127u - 15u) << 23;
+
+        if (exponent == c_shifted_exponent)
+        {
+            // inf & NaN
+            bits += (128u - 16u) << 23;
+        }
+        else if (exponent == 0)
+        {
+            // zero & denormals
+            bits = floatBitsToUint(uintBitsToFloat(bits + (1u << 23)) - c_magic);
+        }
+        return uintBitsToFloat(bits | ((x & 0x8000u) << 16));
+    }
+
+    inline unsigned packHalf2x16(float x, float y)
+    {
+        return packHalf(x) | (packHalf(y) << 16);
+    }
+
+    //! Unpacks component-th half.
+    inline float unpackHalf2x16(unsigned packed, unsigned component)
+    {
+        return unpackHalf(packed >> (component * 16));
+    }
+
+    //! Value (not bit) conversion; x is expected to be non-negative.
+    inline unsigned floatToUint(float x)
+    {
+        return static_cast<unsigned>(x);
+    }
+
+    //! Texel fetch; the SIMD counterpart loads one element per lane.
+    inline unsigned gather(const unsigned* base, unsigned index)
+    {
+        return base[index];
+    }
+
+    inline float gather(const float* base, unsigned index)
+    {
+        return base[index];
+    }
+
+    inline float uintToFloat(unsigned x)
+    {
+        return static_cast<float>(x);
+    }
+
+    //! Same as GLSL's, for bits in [1;32).
+    inline unsigned bitfieldExtract(unsigned value, unsigned offset, unsigned bits)
+    {
+        return (value >> offset) & ((1u << bits) - 1u);
+    }
+
+    //! Unaligned fetch of 32 bits starting at the index-th byte (i.e. the byte ends up in the lowest 8 bits).
+    inline unsigned gatherByte(const unsigned* bytes, unsigned index)
+    {
+        unsigned result;
+        std::memcpy(&result, reinterpret_cast<const char*>(bytes) + index, sizeof(result));
+        return result;
+    }
+
+    //! Calls func for every lane, for what does not vectorize; a scalar is just one lane.
+    template <class Func>
+    inline unsigned gatherWith(const Func& func, unsigned index)
+    {
+        return func(index);
+    }
+
+    //! Calls func, returning four floats (e.g. channels of a texel), once for every lane.
+    template <class Func>
+    inline void gatherChannelsWith(const Func& func, unsigned index, float (&channels)[4])
+    {
+        const auto& values = func(index);
+        for (size_t channel = 0; channel < 4; ++channel)
+        {
+            channels[channel] = values[channel];
+        }
+    }
+
+    //! Difference between horizontally neighbouring pixels, for SIMD lanes; a scalar has no neighbours.
+    inline float laneDifference(float)
+    {
+        return 0.0f;
+    }
 }
\ No newline at end of file
@@ -5,7 +5,11 @@
 // VC needs to come first or else it's going to complain (damn I hate these)
 #include <Vc/vector.h>
 #include <type_traits>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 #include <swizzle/detail/primitive_wrapper.h>
+#include <swizzle/detail/uniform_wrapper.h>
 #include <swizzle/glsl/vector_helper.h>
 
 
@@ -14,39 +18,47 @@ namespace swizzle
     namespace glsl
     {
 #ifdef VC_UNCONDITIONAL_AVX2_INTRINSICS
-        typedef ::Vc::float_v::VectorType::Base raw_simd_type;
+        template <typename VcType>
+        using raw_simd_type_of = typename VcType::VectorType::Base;
 #else
-        typedef ::Vc::float_v::VectorType raw_simd_type;
+        template <typename VcType>
+        using raw_simd_type_of = typename VcType::VectorType;
 #endif
 
+        typedef raw_simd_type_of< ::Vc::float_v > raw_simd_type;
+
         //! ::Vc::float_v has a tiny bit different semantics than what we need,
         //! so let's wrap it.
         template<typename BoolType = ::Vc::float_m, typename AssignPolicy = detail::nothing>
         using vc_float = detail::primitive_wrapper < ::Vc::float_v, ::Vc::float_v::EntryType, BoolType, AssignPolicy >;
 
+        //! Integer counterparts; mostly for results of bit-level functions (floatBitsToInt, packUnorm4x8 & co.)
+        template<typename BoolType = ::Vc::int_m, typename AssignPolicy = detail::nothing>
+        using vc_int = detail::primitive_wrapper < ::Vc::int_v, ::Vc::int_v::EntryType, BoolType, AssignPolicy >;
+
+        template<typename BoolType = ::Vc::uint_m, typename AssignPolicy = detail::nothing>
+        using vc_uint = detail::primitive_wrapper < ::Vc::uint_v, ::Vc::uint_v::EntryType, BoolType, AssignPolicy >;
+
+        //! A lane-invariant float (uniforms, constants); broadcast into vc_float only when mixed with one.
+        template<typename BoolType = ::Vc::float_m, typename AssignPolicy = detail::nothing>
+        using vc_uniform_float = detail::uniform_wrapper< vc_float<BoolType, AssignPolicy> >;
+
 
         //! Specialise vector_helper so that it knows what to do.
-        template <typename BoolType, typename AssignPolicy, size_t Size>
-        struct vector_helper<vc_float<BoolType, AssignPolicy>, Size>
+        template <typename T, typename BoolType, typename AssignPolicy, size_t Size>
+        struct vector_helper<detail::primitive_wrapper< ::Vc::Vector<T>, T, BoolType, AssignPolicy>, Size>
         {
+            typedef detail::primitive_wrapper< ::Vc::Vector<T>, T, BoolType, AssignPolicy> scalar_type;
+
             //! Array needs to be like a steak - the rawest possible
             //! (Wow - I managed to WTF myself upon reading the above after a week or two)
-            typedef std::array<raw_simd_type, Size> data_type;
+            typedef std::array<raw_simd_type_of< ::Vc::Vector<T> >, Size> data_type;
 
+            //! Proxies of 2 or more components; single components are scalar_type.
             template <size_t... indices>
-            struct proxy_generator
-            {
-                typedef detail::indexed_proxy< vector<vc_float<BoolType, AssignPolicy>, sizeof...(indices)>, data_type, indices...> type;
-            };
-
-            //! A factory of 1-component proxies.
-            template <size_t x>
-            struct proxy_generator<x>
-            {
-                typedef vc_float<BoolType, AssignPolicy> type;
-            };
+            using proxy_type = detail::indexed_proxy< vector<scalar_type, sizeof...(indices)>, data_type, indices...>;
 
-            typedef detail::vector_base< Size, proxy_generator, data_type > base_type;
+            typedef detail::vector_base< Size, proxy_type, scalar_type, data_type > base_type;
         };
 
     }
@@ -54,11 +66,244 @@ namespace swizzle
     namespace detail
     {
         //! CxxSwizzle needs to know which vector to create if it needs to
-        template <typename BoolType, typename AssignPolicy>
-        struct get_vector_type_impl< ::swizzle::glsl::vc_float<BoolType, AssignPolicy> >
+        template <typename T, typename BoolType, typename AssignPolicy>
+        struct get_vector_type_impl< primitive_wrapper< ::Vc::Vector<T>, T, BoolType, AssignPolicy> >
+        {
+            typedef ::swizzle::glsl::vector<primitive_wrapper< ::Vc::Vector<T>, T, BoolType, AssignPolicy>, 1> type;
+        };
+
+        template <typename T, typename BoolType, typename AssignPolicy>
+        struct bits_traits< primitive_wrapper< ::Vc::Vector<T>, T, BoolType, AssignPolicy> >
         {
-            typedef ::swizzle::glsl::vector<::swizzle::glsl::vc_float<BoolType, AssignPolicy>, 1> type;
+            typedef ::swizzle::glsl::vc_int<> int_type;
+            typedef ::swizzle::glsl::vc_uint<> uint_type;
+            typedef ::swizzle::glsl::vc_float<> float_type;
         };
+
+        // bit-level functions; they are found with ADL
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_int<> floatBitsToInt(const glsl::vc_float<BoolType, AssignPolicy>& x)
+        {
+            return static_cast< ::Vc::float_v >(x).reinterpretCast< ::Vc::int_v >();
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> floatBitsToUint(const glsl::vc_float<BoolType, AssignPolicy>& x)
+        {
+            return static_cast< ::Vc::float_v >(x).reinterpretCast< ::Vc::uint_v >();
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> intBitsToFloat(const glsl::vc_int<BoolType, AssignPolicy>& x)
+        {
+            return static_cast< ::Vc::int_v >(x).reinterpretCast< ::Vc::float_v >();
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> uintBitsToFloat(const glsl::vc_uint<BoolType, AssignPolicy>& x)
+        {
+            return static_cast< ::Vc::uint_v >(x).reinterpretCast< ::Vc::float_v >();
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> packUnorm4x8(const glsl::vc_float<BoolType, AssignPolicy>& x, const glsl::vc_float<BoolType, AssignPolicy>& y,
+            const glsl::vc_float<BoolType, AssignPolicy>& z, const glsl::vc_float<BoolType, AssignPolicy>& w)
+        {
+            auto pack = [](const ::Vc::float_v& v, int shift) -> ::Vc::uint_v
+            {
+                ::Vc::float_v clamped = ::Vc::min(::Vc::max(v, ::Vc::float_v::Zero()), ::Vc::float_v::One());
+                return ::Vc::round(clamped * 255.0f).staticCast< ::Vc::uint_v >() << shift;
+            };
+            return pack(static_cast< ::Vc::float_v >(x), 0) | pack(static_cast< ::Vc::float_v >(y), 8) | 
+                pack(static_cast< ::Vc::float_v >(z), 16) | pack(static_cast< ::Vc::float_v >(w), 24);
+        }
+
+        //! Unpacks component-th byte.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> unpackUnorm4x8(const glsl::vc_uint<BoolType, AssignPolicy>& packed, unsigned component)
+        {
+            ::Vc::uint_v byte = (static_cast< ::Vc::uint_v >(packed) >> static_cast<int>(component * 8)) & ::Vc::uint_v(0xffu);
+            return byte.staticCast< ::Vc::float_v >() * (1.0f / 255.0f);
+        }
+
+        //! Float to half conversion, rounding to nearest even. A branchless version of
+        //! std::packHalf: all the cases are computed and then blended.
+        inline ::Vc::uint_v packHalf(const ::Vc::float_v& x)
+        {
+            const ::Vc::uint_v c_infinity(255u << 23);
+            const ::Vc::uint_v c_half_overflow((127u + 16u) << 23);
+            const ::Vc::uint_v c_half_normal_min((127u - 14u) << 23);
+            const ::Vc::uint_v c_denorm_magic(((127u - 15u) + (23u - 10u) + 1u) << 23);
+
+            ::Vc::uint_v bits = x.reinterpretCast< ::Vc::uint_v >();
+            ::Vc::uint_v sign = (bits >> 16) & ::Vc::uint_v(0x8000u);
+            bits &= ::Vc::uint_v(0x7fffffffu);
+
+            // normals
+            ::Vc::uint_v mantissa_odd = (bits >> 13) & ::Vc::uint_v(1u);
+            ::Vc::uint_v result = (bits + ::Vc::uint_v(((15u - 127u) << 23) + 0xfffu) + mantissa_odd) >> 13;
+
+            // denormals
+            ::Vc::float_v denormal = bits.reinterpretCast< ::Vc::float_v >() + c_denorm_magic.reinterpretCast< ::Vc::float_v >();
+            result(bits < c_half_normal_min) = denormal.reinterpretCast< ::Vc::uint_v >() - c_denorm_magic;
+
+            // infs and NaNs
+            result(bits >= c_half_overflow) = ::Vc::uint_v(0x7c00u);
+            result(bits > c_infinity) = ::Vc::uint_v(0x7e00u);
+
+            return result | sign;
+        }
+
+        //! A branchless version of std::unpackHalf.
+        inline ::Vc::float_v unpackHalf(const ::Vc::uint_v& x)
+        {
+            const ::Vc::uint_v c_shifted_exponent(0x7c00u << 13);
+            const ::Vc::float_v c_magic(::Vc::uint_v(113u << 23).reinterpretCast< ::Vc::float_v >());
+
+            ::Vc::uint_v bits = (x & ::Vc::uint_v(0x7fffu)) << 13;
+            ::Vc::uint_v exponent = bits & c_shifted_exponent;
+            bits += ::Vc::uint_v((127u - 15u) << 23);
+
+            ::Vc::uint_v special = bits + ::Vc::uint_v((128u - 16u) << 23);
+            ::Vc::float_v denormal = (bits + ::Vc::uint_v(1u << 23)).reinterpretCast< ::Vc::float_v >() - c_magic;
+
+            bits(exponent == c_shifted_exponent) = special;
+            bits(exponent == ::Vc::uint_v::Zero()) = denormal.reinterpretCast< ::Vc::uint_v >();
+
+            return (bits | ((x & ::Vc::uint_v(0x8000u)) << 16)).reinterpretCast< ::Vc::float_v >();
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> packHalf2x16(const glsl::vc_float<BoolType, AssignPolicy>& x, const glsl::vc_float<BoolType, AssignPolicy>& y)
+        {
+            return packHalf(static_cast< ::Vc::float_v >(x)) | (packHalf(static_cast< ::Vc::float_v >(y)) << 16);
+        }
+
+        //! Unpacks component-th half.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> unpackHalf2x16(const glsl::vc_uint<BoolType, AssignPolicy>& packed, unsigned component)
+        {
+            return unpackHalf(static_cast< ::Vc::uint_v >(packed) >> static_cast<int>(component * 16));
+        }
+
+        //! Value (not bit) conversion; x is expected to be non-negative.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> floatToUint(const glsl::vc_float<BoolType, AssignPolicy>& x)
+        {
+            return static_cast< ::Vc::float_v >(x).staticCast< ::Vc::uint_v >();
+        }
+
+        //! Loads base[index] for every lane. Vc has no AVX2 support, so the hardware gather is used directly
+        //! if available; otherwise Vc assembles the vector from scalar loads.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> gather(const unsigned* base, const glsl::vc_uint<BoolType, AssignPolicy>& index)
+        {
+            ::Vc::uint_v indices = static_cast< ::Vc::uint_v >(index);
+#if defined(__AVX2__) && defined(VC_IMPL_AVX)
+            return ::Vc::uint_v(_mm256_i32gather_epi32(reinterpret_cast<const int*>(base), indices.data(), 4));
+#elif defined(__AVX2__) && defined(VC_IMPL_SSE)
+            return ::Vc::uint_v(_mm_i32gather_epi32(reinterpret_cast<const int*>(base), indices.data(), 4));
+#else
+            return ::Vc::uint_v(base, indices);
+#endif
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> gather(const float* base, const glsl::vc_uint<BoolType, AssignPolicy>& index)
+        {
+            ::Vc::uint_v indices = static_cast< ::Vc::uint_v >(index);
+#if defined(__AVX2__) && defined(VC_IMPL_AVX)
+            return ::Vc::float_v(_mm256_i32gather_ps(base, indices.data(), 4));
+#elif defined(__AVX2__) && defined(VC_IMPL_SSE)
+            return ::Vc::float_v(_mm_i32gather_ps(base, indices.data(), 4));
+#else
+            return ::Vc::float_v(base, indices);
+#endif
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> uintToFloat(const glsl::vc_uint<BoolType, AssignPolicy>& x)
+        {
+            return static_cast< ::Vc::uint_v >(x).staticCast< ::Vc::float_v >();
+        }
+
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> bitfieldExtract(const glsl::vc_uint<BoolType, AssignPolicy>& value, unsigned offset, unsigned bits)
+        {
+            return (static_cast< ::Vc::uint_v >(value) >> static_cast<int>(offset)) & ::Vc::uint_v((1u << bits) - 1u);
+        }
+
+        //! Per-lane offsets.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> bitfieldExtract(const glsl::vc_uint<BoolType, AssignPolicy>& value, const glsl::vc_uint<BoolType, AssignPolicy>& offset, unsigned bits)
+        {
+            return (static_cast< ::Vc::uint_v >(value) >> static_cast< ::Vc::uint_v >(offset)) & ::Vc::uint_v((1u << bits) - 1u);
+        }
+
+        //! Unaligned load of 32 bits starting at the index-th byte, for every lane; there needs to be some padding
+        //! after the last byte.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> gatherByte(const unsigned* bytes, const glsl::vc_uint<BoolType, AssignPolicy>& index)
+        {
+            ::Vc::uint_v indices = static_cast< ::Vc::uint_v >(index);
+#if defined(__AVX2__) && defined(VC_IMPL_AVX)
+            return ::Vc::uint_v(_mm256_i32gather_epi32(reinterpret_cast<const int*>(bytes), indices.data(), 1));
+#elif defined(__AVX2__) && defined(VC_IMPL_SSE)
+            return ::Vc::uint_v(_mm_i32gather_epi32(reinterpret_cast<const int*>(bytes), indices.data(), 1));
+#else
+            // two aligned loads; shifting twice avoids shifts by 32 for aligned indices
+            ::Vc::uint_v words = indices >> 2;
+            ::Vc::uint_v shift = (indices & ::Vc::uint_v(3u)) << 3;
+            ::Vc::uint_v low(bytes, words);
+            ::Vc::uint_v high(bytes, words + ::Vc::uint_v(1u));
+            return (low >> shift) | ((high << 1) << (::Vc::uint_v(31u) - shift));
+#endif
+        }
+
+        //! Calls func for every lane, for what does not vectorize.
+        template <class Func, typename BoolType, typename AssignPolicy>
+        inline glsl::vc_uint<> gatherWith(const Func& func, const glsl::vc_uint<BoolType, AssignPolicy>& index)
+        {
+            ::Vc::uint_v indices = static_cast< ::Vc::uint_v >(index);
+            ::Vc::uint_v result;
+            for (size_t i = 0; i < ::Vc::uint_v::Size; ++i)
+            {
+                result[i] = func(static_cast<unsigned>(indices[i]));
+            }
+            return result;
+        }
+
+        //! Calls func, returning four floats (e.g. channels of a texel), once for every lane.
+        template <class Func, class FloatType, typename BoolType, typename AssignPolicy>
+        inline void gatherChannelsWith(const Func& func, const glsl::vc_uint<BoolType, AssignPolicy>& index, FloatType (&channels)[4])
+        {
+            ::Vc::uint_v indices = static_cast< ::Vc::uint_v >(index);
+            ::Vc::float_v result[4];
+            for (size_t i = 0; i < ::Vc::uint_v::Size; ++i)
+            {
+                const auto& values = func(static_cast<unsigned>(indices[i]));
+                for (size_t channel = 0; channel < 4; ++channel)
+                {
+                    result[channel][i] = values[channel];
+                }
+            }
+            for (size_t channel = 0; channel < 4; ++channel)
+            {
+                channels[channel] = result[channel];
+            }
+        }
+
+        //! Difference between horizontally neighbouring pixels (lanes); like coarse derivatives on GPUs,
+        //! lanes are paired and both lanes of a pair get the same value.
+        template <typename BoolType, typename AssignPolicy>
+        inline glsl::vc_float<> laneDifference(const glsl::vc_float<BoolType, AssignPolicy>& x)
+        {
+            ::Vc::float_v value = static_cast< ::Vc::float_v >(x);
+            ::Vc::float_v result = value.shifted(1) - value;
+            result(static_cast< ::Vc::float_m >((::Vc::uint_v::IndexesFromZero() & ::Vc::uint_v(1u)) != ::Vc::uint_v::Zero())) = value - value.shifted(-1);
+            return result;
+        }
     }
 }
 
@@ -91,10 +336,88 @@ namespace Vc
             return exp(n * log(x));
         }
 
+        template <typename T>
+        inline Vector<T> tan(const Vector<T>& x)
+        {
+            Vector<T> s, c;
+            sincos(x, &s, &c);
+            return s / c;
+        }
+
+        template <typename T>
+        inline Vector<T> acos(const Vector<T>& x)
+        {
+            return T(1.57079632679489661923) - asin(x);
+        }
+
+        template <typename T>
+        inline Vector<T> exp2(const Vector<T>& x)
+        {
+            return exp(x * T(0.69314718055994530942));
+        }
+
+        template <typename T>
+        inline Vector<T> sign(const Vector<T>& x)
+        {
+            auto result = Vector<T>::Zero();
+            result(x > Vector<T>::Zero()) = Vector<T>::One();
+            result(x < Vector<T>::Zero()) = -Vector<T>::One();
+            return result;
+        }
+
+        template <typename T>
+        inline Vector<T> mod(const Vector<T>& x, const Vector<T>& y)
+        {
+            return x - y * floor(x / y);
+        }
+
         template <typename T>
         inline Vector<T> fract(const Vector<T>& x)
         {
             return x - floor(x);
         }
+
+        template <typename T>
+        inline Vector<T> roundEven(const Vector<T>& x)
+        {
+            //! Vc rounds to nearest even already
+            return round(x);
+        }
+
+        template <typename T>
+        inline typename Vector<T>::Mask isinf(const Vector<T>& x)
+        {
+            return !(isfinite(x) || isnan(x));
+        }
+
+        template <typename T>
+        inline Vector<T> mad(const Vector<T>& a, const Vector<T>& b, const Vector<T>& c)
+        {
+#ifdef VC_IMPL_FMA4
+            Vector<T> result = a;
+            result.fusedMultiplyAdd(b, c);
+            return result;
+#else
+            //! Without FMA4 Vc emulates fusedMultiplyAdd with doubles, which is way slower than
+            //! mul & add (and the compiler is free to contract these into FMA anyway).
+            return a * b + c;
+#endif
+        }
+
+        template <typename T>
+        inline Vector<T> inversesqrt(const Vector<T>& x)
+        {
+#ifdef VC_IMPL_Scalar
+            return rsqrt(x);
+#else
+            //! rsqrt is a ~12 bit approximation; one Newton-Raphson step gets it close to
+            //! full precision for a fraction of sqrt & div cost.
+            Vector<T> y = rsqrt(x);
+            Vector<T> result = y * (T(1.5) - T(0.5) * x * y * y);
+            //! 0 and inf give NaN in the step above, the approximation is exact for them though.
+            result(isnan(result)) = y;
+            return result;
+#endif
+        }
     }
 }
\ No newline at end of file
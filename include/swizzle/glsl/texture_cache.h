@@ -0,0 +1,257 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <swizzle/detail/mapped_file.h>
+#include <swizzle/glsl/texture_image.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Keeps decoded textures in cache files, so that decoding (and mipmap generation and tiling) happens
+        //! once per source file rather than once per process start. Cache files are memory mapped read-only,
+        //! hence loading is close to free and all the processes using a texture share its pages. A cache file
+        //! gets rewritten whenever the size or the modification time of its source changes.
+        //! Files are in the native byte order; they are meant to be local to the machine.
+        class texture_cache
+        {
+        public:
+            //! The directory needs to exist.
+            explicit texture_cache(std::string directory)
+                : m_directory(std::move(directory))
+            {
+                if (!m_directory.empty() && m_directory.back() != '/' && m_directory.back() != '\\')
+                {
+                    m_directory += '/';
+                }
+            }
+
+            //! Maps the cache file of source_path; if there is none or it is out of date decode is called
+            //! (with no arguments, returning a texture_image exactly as it should be sampled, i.e. mipmapped
+            //! and tiled if need be) and its result gets cached. If the cache can not be written the decoded
+            //! image is returned as is.
+            template <class Decoder>
+            std::shared_ptr<const texture_image> load(const std::string& source_path, Decoder decode) const
+            {
+                const std::string path = cache_path(source_path);
+                const source_stamp stamp = stamp_of(source_path);
+
+                if (auto cached = read(path, stamp))
+                {
+                    return cached;
+                }
+
+                auto decoded = std::make_shared<texture_image>(decode());
+                if (write(*decoded, path, stamp))
+                {
+                    if (auto cached = read(path, stamp))
+                    {
+                        return cached;
+                    }
+                }
+                return decoded;
+            }
+
+            //! Where source_path gets cached; the name is readable, the hash of the whole path makes it unique.
+            std::string cache_path(const std::string& source_path) const
+            {
+                std::string name = source_path.substr(source_path.find_last_of("/\\") + 1);
+                for (char& c : name)
+                {
+                    if (!(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'z') && !(c >= 'A' && c <= 'Z') && c != '.' && c != '-')
+                    {
+                        c = '_';
+                    }
+                }
+
+                // FNV-1a, so that names are the same whatever the compiler
+                uint64_t hash = 14695981039346656037ull;
+                for (char c : source_path)
+                {
+                    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+                }
+
+                char suffix[32];
+                std::snprintf(suffix, sizeof(suffix), "-%016llx.cxtex", static_cast<unsigned long long>(hash));
+                return m_directory + name + suffix;
+            }
+
+        private:
+            struct source_stamp
+            {
+                uint64_t size;
+                int64_t time;
+            };
+
+            static const uint32_t file_version = 2;
+            //! Texels start at a cache line boundary.
+            static const size_t data_alignment = 64;
+            //! Larger levels are taken for corruption; it also keeps sizes of levels from overflowing.
+            static const uint32_t max_extent = 1 << 16;
+
+            struct file_header
+            {
+                char magic[4];
+                uint32_t version;
+                uint32_t target;
+                uint32_t format;
+                uint32_t layout;
+                uint32_t level_count;
+                uint32_t data_offset;
+                uint32_t reserved;
+                uint64_t data_size;
+                source_stamp stamp;
+            };
+
+            struct file_level
+            {
+                uint32_t width;
+                uint32_t height;
+                uint32_t depth;
+                uint32_t pitch;
+                uint64_t offset;
+                uint64_t slice_pitch;
+            };
+
+            //! Missing sources get a zero stamp, so whatever got decoded in their place is cached too.
+            static source_stamp stamp_of(const std::string& source_path)
+            {
+                struct stat info;
+                if (::stat(source_path.c_str(), &info) != 0)
+                {
+                    return source_stamp{ 0, 0 };
+                }
+                return source_stamp{ static_cast<uint64_t>(info.st_size), static_cast<int64_t>(info.st_mtime) };
+            }
+
+            static size_t header_size(size_t level_count)
+            {
+                size_t size = sizeof(file_header) + level_count * sizeof(file_level);
+                return (size + data_alignment - 1) / data_alignment * data_alignment;
+            }
+
+            //! Null if the file is missing, stale or broken.
+            static std::shared_ptr<const texture_image> read(const std::string& path, const source_stamp& stamp)
+            {
+                detail::mapped_file file = detail::mapped_file::open(path);
+                if (!file.data || file.size < sizeof(file_header))
+                {
+                    return nullptr;
+                }
+
+                const char* bytes = static_cast<const char*>(file.data.get());
+                file_header header;
+                std::memcpy(&header, bytes, sizeof(header));
+
+                if (std::memcmp(header.magic, "CXTX", 4) != 0 || header.version != file_version ||
+                    header.stamp.size != stamp.size || header.stamp.time != stamp.time ||
+                    header.target > static_cast<uint32_t>(texture_target::texture_cube) ||
+                    header.format > static_cast<uint32_t>(texture_format::rgba32f) ||
+                    header.layout > static_cast<uint32_t>(texture_layout::tiled) ||
+                    header.level_count == 0 || header.level_count > 32 ||
+                    header.data_offset != header_size(header.level_count) ||
+                    file.size < header.data_offset || (file.size - header.data_offset) / sizeof(texture_image::word_type) < header.data_size)
+                {
+                    return nullptr;
+                }
+
+                // levels need to be exactly what texture_image would make for the layout, one after another, or
+                // else samplers could read past the texels
+                const texture_target target = static_cast<texture_target>(header.target);
+                const texture_layout layout = static_cast<texture_layout>(header.layout);
+                std::vector<texture_image::level_info> levels(header.level_count);
+                size_t texel_count = 0;
+                for (size_t i = 0; i < levels.size(); ++i)
+                {
+                    file_level level;
+                    std::memcpy(&level, bytes + sizeof(file_header) + i * sizeof(file_level), sizeof(level));
+                    if (level.width == 0 || level.width > max_extent || level.height == 0 || level.height > max_extent ||
+                        level.depth == 0 || level.depth > max_extent ||
+                        (target == texture_target::texture_2d && level.depth != 1) ||
+                        (target == texture_target::texture_cube && (level.depth != 6 || level.width != level.height)))
+                    {
+                        return nullptr;
+                    }
+
+                    levels[i] = texture_image::make_level(level.width, level.height, level.depth, texel_count, layout);
+                    if (level.offset != levels[i].offset || level.pitch != levels[i].pitch || level.slice_pitch != levels[i].slice_pitch)
+                    {
+                        return nullptr;
+                    }
+                    texel_count += texture_image::level_size(levels[i]);
+                }
+
+                auto words = reinterpret_cast<const texture_image::word_type*>(bytes + header.data_offset);
+                auto image = std::make_shared<texture_image>(target, std::move(levels), layout, static_cast<texture_format>(header.format), file.data, words);
+                if (image->data_size() != header.data_size)
+                {
+                    return nullptr;
+                }
+                return image;
+            }
+
+            //! Writes to a temporary file first, so that other processes never map a partial one.
+            static bool write(const texture_image& image, const std::string& path, const source_stamp& stamp)
+            {
+                file_header header = {};
+                std::memcpy(header.magic, "CXTX", 4);
+                header.version = file_version;
+                header.target = static_cast<uint32_t>(image.target());
+                header.format = static_cast<uint32_t>(image.format());
+                header.layout = static_cast<uint32_t>(image.layout());
+                header.level_count = image.levels();
+                header.data_offset = static_cast<uint32_t>(header_size(image.levels()));
+                header.data_size = image.data_size();
+                header.stamp = stamp;
+
+                std::vector<char> head(header.data_offset, 0);
+                std::memcpy(head.data(), &header, sizeof(header));
+                for (unsigned i = 0; i < image.levels(); ++i)
+                {
+                    const texture_image::level_info& info = image.level(i);
+                    file_level level = { info.width, info.height, info.depth, info.pitch, info.offset, info.slice_pitch };
+                    std::memcpy(head.data() + sizeof(file_header) + i * sizeof(file_level), &level, sizeof(level));
+                }
+
+                char suffix[32];
+                std::snprintf(suffix, sizeof(suffix), ".%08x.tmp", static_cast<unsigned>(std::random_device()()));
+                const std::string temp_path = path + suffix;
+                {
+                    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+                    file.write(head.data(), head.size());
+                    file.write(reinterpret_cast<const char*>(image.data()), image.data_size() * sizeof(texture_image::word_type));
+                    if (!file.good())
+                    {
+                        file.close();
+                        std::remove(temp_path.c_str());
+                        return false;
+                    }
+                }
+
+                // rename does not replace existing files on Windows; whoever got there first wins
+                if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+                {
+                    std::remove(path.c_str());
+                    if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+                    {
+                        std::remove(temp_path.c_str());
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            std::string m_directory;
+        };
+    }
+}
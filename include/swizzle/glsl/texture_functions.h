@@ -2,6 +2,8 @@
 // Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
 #pragma once
 
+#include <swizzle/detail/instrumentation.h>
+
 namespace swizzle
 {
     namespace glsl
@@ -15,25 +17,71 @@ namespace swizzle
             template <class Sampler>
             auto texture(Sampler& sampler, typename Sampler::tex_coord_type coord) -> decltype ( sampler.sample(coord) )
             {
+                CXXSWIZZLE_INSTRUMENT("texture", "texture");
                 return sampler.sample(coord);
             }
 
             template <class Sampler>
             auto texture(const Sampler& sampler, typename Sampler::tex_coord_type coord, float bias) -> decltype ( sampler.sample(coord, bias) )
             {
+                CXXSWIZZLE_INSTRUMENT("texture", "texture");
                 return sampler.sample(coord, bias);
             }
 
+            template <class Sampler, class Lod>
+            auto textureLod(const Sampler& sampler, typename Sampler::tex_coord_type coord, const Lod& lod) -> decltype ( sampler.sampleLod(coord, lod) )
+            {
+                CXXSWIZZLE_INSTRUMENT("texture", "textureLod");
+                return sampler.sampleLod(coord, lod);
+            }
+
             template <class Sampler>
             auto textureOffset(const Sampler& sampler, typename Sampler::tex_coord_type coord, typename Sampler::tex_offset_type offset) -> decltype( sampler.sampleOffset(coord, offset) )
             {
-                return sampler.sample(coord, offset);
+                CXXSWIZZLE_INSTRUMENT("texture", "textureOffset");
+                return sampler.sampleOffset(coord, offset);
             }
 
             template <class Sampler>
             auto textureOffset(const Sampler& sampler, typename Sampler::tex_coord_type coord, typename Sampler::tex_offset_type offset, float bias) -> decltype( sampler.sampleOffset(coord, offset, bias) )
             {
-                return sampler.sample(coord, offset, bias);
+                CXXSWIZZLE_INSTRUMENT("texture", "textureOffset");
+                return sampler.sampleOffset(coord, offset, bias);
+            }
+
+            template <class Sampler>
+            auto textureGrad(const Sampler& sampler, typename Sampler::tex_coord_type coord, typename Sampler::tex_grad_type dPdx, typename Sampler::tex_grad_type dPdy) -> decltype( sampler.sampleGrad(coord, dPdx, dPdy) )
+            {
+                CXXSWIZZLE_INSTRUMENT("texture", "textureGrad");
+                return sampler.sampleGrad(coord, dPdx, dPdy);
+            }
+
+            template <class Sampler>
+            auto texelFetch(const Sampler& sampler, typename Sampler::tex_fetch_type coord, int lod) -> decltype( sampler.fetch(coord, lod) )
+            {
+                CXXSWIZZLE_INSTRUMENT("texture", "texelFetch");
+                return sampler.fetch(coord, lod);
+            }
+
+            template <class Sampler>
+            auto textureSize(const Sampler& sampler, int lod) -> decltype( sampler.size(lod) )
+            {
+                CXXSWIZZLE_INSTRUMENT("texture", "textureSize");
+                return sampler.size(lod);
+            }
+
+            template <class Sampler>
+            auto textureGather(const Sampler& sampler, typename Sampler::tex_coord_type coord) -> decltype( sampler.sampleGather(coord) )
+            {
+                CXXSWIZZLE_INSTRUMENT("texture", "textureGather");
+                return sampler.sampleGather(coord);
+            }
+
+            template <class Sampler>
+            auto textureGather(const Sampler& sampler, typename Sampler::tex_coord_type coord, int comp) -> decltype( sampler.sampleGather(coord, comp) )
+            {
+                CXXSWIZZLE_INSTRUMENT("texture", "textureGather");
+                return sampler.sampleGather(coord, comp);
             }
         }
     }
@@ -0,0 +1,646 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <swizzle/detail/block_cache.h>
+#include <swizzle/glsl/scalar_support.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Layout of source pixels (think SDL_PixelFormat): each pixel is a bytes_per_pixel long
+        //! little-endian integer and channels are extracted with masks. Zero alpha mask means opaque.
+        struct pixel_format
+        {
+            unsigned bytes_per_pixel;
+            uint32_t r_mask;
+            uint32_t g_mask;
+            uint32_t b_mask;
+            uint32_t a_mask;
+        };
+
+        //! How texels of a level are ordered in memory.
+        enum class texture_layout
+        {
+            //! Row after row.
+            linear,
+            //! Tiles of tile_size x tile_size texels (i.e. 64 bytes, a cache line), tile rows after tile rows;
+            //! texels within a tile go row after row. Bilinear footprints and vertical or diagonal walks
+            //! touch way less cache lines this way. Levels get padded to whole tiles.
+            tiled
+        };
+
+        //! How texels are encoded; all of them are decoded at load time and fetched as 32 bit words.
+        enum class texture_format
+        {
+            //! Packed RGBA, 8 bits per channel (red in the lowest byte, as with packUnorm4x8); one word.
+            rgba8,
+            //! Single 8 bit channel, sampled as (r, 0, 0, 1) like GL_R8; a quarter of rgba8 bandwidth and
+            //! samplers filter just the one channel.
+            r8,
+            //! Half floats, two words (as with packHalf2x16).
+            rgba16f,
+            //! Floats, four words.
+            rgba32f
+        };
+
+        //! What the image is a texture of; volumes and cube maps are stacks of equally sized 2D slices.
+        enum class texture_target
+        {
+            texture_2d,
+            //! Slices along the third coordinate; mip levels halve the depth too.
+            texture_3d,
+            //! Six square faces, in the usual order: +X, -X, +Y, -Y, +Z, -Z; mip levels keep all six.
+            texture_cube
+        };
+
+        //! A 2D, 3D or cube texture, decoded once at load time, so that a fetch is a 32 bit load per word (a gather with
+        //! SIMD) followed by a couple of shifts and masks or a half to float conversion at most. Rows are
+        //! stored bottom-up, so texel (0, 0) is where OpenGL expects it to be and samplers do not need to flip
+        //! coordinates. Mip levels, if generated, follow the base level in the same array.
+        //! Volumes and cube maps are stored slice after slice (face after face) within each level, every slice
+        //! laid out like a 2D level.
+        //! Texels are either owned or borrowed from an external, read-only storage (see texture_cache); the
+        //! latter get copied before any modification.
+        class texture_image
+        {
+        public:
+            //! Words need to be exactly what gather functions expect.
+            typedef unsigned word_type;
+            static_assert(sizeof(word_type) == 4, "Words are expected to be 32 bit");
+
+            //! A packed RGBA8 texel.
+            typedef unsigned texel_type;
+
+            static const unsigned tile_size = 4;
+
+            struct level_info
+            {
+                unsigned width;
+                unsigned height;
+                //! Slices; 1 for 2D textures and 6 for cube maps.
+                unsigned depth;
+                //! In texels, from data().
+                size_t offset;
+                //! Texels between starts of consecutive rows (linear) or rows of tiles (tiled).
+                unsigned pitch;
+                //! Texels between starts of consecutive slices.
+                size_t slice_pitch;
+            };
+
+            texture_image()
+                : m_target(texture_target::texture_2d)
+                , m_layout(texture_layout::linear)
+                , m_format(texture_format::rgba8)
+                , m_texel_count(0)
+            {}
+
+            //! Takes packed RGBA8 texels, rows bottom-up.
+            texture_image(unsigned width, unsigned height, std::vector<texel_type> texels)
+                : m_target(texture_target::texture_2d)
+                , m_layout(texture_layout::linear)
+                , m_format(texture_format::rgba8)
+                , m_texel_count(texels.size())
+                , m_words(std::move(texels))
+            {
+                if (m_texel_count != static_cast<size_t>(width) * height)
+                {
+                    throw std::invalid_argument("Texel count does not match texture size");
+                }
+                m_levels.push_back(make_level(width, height, 1, 0, m_layout));
+            }
+
+            //! Takes four floats per texel, rows bottom-up, and encodes them in the format (r8 keeps red only).
+            texture_image(unsigned width, unsigned height, const std::vector<float>& rgba, texture_format format)
+                : texture_image(texture_target::texture_2d, width, height, 1, rgba, format)
+            {}
+
+            //! As above, slice after slice; cube maps need 6 square faces.
+            texture_image(texture_target target, unsigned width, unsigned height, unsigned depth, const std::vector<float>& rgba, texture_format format)
+                : m_target(target)
+                , m_layout(texture_layout::linear)
+                , m_format(format)
+                , m_texel_count(static_cast<size_t>(width) * height * depth)
+                , m_levels(1, make_level(width, height, depth, 0, m_layout))
+                , m_words(storage_size(m_texel_count, format))
+            {
+                if ((target == texture_target::texture_2d && depth != 1) || (target == texture_target::texture_cube && (depth != 6 || width != height)))
+                {
+                    throw std::invalid_argument("Texture size does not match the target");
+                }
+                if (rgba.size() != m_texel_count * 4)
+                {
+                    throw std::invalid_argument("Texel count does not match texture size");
+                }
+                for (size_t i = 0; i < m_texel_count; ++i)
+                {
+                    write(i, std::array<float, 4>{ { rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2], rgba[i * 4 + 3] } });
+                }
+            }
+
+            //! Borrows already encoded texels, e.g. memory mapped ones; words need to stay valid for as long as the
+            //! storage does. Levels are expected to be what make_level would make for the layout.
+            texture_image(texture_target target, std::vector<level_info> levels, texture_layout layout, texture_format format,
+                std::shared_ptr<const void> storage, const word_type* words)
+                : m_target(target)
+                , m_layout(layout)
+                , m_format(format)
+                , m_texel_count(levels.empty() ? 0 : levels.back().offset + level_size(levels.back()))
+                , m_levels(std::move(levels))
+                , m_storage(std::move(storage))
+                , m_borrowed(words)
+            {
+                if (!m_storage || !m_borrowed)
+                {
+                    throw std::invalid_argument("Storage is required");
+                }
+            }
+
+            //! Decodes pixels of any (up to 32 bit) format into rgba8; pitch is the distance between rows in bytes,
+            //! rows are expected to go top-down.
+            texture_image(const void* pixels, unsigned width, unsigned height, size_t pitch, const pixel_format& format)
+                : m_target(texture_target::texture_2d)
+                , m_layout(texture_layout::linear)
+                , m_format(texture_format::rgba8)
+                , m_texel_count(static_cast<size_t>(width) * height)
+                , m_levels(1, make_level(width, height, 1, 0, m_layout))
+                , m_words(m_texel_count)
+            {
+                if (format.bytes_per_pixel < 1 || format.bytes_per_pixel > 4)
+                {
+                    throw std::invalid_argument("Unsupported pixel format");
+                }
+
+                const channel_decoder r(format.r_mask, 0), g(format.g_mask, 0), b(format.b_mask, 0), a(format.a_mask, 255);
+
+                for (unsigned y = 0; y < height; ++y)
+                {
+                    const uint8_t* src = static_cast<const uint8_t*>(pixels) + (height - 1 - y) * pitch;
+                    word_type* dst = m_words.data() + static_cast<size_t>(y) * width;
+
+                    for (unsigned x = 0; x < width; ++x, src += format.bytes_per_pixel)
+                    {
+                        uint32_t pixel = 0;
+                        for (unsigned i = 0; i < format.bytes_per_pixel; ++i)
+                        {
+                            pixel |= static_cast<uint32_t>(src[i]) << (i * 8);
+                        }
+                        dst[x] = r(pixel) | (g(pixel) << 8) | (b(pixel) << 16) | (a(pixel) << 24);
+                    }
+                }
+            }
+
+            //! Replaces all the levels but the base one with a full mip chain, down to 1x1 (1x1x1 for volumes).
+            //! Each texel is a box-filtered average of (up to) 2x2 texels of the previous level, 2x2x2 for volumes;
+            //! faces of cube maps are filtered separately.
+            void generate_mipmaps()
+            {
+                if (empty())
+                {
+                    return;
+                }
+
+                own();
+                m_levels.resize(1);
+                m_texel_count = level_size(m_levels[0]);
+                const bool volume = m_target == texture_target::texture_3d;
+
+                while (m_levels.back().width > 1 || m_levels.back().height > 1 || (volume && m_levels.back().depth > 1))
+                {
+                    unsigned src = levels() - 1;
+                    level_info dst = make_level(std::max(width(src) / 2, 1u), std::max(height(src) / 2, 1u),
+                        volume ? std::max(depth(src) / 2, 1u) : depth(src), m_texel_count, m_layout);
+                    m_levels.push_back(dst);
+                    m_texel_count = dst.offset + level_size(dst);
+                    m_words.resize(storage_size(m_texel_count, m_format));
+
+                    for (unsigned z = 0; z < dst.depth; ++z)
+                    {
+                        unsigned z0 = volume ? z * 2 : z;
+                        unsigned z1 = volume ? std::min(z0 + 1, depth(src) - 1) : z0;
+
+                        for (unsigned y = 0; y < dst.height; ++y)
+                        {
+                            unsigned y0 = y * 2;
+                            unsigned y1 = std::min(y0 + 1, height(src) - 1);
+
+                            for (unsigned x = 0; x < dst.width; ++x)
+                            {
+                                unsigned x0 = x * 2;
+                                unsigned x1 = std::min(x0 + 1, width(src) - 1);
+                                const size_t sources[8] = {
+                                    index(x0, y0, z0, src), index(x1, y0, z0, src), index(x0, y1, z0, src), index(x1, y1, z0, src),
+                                    index(x0, y0, z1, src), index(x1, y0, z1, src), index(x0, y1, z1, src), index(x1, y1, z1, src)
+                                };
+                                average(sources, volume ? 8 : 4, index(x, y, z, src + 1));
+                            }
+                        }
+                    }
+                }
+            }
+
+            //! Re-encodes texels of all the levels.
+            void set_format(texture_format format)
+            {
+                if (format == m_format)
+                {
+                    return;
+                }
+
+                own();
+                texture_image converted(*this);
+                converted.m_format = format;
+                converted.m_words.assign(storage_size(m_texel_count, format), 0);
+                for (size_t i = 0; i < m_texel_count; ++i)
+                {
+                    converted.write(i, read(i));
+                }
+                *this = std::move(converted);
+            }
+
+            texture_format format() const
+            {
+                return m_format;
+            }
+
+            //! Reorders texels of all the levels.
+            void set_layout(texture_layout layout)
+            {
+                if (layout == m_layout)
+                {
+                    return;
+                }
+
+                own();
+                std::vector<level_info> levels;
+                size_t size = 0;
+                for (const level_info& level : m_levels)
+                {
+                    levels.push_back(make_level(level.width, level.height, level.depth, size, layout));
+                    size += level_size(levels.back());
+                }
+
+                texture_image reordered(*this);
+                reordered.m_layout = layout;
+                reordered.m_levels = levels;
+                reordered.m_texel_count = size;
+                reordered.m_words.assign(storage_size(size, m_format), 0);
+
+                for (unsigned level = 0; level < this->levels(); ++level)
+                {
+                    for (unsigned z = 0; z < depth(level); ++z)
+                    {
+                        for (unsigned y = 0; y < height(level); ++y)
+                        {
+                            for (unsigned x = 0; x < width(level); ++x)
+                            {
+                                reordered.write(reordered.index(x, y, z, level), read(index(x, y, z, level)));
+                            }
+                        }
+                    }
+                }
+
+                *this = std::move(reordered);
+            }
+
+            texture_layout layout() const
+            {
+                return m_layout;
+            }
+
+            texture_target target() const
+            {
+                return m_target;
+            }
+
+            unsigned width(unsigned level = 0) const
+            {
+                return m_levels[level].width;
+            }
+
+            unsigned height(unsigned level = 0) const
+            {
+                return m_levels[level].height;
+            }
+
+            unsigned depth(unsigned level = 0) const
+            {
+                return m_levels[level].depth;
+            }
+
+            //! Number of levels, 0 for empty images.
+            unsigned levels() const
+            {
+                return static_cast<unsigned>(m_levels.size());
+            }
+
+            const level_info& level(unsigned level) const
+            {
+                return m_levels[level];
+            }
+
+            bool empty() const
+            {
+                return m_texel_count == 0;
+            }
+
+            //! All the levels, one after another.
+            const word_type* data() const
+            {
+                return m_borrowed ? m_borrowed : m_words.data();
+            }
+
+            //! Length of data(), in words.
+            size_t data_size() const
+            {
+                return storage_size(m_texel_count, m_format);
+            }
+
+            //! Whether texels are borrowed from an external storage.
+            bool borrowed() const
+            {
+                return m_borrowed != nullptr;
+            }
+
+            //! Position of the texel; in words for rgba8, bytes for r8, two and four word units for rgba16f
+            //! and rgba32f respectively.
+            size_t index(unsigned x, unsigned y, unsigned level = 0) const
+            {
+                return index(m_levels[level], m_layout, x, y);
+            }
+
+            //! Same as above, within slice (face) z.
+            size_t index(unsigned x, unsigned y, unsigned z, unsigned level) const
+            {
+                return index(x, y, level) + z * m_levels[level].slice_pitch;
+            }
+
+            std::array<float, 4> read(unsigned x, unsigned y, unsigned level = 0) const
+            {
+                return read(index(x, y, level));
+            }
+
+            std::array<float, 4> read(unsigned x, unsigned y, unsigned z, unsigned level) const
+            {
+                return read(index(x, y, z, level));
+            }
+
+            //! The texel as packed RGBA8, whatever the format.
+            texel_type texel(unsigned x, unsigned y, unsigned level = 0) const
+            {
+                return texel(index(x, y, level));
+            }
+
+            texel_type texel(unsigned x, unsigned y, unsigned z, unsigned level) const
+            {
+                return texel(index(x, y, z, level));
+            }
+
+            //! The texel at index (as returned by index()), decoded, going through the per-thread cache of
+            //! decoded blocks; a block is cache_block_texels consecutive texels, i.e. a tile of tiled levels.
+            //! Indices cover all the levels, so blocks of different levels never collide.
+            const std::array<float, 4>& cached_texel(size_t index) const
+            {
+                const texture_image* image = this;
+                return block_cache::lookup(m_id, index / cache_block_texels, [image](size_t block, std::array<float, 4>* texels)
+                {
+                    for (size_t i = 0, first = block * cache_block_texels; i < cache_block_texels; ++i)
+                    {
+                        // the last block may go past the end
+                        texels[i] = first + i < image->m_texel_count ? image->read(first + i) : std::array<float, 4>();
+                    }
+                })[index % cache_block_texels];
+            }
+
+            //! Hits and misses of cached_texel calls of the calling thread.
+            static detail::block_cache_stats& cache_stats()
+            {
+                return block_cache::stats();
+            }
+
+            //! A level of the layout starting at offset (in texels); each level of an image starts where the
+            //! previous one ends.
+            static level_info make_level(unsigned width, unsigned height, unsigned depth, size_t offset, texture_layout layout)
+            {
+                unsigned pitch = layout == texture_layout::tiled ? (width + tile_size - 1) / tile_size * tile_size * tile_size : width;
+                unsigned rows = layout == texture_layout::tiled ? (height + tile_size - 1) / tile_size : height;
+                return level_info{ width, height, depth, offset, pitch, static_cast<size_t>(rows) * pitch };
+            }
+
+            //! Texels of the level, padding of tiles included.
+            static size_t level_size(const level_info& level)
+            {
+                return level.slice_pitch * level.depth;
+            }
+
+        private:
+            static const size_t cache_block_texels = tile_size * tile_size;
+            //! 8 KB of decoded texels.
+            typedef detail::block_cache<std::array<float, 4>, 32, cache_block_texels> block_cache;
+
+            //! Makes borrowed texels owned; called before any modification, so it also makes cached blocks
+            //! of the image stale.
+            void own()
+            {
+                m_id = detail::next_block_cache_owner();
+                if (m_borrowed)
+                {
+                    m_words.assign(m_borrowed, m_borrowed + data_size());
+                    m_borrowed = nullptr;
+                    m_storage.reset();
+                }
+            }
+
+            static size_t storage_size(size_t texel_count, texture_format format)
+            {
+                switch (format)
+                {
+                case texture_format::r8:
+                    // SIMD loads 32 bits at a time, so there needs to be some space after the last texel
+                    return (texel_count + 3) / 4 + 1;
+                case texture_format::rgba16f:
+                    return texel_count * 2;
+                case texture_format::rgba32f:
+                    return texel_count * 4;
+                case texture_format::rgba8:
+                default:
+                    return texel_count;
+                }
+            }
+
+            texel_type texel(size_t index) const
+            {
+                if (m_format == texture_format::rgba8)
+                {
+                    return data()[index];
+                }
+                std::array<float, 4> rgba = read(index);
+                return std::packUnorm4x8(rgba[0], rgba[1], rgba[2], rgba[3]);
+            }
+
+            std::array<float, 4> read(size_t index) const
+            {
+                using namespace std;
+
+                const word_type* words = data();
+                switch (m_format)
+                {
+                case texture_format::r8:
+                    {
+                        word_type word = words[index / 4] >> ((index % 4) * 8);
+                        return { { unpackUnorm4x8(word, 0), 0.0f, 0.0f, 1.0f } };
+                    }
+                case texture_format::rgba16f:
+                    {
+                        word_type rg = words[index * 2], ba = words[index * 2 + 1];
+                        return { { unpackHalf2x16(rg, 0), unpackHalf2x16(rg, 1), unpackHalf2x16(ba, 0), unpackHalf2x16(ba, 1) } };
+                    }
+                case texture_format::rgba32f:
+                    {
+                        const word_type* texel = &words[index * 4];
+                        return { { uintBitsToFloat(texel[0]), uintBitsToFloat(texel[1]), uintBitsToFloat(texel[2]), uintBitsToFloat(texel[3]) } };
+                    }
+                case texture_format::rgba8:
+                default:
+                    {
+                        word_type word = words[index];
+                        return { { unpackUnorm4x8(word, 0), unpackUnorm4x8(word, 1), unpackUnorm4x8(word, 2), unpackUnorm4x8(word, 3) } };
+                    }
+                }
+            }
+
+            void write(size_t index, const std::array<float, 4>& rgba)
+            {
+                using namespace std;
+
+                switch (m_format)
+                {
+                case texture_format::r8:
+                    {
+                        unsigned shift = (index % 4) * 8;
+                        word_type& word = m_words[index / 4];
+                        word = (word & ~(0xffu << shift)) | ((packUnorm4x8(rgba[0], 0, 0, 0) & 0xffu) << shift);
+                    }
+                    break;
+                case texture_format::rgba16f:
+                    m_words[index * 2] = packHalf2x16(rgba[0], rgba[1]);
+                    m_words[index * 2 + 1] = packHalf2x16(rgba[2], rgba[3]);
+                    break;
+                case texture_format::rgba32f:
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        m_words[index * 4 + i] = floatBitsToUint(rgba[i]);
+                    }
+                    break;
+                case texture_format::rgba8:
+                default:
+                    m_words[index] = packUnorm4x8(rgba[0], rgba[1], rgba[2], rgba[3]);
+                    break;
+                }
+            }
+
+            static size_t index(const level_info& level, texture_layout layout, unsigned x, unsigned y)
+            {
+                if (layout == texture_layout::tiled)
+                {
+                    unsigned tile_x = x / tile_size;
+                    unsigned tile_y = y / tile_size;
+                    return level.offset + static_cast<size_t>(tile_y) * level.pitch + tile_x * tile_size * tile_size +
+                        (y - tile_y * tile_size) * tile_size + (x - tile_x * tile_size);
+                }
+                return level.offset + static_cast<size_t>(y) * level.pitch + x;
+            }
+
+            //! Writes the average of count texels to target.
+            void average(const size_t* sources, unsigned count, size_t target)
+            {
+                if (m_format == texture_format::rgba8)
+                {
+                    // exact integer rounding
+                    texel_type result = 0;
+                    for (unsigned shift = 0; shift < 32; shift += 8)
+                    {
+                        texel_type sum = 0;
+                        for (unsigned i = 0; i < count; ++i)
+                        {
+                            sum += (m_words[sources[i]] >> shift) & 0xffu;
+                        }
+                        result |= ((sum + count / 2) / count) << shift;
+                    }
+                    m_words[target] = result;
+                    return;
+                }
+
+                std::array<float, 4> result = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+                for (unsigned i = 0; i < count; ++i)
+                {
+                    std::array<float, 4> texel = read(sources[i]);
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        result[c] += texel[c];
+                    }
+                }
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    result[c] /= static_cast<float>(count);
+                }
+                write(target, result);
+            }
+
+            //! Extracts a channel and expands it to 8 bits (5 bit red of RGB565 and the like).
+            class channel_decoder
+            {
+            public:
+                channel_decoder(uint32_t mask, texel_type missing)
+                    : m_mask(mask)
+                    , m_shift(0)
+                    , m_missing(missing)
+                {
+                    if (mask)
+                    {
+                        while (!((mask >> m_shift) & 1u))
+                        {
+                            ++m_shift;
+                        }
+                    }
+                }
+
+                texel_type operator()(uint32_t pixel) const
+                {
+                    if (!m_mask)
+                    {
+                        return m_missing;
+                    }
+                    uint32_t max = m_mask >> m_shift;
+                    uint32_t value = (pixel & m_mask) >> m_shift;
+                    return max == 255u ? value : static_cast<texel_type>((static_cast<uint64_t>(value) * 255u + max / 2) / max);
+                }
+
+            private:
+                uint32_t m_mask;
+                unsigned m_shift;
+                texel_type m_missing;
+            };
+
+            texture_target m_target;
+            texture_layout m_layout;
+            texture_format m_format;
+            //! Including padding of tiled levels.
+            size_t m_texel_count;
+            std::vector<level_info> m_levels;
+            std::vector<word_type> m_words;
+            std::shared_ptr<const void> m_storage;
+            const word_type* m_borrowed = nullptr;
+            //! Identifies blocks in the cache.
+            unsigned m_id = detail::next_block_cache_owner();
+        };
+    }
+}
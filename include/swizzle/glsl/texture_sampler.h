@@ -0,0 +1,900 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <swizzle/detail/vector_traits.h>
+#include <swizzle/glsl/vector.h>
+#include <swizzle/glsl/texture_functions.h>
+#include <swizzle/glsl/texture_image.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        enum class wrap_mode
+        {
+            clamp,
+            repeat,
+            mirror_repeat
+        };
+
+        //! Same meaning as GL_TEXTURE_MIN_FILTER / GL_TEXTURE_MAG_FILTER values; magnification
+        //! can only be nearest or linear.
+        enum class texture_filter
+        {
+            nearest,
+            linear,
+            nearest_mipmap_nearest,
+            linear_mipmap_nearest,
+            nearest_mipmap_linear,
+            linear_mipmap_linear
+        };
+
+        //! Fetches texels of an Image for samplers; specialised for each image type. A fetcher gets texel
+        //! coordinates (integral, already wrapped) and the level's offset (of the slice, if any), pitch and height,
+        //! as found in the image's level infos, for all the lanes at once; offsets and pitches are integers, so
+        //! that addresses are exact however large the image is. it returns either vec4_type or, for single channel
+        //! images, float_type. Fetchers can optionally go through the image's per-thread cache of decoded
+        //! blocks (set_cached), which pays off when decoding costs more than a cache lookup per lane.
+        template <class Image, class FloatType>
+        class texel_fetcher;
+
+        //! Each lane fetches its texel with a gather per word and channels are unpacked with vector shifts;
+        //! no per-lane work apart from the load itself. Both texture layouts are supported; addresses of tiled
+        //! ones just take a few more multiply-adds. Positions within a row (of tiles) are computed in float_type,
+        //! the rest of the address in uint_type. Cached fetches look each lane's texel up in the block cache
+        //! instead, once per texel.
+        template <class FloatType>
+        class texel_fetcher<texture_image, FloatType>
+        {
+        public:
+            typedef FloatType float_type;
+            typedef typename detail::bits_traits<FloatType>::uint_type uint_type;
+            typedef vector<FloatType, 4> vec4_type;
+
+            explicit texel_fetcher(const texture_image& image)
+                : m_image(&image)
+                , m_data(image.data())
+                , m_format(image.format())
+                , m_tiled(image.layout() == texture_layout::tiled)
+                , m_cached(false)
+            {
+                // addresses are 32 bit; single channel images are addressed in bytes
+                if (image.data_size() > 0x3fffffffu)
+                {
+                    throw std::invalid_argument("Texture is too large to be sampled");
+                }
+            }
+
+            bool single_channel() const
+            {
+                return m_format == texture_format::r8;
+            }
+
+            void set_cached(bool cached)
+            {
+                m_cached = cached;
+            }
+
+            template <class Texel>
+            Texel fetch(const uint_type& offset, const uint_type& pitch, const float_type&, const float_type& x, const float_type& y) const
+            {
+                using namespace std;
+
+                uint_type index;
+                if (m_tiled)
+                {
+                    const float tile_size = static_cast<float>(texture_image::tile_size);
+                    float_type tile_x = floor(x * (1.0f / tile_size));
+                    float_type tile_y = floor(y * (1.0f / tile_size));
+                    float_type in_tile = mad(y - tile_y * tile_size, float_type(tile_size), x - tile_x * tile_size);
+                    index = offset + floatToUint(tile_y) * pitch + floatToUint(mad(tile_x, float_type(tile_size * tile_size), in_tile));
+                }
+                else
+                {
+                    index = offset + floatToUint(y) * pitch + floatToUint(x);
+                }
+                if (m_cached)
+                {
+                    return decode_cached(index, static_cast<Texel*>(nullptr));
+                }
+                return decode(index, static_cast<Texel*>(nullptr));
+            }
+
+        private:
+            float_type decode_cached(const uint_type& index, float_type*) const
+            {
+                using namespace std;
+                const texture_image* image = m_image;
+                return uintBitsToFloat(gatherWith([image](unsigned i) { return std::floatBitsToUint(image->cached_texel(i)[0]); }, index));
+            }
+
+            vec4_type decode_cached(const uint_type& index, vec4_type*) const
+            {
+                using namespace std;
+                const texture_image* image = m_image;
+                float_type channels[4];
+                gatherChannelsWith([image](unsigned i) -> const std::array<float, 4>& { return image->cached_texel(i); }, index, channels);
+                return vec4_type(channels[0], channels[1], channels[2], channels[3]);
+            }
+
+            float_type decode(const uint_type& index, float_type*) const
+            {
+                using namespace std;
+                return unpackUnorm4x8(gatherByte(m_data, index), 0);
+            }
+
+            vec4_type decode(const uint_type& index, vec4_type*) const
+            {
+                using namespace std;
+
+                switch (m_format)
+                {
+                case texture_format::rgba16f:
+                    {
+                        uint_type rg = gather(m_data, index * 2u);
+                        uint_type ba = gather(m_data, index * 2u + 1u);
+                        return vec4_type(unpackHalf2x16(rg, 0), unpackHalf2x16(rg, 1), unpackHalf2x16(ba, 0), unpackHalf2x16(ba, 1));
+                    }
+                case texture_format::rgba32f:
+                    {
+                        uint_type first = index * 4u;
+                        return vec4_type(uintBitsToFloat(gather(m_data, first)), uintBitsToFloat(gather(m_data, first + 1u)),
+                            uintBitsToFloat(gather(m_data, first + 2u)), uintBitsToFloat(gather(m_data, first + 3u)));
+                    }
+                case texture_format::rgba8:
+                default:
+                    {
+                        uint_type texel = gather(m_data, index);
+                        return vec4_type(unpackUnorm4x8(texel, 0), unpackUnorm4x8(texel, 1), unpackUnorm4x8(texel, 2), unpackUnorm4x8(texel, 3));
+                    }
+                }
+            }
+
+            const texture_image* m_image;
+            const texture_image::word_type* m_data;
+            texture_format m_format;
+            bool m_tiled;
+            bool m_cached;
+        };
+
+        //! What samplers of all the targets share, for scalar and SIMD float types alike. Addresses are computed
+        //! for all the lanes at once and texels are fetched by texel_fetcher<Image>. Single channel images are
+        //! filtered as scalars, so they cost a quarter of the math as well as of the bandwidth. Lanes may end up
+        //! sampling different mip levels, so level sizes and offsets are gathered too. Volumes and cube maps
+        //! are sampled as 2D footprints of one or two slices of a level.
+        //! Needs scalar_support.h (and simd_support_vc.h for SIMD) to be included first.
+        template <class FloatType, class Image>
+        class basic_sampler_base : public texture_functions::tag
+        {
+        public:
+            typedef FloatType float_type;
+            typedef Image image_type;
+            typedef typename detail::bits_traits<FloatType>::uint_type uint_type;
+            typedef vector<FloatType, 2> vec2_type;
+            typedef vector<FloatType, 4> vec4_type;
+
+            const Image& image() const
+            {
+                return *m_image;
+            }
+
+            //! Whether texels are fetched through the per-thread cache of decoded blocks of the image (off by
+            //! default). Worth it for formats that are expensive to decode and for shaders that keep sampling
+            //! the same neighbourhood, e.g. noise octaves; hit rates are in Image::cache_stats().
+            void set_texel_cache(bool enabled)
+            {
+                m_fetcher.set_cached(enabled);
+            }
+
+        protected:
+            enum mip_filter
+            {
+                mip_none,
+                mip_nearest,
+                mip_linear
+            };
+
+            //! How the third coordinate picks slices of a level.
+            enum slice_mode
+            {
+                //! 2D images have just the one.
+                slice_none,
+                //! Filtered (and wrapped) like the other two coordinates.
+                slice_volume,
+                //! The third coordinate is an integral slice index, e.g. a cube face.
+                slice_layer
+            };
+
+            //! Where a 2D footprint is taken from: the third coordinate (unused with slice_none) and an offset,
+            //! in texels, which is the same for all the lanes.
+            struct footprint
+            {
+                slice_mode slices;
+                float_type r;
+                float offset[3];
+            };
+
+            basic_sampler_base(std::shared_ptr<const Image> image, wrap_mode wrap, texture_filter min_filter, texture_filter mag_filter)
+                : m_image(checked(std::move(image)))
+                , m_fetcher(*m_image)
+                , m_wrap(wrap)
+                , m_linear_min(min_filter == texture_filter::linear || min_filter == texture_filter::linear_mipmap_nearest || min_filter == texture_filter::linear_mipmap_linear)
+                , m_linear_mag(mag_filter == texture_filter::linear)
+                , m_mip_filter(min_filter == texture_filter::nearest || min_filter == texture_filter::linear ? mip_none :
+                    (min_filter == texture_filter::nearest_mipmap_nearest || min_filter == texture_filter::linear_mipmap_nearest ? mip_nearest : mip_linear))
+                , m_depth(1.0f)
+                , m_slice_pitch(0)
+            {
+                if (mag_filter != texture_filter::nearest && mag_filter != texture_filter::linear)
+                {
+                    throw std::invalid_argument("Magnification filter can only be nearest or linear");
+                }
+
+                m_width = static_cast<float>(m_image->width());
+                m_height = static_cast<float>(m_image->height());
+                m_pitch = m_image->level(0).pitch;
+                m_max_level = static_cast<float>(m_mip_filter == mip_none ? 0 : m_image->levels() - 1);
+
+                // tables for gathering
+                for (unsigned i = 0; i < m_image->levels(); ++i)
+                {
+                    m_level_widths.push_back(static_cast<float>(m_image->level(i).width));
+                    m_level_heights.push_back(static_cast<float>(m_image->level(i).height));
+                    m_level_offsets.push_back(static_cast<unsigned>(m_image->level(i).offset));
+                    m_level_pitches.push_back(m_image->level(i).pitch);
+                }
+            }
+
+            //! For images with slices; checks the target and fills the tables of slice counts and pitches.
+            void init_slices(texture_target target)
+            {
+                if (m_image->target() != target)
+                {
+                    throw std::invalid_argument("Texture target does not match the sampler");
+                }
+
+                m_depth = static_cast<float>(m_image->depth());
+                m_slice_pitch = static_cast<unsigned>(m_image->level(0).slice_pitch);
+                for (unsigned i = 0; i < m_image->levels(); ++i)
+                {
+                    m_level_depths.push_back(static_cast<float>(m_image->level(i).depth));
+                    m_level_slice_pitches.push_back(static_cast<unsigned>(m_image->level(i).slice_pitch));
+                }
+            }
+
+            static footprint make_footprint(slice_mode slices, const float_type& r, float offset_x = 0.0f, float offset_y = 0.0f, float offset_z = 0.0f)
+            {
+                footprint result = { slices, r, { offset_x, offset_y, offset_z } };
+                return result;
+            }
+
+            bool lod_ignored() const
+            {
+                return m_max_level == 0 && m_linear_min == m_linear_mag;
+            }
+
+            //! Lod of a footprint whose squared size (in texels) is rho2.
+            static float_type lod(const float_type& rho2)
+            {
+                using namespace std;
+                // no differences at all means no information, hence lod 0 (rather than -inf); log2(sqrt(x)) == 0.5 * log2(x)
+                return 0.5f * log2(rho2 + (1.0f - step(float_type(0.0f), rho2)));
+            }
+
+            unsigned clamped_level(int level) const
+            {
+                return static_cast<unsigned>(std::min(std::max(level, 0), static_cast<int>(m_image->levels()) - 1));
+            }
+
+            vec4_type sample_rgba(const vec2_type& coord, const footprint& where, const float_type& lod) const
+            {
+                if (m_fetcher.single_channel())
+                {
+                    return vec4_type(sample_lod<float_type>(coord, where, lod), 0.0f, 0.0f, 1.0f);
+                }
+                return sample_lod<vec4_type>(coord, where, lod);
+            }
+
+            //! Texel coordinates are integral; out of range ones (undefined in GLSL) get clamped.
+            vec4_type fetch_rgba(const vec2_type& coord, const footprint& where, int lod) const
+            {
+                using namespace std;
+
+                unsigned level = clamped_level(lod);
+                float width = m_level_widths[level];
+                float height = m_level_heights[level];
+                uint_type offset = m_level_offsets[level];
+                if (where.slices != slice_none)
+                {
+                    offset += floatToUint(min(max(where.r, float_type(0.0f)), float_type(m_level_depths[level] - 1.0f))) * m_level_slice_pitches[level];
+                }
+
+                float_type x = min(max(float_type(coord.x), float_type(0.0f)), float_type(width - 1.0f));
+                float_type y = min(max(float_type(coord.y), float_type(0.0f)), float_type(height - 1.0f));
+                if (m_fetcher.single_channel())
+                {
+                    return vec4_type(m_fetcher.template fetch<float_type>(offset, uint_type(m_level_pitches[level]), height, x, y), 0.0f, 0.0f, 1.0f);
+                }
+                return m_fetcher.template fetch<vec4_type>(offset, uint_type(m_level_pitches[level]), height, x, y);
+            }
+
+            //! The component of the four texels bilinear filtering of the base level would blend, in the order
+            //! of textureGather: (0, 1), (1, 1), (1, 0), (0, 0).
+            vec4_type gather_rgba(const vec2_type& coord, const footprint& where, int component) const
+            {
+                using namespace std;
+
+                float_type width = m_width;
+                float_type height = m_height;
+                uint_type pitch = m_pitch;
+                uint_type offset = 0u;
+                if (where.slices == slice_layer)
+                {
+                    offset = floatToUint(where.r) * m_slice_pitch;
+                }
+
+                float_type x0 = floor(coord.x * width + (where.offset[0] - 0.5f));
+                float_type y0 = floor(coord.y * height + (where.offset[1] - 0.5f));
+                float_type x1 = wrap(x0 + 1.0f, width);
+                float_type y1 = wrap(y0 + 1.0f, height);
+                x0 = wrap(x0, width);
+                y0 = wrap(y0, height);
+
+                if (m_fetcher.single_channel())
+                {
+                    if (component != 0)
+                    {
+                        return vec4_type(component == 3 ? 1.0f : 0.0f);
+                    }
+                    return vec4_type(m_fetcher.template fetch<float_type>(offset, pitch, height, x0, y1), m_fetcher.template fetch<float_type>(offset, pitch, height, x1, y1),
+                        m_fetcher.template fetch<float_type>(offset, pitch, height, x1, y0), m_fetcher.template fetch<float_type>(offset, pitch, height, x0, y0));
+                }
+
+                size_t c = static_cast<size_t>(std::min(std::max(component, 0), 3));
+                return vec4_type(m_fetcher.template fetch<vec4_type>(offset, pitch, height, x0, y1)[c], m_fetcher.template fetch<vec4_type>(offset, pitch, height, x1, y1)[c],
+                    m_fetcher.template fetch<vec4_type>(offset, pitch, height, x1, y0)[c], m_fetcher.template fetch<vec4_type>(offset, pitch, height, x0, y0)[c]);
+            }
+
+            std::shared_ptr<const Image> m_image;
+            texel_fetcher<Image, FloatType> m_fetcher;
+            wrap_mode m_wrap;
+            bool m_linear_min;
+            bool m_linear_mag;
+            mip_filter m_mip_filter;
+            float m_width;
+            float m_height;
+            float m_depth;
+            unsigned m_pitch;
+            unsigned m_slice_pitch;
+            float m_max_level;
+            std::vector<float> m_level_widths;
+            std::vector<float> m_level_heights;
+            std::vector<float> m_level_depths;
+            std::vector<unsigned> m_level_offsets;
+            std::vector<unsigned> m_level_pitches;
+            std::vector<unsigned> m_level_slice_pitches;
+
+        private:
+            static std::shared_ptr<const Image> checked(std::shared_ptr<const Image> image)
+            {
+                if (!image || image->empty())
+                {
+                    throw std::invalid_argument("Sampler needs a non-empty texture");
+                }
+                return image;
+            }
+
+            //! Texel is either vec4_type or, for single channel formats, float_type.
+            template <class Texel>
+            Texel sample_lod(const vec2_type& coord, const footprint& where, const float_type& lod) const
+            {
+                using namespace std;
+
+                if (lod_ignored())
+                {
+                    return sample_level<Texel>(coord, where, float_type(0.0f), float_type(0.0f), 0);
+                }
+
+                // 1 for lanes getting minified
+                float_type minified = step(float_type(0.0f), lod);
+                float_type level = min(max(lod, float_type(0.0f)), float_type(m_max_level));
+
+                switch (m_mip_filter)
+                {
+                case mip_nearest:
+                    return sample_level<Texel>(coord, where, floor(level + 0.5f), minified, m_max_level);
+                case mip_linear:
+                    {
+                        float_type level0 = floor(level);
+                        float_type level1 = min(level0 + 1.0f, float_type(m_max_level));
+                        Texel a = sample_level<Texel>(coord, where, level0, minified, m_max_level);
+                        Texel b = sample_level<Texel>(coord, where, level1, minified, m_max_level);
+                        return a + (b - a) * (level - level0);
+                    }
+                case mip_none:
+                default:
+                    return sample_level<Texel>(coord, where, float_type(0.0f), minified, 0);
+                }
+            }
+
+            //! max_level being 0 means level is known to be 0 for all the lanes.
+            template <class Texel>
+            Texel sample_level(const vec2_type& coord, const footprint& where, const float_type& level, const float_type& minified, float max_level) const
+            {
+                using namespace std;
+
+                float_type width = m_width;
+                float_type height = m_height;
+                float_type depth = m_depth;
+                uint_type offset = 0u;
+                uint_type pitch = m_pitch;
+                uint_type slice_pitch = m_slice_pitch;
+                if (max_level > 0)
+                {
+                    uint_type index = floatToUint(level);
+                    width = gather(m_level_widths.data(), index);
+                    height = gather(m_level_heights.data(), index);
+                    offset = gather(m_level_offsets.data(), index);
+                    pitch = gather(m_level_pitches.data(), index);
+                    if (where.slices != slice_none)
+                    {
+                        depth = gather(m_level_depths.data(), index);
+                        slice_pitch = gather(m_level_slice_pitches.data(), index);
+                    }
+                }
+
+                const bool linear = m_linear_min || m_linear_mag;
+                float_type u = coord.x * width;
+                float_type v = coord.y * height;
+                if (where.offset[0] != 0.0f || where.offset[1] != 0.0f)
+                {
+                    u += where.offset[0];
+                    v += where.offset[1];
+                }
+
+                // volumes get filtered between two slices, unless filtering is nearest
+                uint_type next_offset = offset;
+                float_type fz = 0.0f;
+                bool two_slices = false;
+                if (where.slices == slice_layer)
+                {
+                    offset += floatToUint(where.r) * slice_pitch;
+                }
+                else if (where.slices == slice_volume)
+                {
+                    float_type w = where.r * depth + where.offset[2];
+                    if (linear)
+                    {
+                        w -= 0.5f;
+                        float_type z0 = floor(w);
+                        fz = filter_weight(w - z0, minified);
+                        next_offset += floatToUint(wrap(z0 + 1.0f, depth)) * slice_pitch;
+                        offset += floatToUint(wrap(z0, depth)) * slice_pitch;
+                        two_slices = true;
+                    }
+                    else
+                    {
+                        offset += floatToUint(wrap(floor(w), depth)) * slice_pitch;
+                    }
+                }
+
+                if (!linear)
+                {
+                    return m_fetcher.template fetch<Texel>(offset, pitch, height, wrap(floor(u), width), wrap(floor(v), height));
+                }
+
+                u -= 0.5f;
+                v -= 0.5f;
+                float_type x0 = floor(u);
+                float_type y0 = floor(v);
+                float_type fx = filter_weight(u - x0, minified);
+                float_type fy = filter_weight(v - y0, minified);
+
+                float_type x1 = wrap(x0 + 1.0f, width);
+                float_type y1 = wrap(y0 + 1.0f, height);
+                x0 = wrap(x0, width);
+                y0 = wrap(y0, height);
+
+                Texel result = filter_slice<Texel>(offset, pitch, height, x0, x1, y0, y1, fx, fy);
+                if (two_slices)
+                {
+                    Texel next = filter_slice<Texel>(next_offset, pitch, height, x0, x1, y0, y1, fx, fy);
+                    result = result + (next - result) * fz;
+                }
+                return result;
+            }
+
+            template <class Texel>
+            Texel filter_slice(const uint_type& offset, const uint_type& pitch, const float_type& height, const float_type& x0, const float_type& x1,
+                const float_type& y0, const float_type& y1, const float_type& fx, const float_type& fy) const
+            {
+                Texel t00 = m_fetcher.template fetch<Texel>(offset, pitch, height, x0, y0);
+                Texel t10 = m_fetcher.template fetch<Texel>(offset, pitch, height, x1, y0);
+                Texel t01 = m_fetcher.template fetch<Texel>(offset, pitch, height, x0, y1);
+                Texel t11 = m_fetcher.template fetch<Texel>(offset, pitch, height, x1, y1);
+
+                Texel bottom = t00 + (t10 - t00) * fx;
+                Texel top = t01 + (t11 - t01) * fx;
+                return bottom + (top - bottom) * fy;
+            }
+
+            //! Nearest filtering is linear filtering with weights snapped to the closer texel.
+            float_type filter_weight(const float_type& f, const float_type& minified) const
+            {
+                using namespace std;
+
+                float_type snapped = 1.0f - step(f, float_type(0.5f));
+                float_type mag_weight = m_linear_mag ? f : snapped;
+                float_type min_weight = m_linear_min ? f : snapped;
+                return m_linear_mag == m_linear_min ? mag_weight : mag_weight + (min_weight - mag_weight) * minified;
+            }
+
+            //! Maps integral texel coordinate to [0;size).
+            float_type wrap(const float_type& x, const float_type& size) const
+            {
+                using namespace std;
+
+                float_type result;
+                switch (m_wrap)
+                {
+                case wrap_mode::repeat:
+                    result = x - size * floor(x / size);
+                    break;
+                case wrap_mode::mirror_repeat:
+                    {
+                        float_type period = size * 2.0f;
+                        float_type t = x - period * floor(x / period);
+                        result = min(t, period - 1.0f - t);
+                    }
+                    break;
+                case wrap_mode::clamp:
+                default:
+                    result = x;
+                    break;
+                }
+                // clamping covers both the edge and rounding errors of huge coordinates
+                return min(max(result, float_type(0.0f)), size - 1.0f);
+            }
+        };
+
+        //! A sampler of a 2D Image (texture_image by default).
+        //! The level of detail comes from differences between neighbouring lanes (i.e. horizontal derivatives;
+        //! the vertical ones are assumed to be the same). Scalars have no neighbours, so for them lod is 0
+        //! plus bias, unless given explicitly (or with gradients).
+        template <class FloatType, class Image = texture_image>
+        class basic_sampler2D : public basic_sampler_base<FloatType, Image>
+        {
+            typedef basic_sampler_base<FloatType, Image> base_type;
+
+        public:
+            typedef typename base_type::float_type float_type;
+            typedef typename base_type::vec2_type vec2_type;
+            typedef typename base_type::vec4_type vec4_type;
+            typedef const vec2_type& tex_coord_type;
+            typedef const vector<int, 2>& tex_offset_type;
+            typedef const vec2_type& tex_grad_type;
+            //! Integral texel coordinates; floats, as lanes have no integer vectors.
+            typedef const vec2_type& tex_fetch_type;
+
+            basic_sampler2D(std::shared_ptr<const Image> image, wrap_mode wrap,
+                texture_filter min_filter = texture_filter::nearest, texture_filter mag_filter = texture_filter::nearest)
+                : base_type(std::move(image), wrap, min_filter, mag_filter)
+            {}
+
+            vec4_type sample(tex_coord_type coord) const
+            {
+                return sample(coord, 0.0f);
+            }
+
+            vec4_type sample(tex_coord_type coord, float bias) const
+            {
+                return sample(coord, flat(), bias);
+            }
+
+            //! Lod is log2 of texels per pixel; positive values minify.
+            vec4_type sampleLod(tex_coord_type coord, const float_type& lod) const
+            {
+                return this->sample_rgba(coord, flat(), lod);
+            }
+
+            vec4_type sampleOffset(tex_coord_type coord, tex_offset_type offset, float bias = 0.0f) const
+            {
+                return sample(coord, flat(offset), bias);
+            }
+
+            //! Lod comes from the larger of the two derivatives, as with GL.
+            vec4_type sampleGrad(tex_coord_type coord, tex_grad_type dPdx, tex_grad_type dPdy) const
+            {
+                using namespace std;
+
+                if (this->lod_ignored())
+                {
+                    return sampleLod(coord, float_type(0.0f));
+                }
+                return sampleLod(coord, base_type::lod(max(rho2(dPdx), rho2(dPdy))));
+            }
+
+            vec4_type fetch(tex_fetch_type coord, int lod) const
+            {
+                return this->fetch_rgba(coord, flat(), lod);
+            }
+
+            vector<int, 2> size(int lod) const
+            {
+                unsigned level = this->clamped_level(lod);
+                return vector<int, 2>(static_cast<int>(this->image().width(level)), static_cast<int>(this->image().height(level)));
+            }
+
+            vec4_type sampleGather(tex_coord_type coord, int component = 0) const
+            {
+                return this->gather_rgba(coord, flat(), component);
+            }
+
+        private:
+            typedef typename base_type::footprint footprint;
+
+            static footprint flat()
+            {
+                return base_type::make_footprint(base_type::slice_none, float_type(0.0f));
+            }
+
+            static footprint flat(tex_offset_type offset)
+            {
+                return base_type::make_footprint(base_type::slice_none, float_type(0.0f), static_cast<float>(offset.x), static_cast<float>(offset.y));
+            }
+
+            vec4_type sample(tex_coord_type coord, const footprint& where, float bias) const
+            {
+                using namespace std;
+
+                if (this->lod_ignored())
+                {
+                    return this->sample_rgba(coord, where, float_type(0.0f));
+                }
+                return this->sample_rgba(coord, where, base_type::lod(rho2(vec2_type(laneDifference(coord.x), laneDifference(coord.y)))) + bias);
+            }
+
+            //! Squared length of a difference of coordinates, in texels.
+            float_type rho2(const vec2_type& d) const
+            {
+                float_type dx = d.x * this->m_width;
+                float_type dy = d.y * this->m_height;
+                return dx * dx + dy * dy;
+            }
+        };
+
+        //! A sampler of a 3D texture_image: filtering and wrapping along the depth work the same way they do
+        //! along the other axes and mip levels get smaller in all three dimensions.
+        template <class FloatType>
+        class basic_sampler3D : public basic_sampler_base<FloatType, texture_image>
+        {
+            typedef basic_sampler_base<FloatType, texture_image> base_type;
+
+        public:
+            typedef typename base_type::float_type float_type;
+            typedef typename base_type::vec2_type vec2_type;
+            typedef vector<FloatType, 3> vec3_type;
+            typedef typename base_type::vec4_type vec4_type;
+            typedef const vec3_type& tex_coord_type;
+            typedef const vector<int, 3>& tex_offset_type;
+            typedef const vec3_type& tex_grad_type;
+            typedef const vec3_type& tex_fetch_type;
+
+            basic_sampler3D(std::shared_ptr<const texture_image> image, wrap_mode wrap,
+                texture_filter min_filter = texture_filter::nearest, texture_filter mag_filter = texture_filter::nearest)
+                : base_type(std::move(image), wrap, min_filter, mag_filter)
+            {
+                this->init_slices(texture_target::texture_3d);
+            }
+
+            vec4_type sample(tex_coord_type coord) const
+            {
+                return sample(coord, 0.0f);
+            }
+
+            vec4_type sample(tex_coord_type coord, float bias) const
+            {
+                return sample(coord, volume(coord), bias);
+            }
+
+            vec4_type sampleLod(tex_coord_type coord, const float_type& lod) const
+            {
+                return this->sample_rgba(vec2_type(coord.x, coord.y), volume(coord), lod);
+            }
+
+            vec4_type sampleOffset(tex_coord_type coord, tex_offset_type offset, float bias = 0.0f) const
+            {
+                return sample(coord, volume(coord, offset), bias);
+            }
+
+            vec4_type sampleGrad(tex_coord_type coord, tex_grad_type dPdx, tex_grad_type dPdy) const
+            {
+                using namespace std;
+
+                if (this->lod_ignored())
+                {
+                    return sampleLod(coord, float_type(0.0f));
+                }
+                return sampleLod(coord, base_type::lod(max(rho2(dPdx), rho2(dPdy))));
+            }
+
+            vec4_type fetch(tex_fetch_type coord, int lod) const
+            {
+                return this->fetch_rgba(vec2_type(coord.x, coord.y), volume(coord), lod);
+            }
+
+            vector<int, 3> size(int lod) const
+            {
+                unsigned level = this->clamped_level(lod);
+                return vector<int, 3>(static_cast<int>(this->image().width(level)), static_cast<int>(this->image().height(level)),
+                    static_cast<int>(this->image().depth(level)));
+            }
+
+        private:
+            typedef typename base_type::footprint footprint;
+
+            static footprint volume(tex_coord_type coord)
+            {
+                return base_type::make_footprint(base_type::slice_volume, coord.z);
+            }
+
+            static footprint volume(tex_coord_type coord, tex_offset_type offset)
+            {
+                return base_type::make_footprint(base_type::slice_volume, coord.z, static_cast<float>(offset.x), static_cast<float>(offset.y), static_cast<float>(offset.z));
+            }
+
+            vec4_type sample(tex_coord_type coord, const footprint& where, float bias) const
+            {
+                using namespace std;
+
+                vec2_type xy(coord.x, coord.y);
+                if (this->lod_ignored())
+                {
+                    return this->sample_rgba(xy, where, float_type(0.0f));
+                }
+                return this->sample_rgba(xy, where, base_type::lod(rho2(vec3_type(laneDifference(coord.x), laneDifference(coord.y), laneDifference(coord.z)))) + bias);
+            }
+
+            float_type rho2(const vec3_type& d) const
+            {
+                float_type dx = d.x * this->m_width;
+                float_type dy = d.y * this->m_height;
+                float_type dz = d.z * this->m_depth;
+                return dx * dx + dy * dy + dz * dz;
+            }
+        };
+
+        //! A sampler of a cube map texture_image. Each lane picks the face of the major axis of its direction,
+        //! with masks rather than branches, and samples it like a 2D texture (as one of the image's slices).
+        //! Faces are clamped to their edges, i.e. filtering does not cross seams; the level of detail is
+        //! based on the length of direction derivatives rather than their projections onto the face.
+        template <class FloatType>
+        class basic_samplerCube : public basic_sampler_base<FloatType, texture_image>
+        {
+            typedef basic_sampler_base<FloatType, texture_image> base_type;
+
+        public:
+            typedef typename base_type::float_type float_type;
+            typedef typename base_type::vec2_type vec2_type;
+            typedef vector<FloatType, 3> vec3_type;
+            typedef typename base_type::vec4_type vec4_type;
+            typedef const vec3_type& tex_coord_type;
+            typedef const vec3_type& tex_grad_type;
+
+            basic_samplerCube(std::shared_ptr<const texture_image> image,
+                texture_filter min_filter = texture_filter::nearest, texture_filter mag_filter = texture_filter::nearest)
+                : base_type(std::move(image), wrap_mode::clamp, min_filter, mag_filter)
+            {
+                this->init_slices(texture_target::texture_cube);
+            }
+
+            vec4_type sample(tex_coord_type direction) const
+            {
+                return sample(direction, 0.0f);
+            }
+
+            vec4_type sample(tex_coord_type direction, float bias) const
+            {
+                using namespace std;
+
+                vec2_type st;
+                float_type face;
+                float_type scale = project(direction, st, face);
+                if (this->lod_ignored())
+                {
+                    return this->sample_rgba(st, layer(face), float_type(0.0f));
+                }
+                return this->sample_rgba(st, layer(face), base_type::lod(rho2(vec3_type(laneDifference(direction.x), laneDifference(direction.y),
+                    laneDifference(direction.z)), scale)) + bias);
+            }
+
+            vec4_type sampleLod(tex_coord_type direction, const float_type& lod) const
+            {
+                vec2_type st;
+                float_type face;
+                project(direction, st, face);
+                return this->sample_rgba(st, layer(face), lod);
+            }
+
+            vec4_type sampleGrad(tex_coord_type direction, tex_grad_type dPdx, tex_grad_type dPdy) const
+            {
+                using namespace std;
+
+                vec2_type st;
+                float_type face;
+                float_type scale = project(direction, st, face);
+                if (this->lod_ignored())
+                {
+                    return this->sample_rgba(st, layer(face), float_type(0.0f));
+                }
+                return this->sample_rgba(st, layer(face), base_type::lod(max(rho2(dPdx, scale), rho2(dPdy, scale))));
+            }
+
+            vector<int, 2> size(int lod) const
+            {
+                unsigned level = this->clamped_level(lod);
+                return vector<int, 2>(static_cast<int>(this->image().width(level)), static_cast<int>(this->image().height(level)));
+            }
+
+            vec4_type sampleGather(tex_coord_type direction, int component = 0) const
+            {
+                vec2_type st;
+                float_type face;
+                project(direction, st, face);
+                return this->gather_rgba(st, layer(face), component);
+            }
+
+        private:
+            typedef typename base_type::footprint footprint;
+
+            static footprint layer(const float_type& face)
+            {
+                return base_type::make_footprint(base_type::slice_layer, face);
+            }
+
+            //! Face coordinates and index (+X, -X, +Y, -Y, +Z, -Z) of the direction, as in the GL spec's table;
+            //! returns texels per unit of direction on the face.
+            float_type project(tex_coord_type direction, vec2_type& st, float_type& face) const
+            {
+                using namespace std;
+
+                float_type x = direction.x;
+                float_type y = direction.y;
+                float_type z = direction.z;
+                float_type ax = abs(x);
+                float_type ay = abs(y);
+                float_type az = abs(z);
+
+                // masks of the major axis; ties go to x, then y (step is strict, so ax >= ay is 1 - step(ax, ay))
+                float_type major_x = (1.0f - step(ax, ay)) * (1.0f - step(ax, az));
+                float_type major_y = (1.0f - major_x) * (1.0f - step(ay, az));
+                float_type major_z = 1.0f - major_x - major_y;
+
+                // 1 for positive directions
+                float_type px = step(0.0f, x);
+                float_type py = step(0.0f, y);
+                float_type pz = step(0.0f, z);
+                face = major_x * (1.0f - px) + major_y * (3.0f - py) + major_z * (5.0f - pz);
+
+                float_type sc = major_y * x - major_x * z * (px * 2.0f - 1.0f) + major_z * x * (pz * 2.0f - 1.0f);
+                float_type tc = major_y * z * (py * 2.0f - 1.0f) - (major_x + major_z) * y;
+                float_type inv_ma = 1.0f / max(major_x * ax + major_y * ay + major_z * az, float_type(1.0e-30f));
+
+                st = vec2_type(mad(sc, inv_ma * 0.5f, float_type(0.5f)), mad(tc, inv_ma * 0.5f, float_type(0.5f)));
+                return inv_ma * (this->m_width * 0.5f);
+            }
+
+            static float_type rho2(const vec3_type& d, const float_type& scale)
+            {
+                float_type dx = d.x;
+                float_type dy = d.y;
+                float_type dz = d.z;
+                return (dx * dx + dy * dy + dz * dz) * scale * scale;
+            }
+        };
+    }
+}
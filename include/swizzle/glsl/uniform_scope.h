@@ -0,0 +1,65 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <swizzle/detail/utils.h>
+
+namespace swizzle
+{
+    namespace glsl
+    {
+        //! Per-frame cache for values that depend on uniforms only (e.g. rotation matrices built out of time).
+        //! Shaders evaluate these for every pixel batch even though they do not change until the host updates
+        //! uniforms; with CXXSWIZZLE_UNIFORM_SCOPE they are evaluated once per frame per thread instead, and with
+        //! SIMD scalars the cached value is already broadcast across all lanes.
+        //! The host needs to call next_frame() whenever uniforms change.
+        class uniform_scope
+        {
+        public:
+            //! Invalidates all the cached values.
+            static void next_frame()
+            {
+                ++frame_counter();
+            }
+
+            //! Returns func's result, calling it only if the frame changed since the last call. Each Func type
+            //! gets its own cache, so with lambdas that means one cache per call site.
+            template <class Func>
+            static auto get(Func func) -> const typename std::decay<decltype(func())>::type&
+            {
+                typedef typename std::decay<decltype(func())>::type value_type;
+                static_assert(std::is_trivially_destructible<value_type>::value, "Cached values are never destroyed");
+
+                // values are copy constructed in place: vectors and matrices have user-declared copy constructors,
+                // and assigning over them would rely on deprecated implicit copy assignment
+                static thread_local typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type s_storage;
+                static thread_local unsigned s_frame = 0;
+                static thread_local bool s_valid = false;
+
+                value_type* value = reinterpret_cast<value_type*>(&s_storage);
+                unsigned frame = frame_counter().load(std::memory_order_relaxed);
+                if (!s_valid || s_frame != frame)
+                {
+                    s_valid = false;
+                    new (value) value_type(func());
+                    s_frame = frame;
+                    s_valid = true;
+                }
+                return *value;
+            }
+
+        private:
+            static std::atomic<unsigned>& frame_counter()
+            {
+                static std::atomic<unsigned> s_counter(0);
+                return s_counter;
+            }
+        };
+    }
+}
+
+//! Evaluates expr once per frame (see uniform_scope). expr must depend on uniforms and constants only.
+#define CXXSWIZZLE_UNIFORM_SCOPE(expr) (::swizzle::glsl::uniform_scope::get([&]() { return ::swizzle::detail::decay(expr); }))
@@ -6,6 +6,7 @@
 #include <iostream>
 
 #include <swizzle/detail/utils.h>
+#include <swizzle/detail/instrumentation.h>
 #include <swizzle/detail/common_binary_operators.h>
 #include <swizzle/detail/vector_base.h>
 #include <swizzle/detail/indexed_vector_iterator.h>
@@ -46,6 +47,8 @@ namespace swizzle
             typedef typename vector_helper<ScalarType, Size>::base_type base_type;
             //! "Hide" m_data from outside and make it locally visible
             using base_type::m_data;
+            //! Type of m_data
+            typedef typename vector_helper<ScalarType, Size>::data_type data_type;
 
         // TYPEDEFS
         public:
@@ -76,38 +79,47 @@ namespace swizzle
             //! Sanity checks
             static_assert( sizeof(base_type) == sizeof(scalar_type) * Size, "Size of the base class is not equal to size of its components, most likely empty base class optimisation failed");
 
+            //! Are T exactly Size arithmetic values, with an arithmetic scalar_type? Vectors like that are created with
+            //! constexpr constructor, so constant vectors are folded at compile time.
+            template <class... T>
+            struct is_constant_initialisable : std::integral_constant<bool, 
+                sizeof...(T) == Size && (Size > 1) && std::is_arithmetic<scalar_type>::value && detail::are_arithmetic<T...>::value>
+            {};
+
         // CONSTRUCTION
         public:
             //! Default constructor.
-            inline vector()
-            {
-                m_data = {};
-            }
+            constexpr vector()
+            {}
 
             //! Copy constructor
-            inline vector(vector_arg_type o)
-            {
-                m_data = o.m_data;
-            }
+            constexpr vector(vector_arg_type o)
+                : base_type(o.m_data)
+            {}
 
             //! Implicit constructor from scalar-convertible only for one-component vector
-            vector(typename std::conditional<Size == 1, scalar_arg_type, detail::operation_not_available>::type s)
-            {
-                detail::static_foreach<detail::functor_assign>(*this, s);
-            }
+            constexpr vector(typename std::conditional<Size == 1, scalar_arg_type, detail::operation_not_available>::type s)
+                : vector(s, are_scalar_types_same())
+            {}
 
             //! For vectors bigger than 1 conversion from scalar should be explicit.
-            explicit vector( typename std::conditional<Size!=1, scalar_arg_type, detail::operation_not_available>::type s )
-            {
-                detail::static_foreach<detail::functor_assign>(*this, s);
-            }
+            constexpr explicit vector( typename std::conditional<Size!=1, scalar_arg_type, detail::operation_not_available>::type s )
+                : vector(s, are_scalar_types_same())
+            {}
+
+            //! Constructor from Size arithmetic values.
+            template <class... T, class = typename std::enable_if<is_constant_initialisable<T...>::value>::type>
+            constexpr explicit vector(T... ts)
+                : base_type(data_type{ { static_cast<scalar_type>(ts)... } })
+            {}
 
             // Block of generic proxy-constructos calling construct member function. Compiler
             // will likely optimise this.
             template <class T0, class... T,
                 class = typename std::enable_if< 
                     !(Size <= detail::get_total_size<T0, T...>::value - detail::get_total_size<typename detail::last<T0, T...>::type >::value) &&
-                        (Size <= detail::get_total_size<T0, T...>::value),
+                        (Size <= detail::get_total_size<T0, T...>::value) &&
+                        !is_constant_initialisable<T0, T...>::value,
                     void>::type 
                 >
             explicit vector(T0&& t0, T&&... ts)
@@ -127,7 +139,7 @@ namespace swizzle
                 return at(i);
             }
 
-            const scalar_type& operator[](size_t i) const
+            constexpr const scalar_type& operator[](size_t i) const
             {
                 return at(i);
             }
@@ -220,7 +232,7 @@ namespace swizzle
             {
                 return m_data[i];
             }
-            const internal_scalar_type& at(size_t i, std::true_type) const
+            constexpr const internal_scalar_type& at(size_t i, std::true_type) const
             {
                 return m_data[i];
             }
@@ -242,7 +254,7 @@ namespace swizzle
             {
                 return at(i, are_scalar_types_same());
             }
-            const scalar_type& at(size_t i) const
+            constexpr const scalar_type& at(size_t i) const
             {
                 return at(i, are_scalar_types_same());
             }
@@ -255,6 +267,22 @@ namespace swizzle
             
         private:
 
+            //! Splat of a scalar; constexpr if scalar types are the same...
+            constexpr vector(scalar_arg_type s, std::true_type)
+                : vector(s, detail::make_index_sequence<Size>())
+            {}
+
+            template <size_t... Index>
+            constexpr vector(scalar_arg_type s, detail::index_sequence<Index...>)
+                : base_type(data_type{ { (static_cast<void>(Index), s)... } })
+            {}
+
+            //! ... otherwise scalar needs to be converted.
+            vector(scalar_arg_type s, std::false_type)
+            {
+                detail::static_foreach<detail::functor_assign>(*this, s);
+            }
+
             template <size_t offset, class T0, class... Tail>
             void construct(T0&& t0, Tail&&... tail)
             {
@@ -26,12 +26,15 @@
 // like a member function, i.e. using an instance. This form is used in the decltype as
 // it yields better error messages in MSVC if something goes wrong (can't specialize vs.
 // internal complier linkage).
+//
+// With CXXSWIZZLE_INSTRUMENTATION defined, calls of these functions are counted; see
+// swizzle/detail/instrumentation.h.
 
 
 #define SWIZZLE_FORWARD_FUNC(name) \
     template <class T, class... U> inline auto name(T&& t, U&&... u) -> \
     decltype(::swizzle::detail::decay(std::declval<typename ::swizzle::detail::get_vector_type<T, U...>::type>().call_##name(t, u...))) \
-    { return ::swizzle::detail::get_vector_type<T, U...>::type::call_##name(std::forward<T>(t), std::forward<U>(u)...); }
+    { CXXSWIZZLE_INSTRUMENT("builtin", #name); return ::swizzle::detail::get_vector_type<T, U...>::type::call_##name(std::forward<T>(t), std::forward<U>(u)...); }
 
 
 SWIZZLE_FORWARD_FUNC(radians)
@@ -55,6 +58,13 @@ SWIZZLE_FORWARD_FUNC(floor)
 SWIZZLE_FORWARD_FUNC(ceil)
 SWIZZLE_FORWARD_FUNC(fract)
 SWIZZLE_FORWARD_FUNC(mod)
+SWIZZLE_FORWARD_FUNC(modf)
+SWIZZLE_FORWARD_FUNC(trunc)
+SWIZZLE_FORWARD_FUNC(round)
+SWIZZLE_FORWARD_FUNC(roundEven)
+SWIZZLE_FORWARD_FUNC(fma)
+SWIZZLE_FORWARD_FUNC(isnan)
+SWIZZLE_FORWARD_FUNC(isinf)
 SWIZZLE_FORWARD_FUNC(min)
 SWIZZLE_FORWARD_FUNC(max)
 SWIZZLE_FORWARD_FUNC(clamp)
@@ -62,12 +72,23 @@ SWIZZLE_FORWARD_FUNC(mix)
 SWIZZLE_FORWARD_FUNC(step)
 SWIZZLE_FORWARD_FUNC(smoothstep)
 SWIZZLE_FORWARD_FUNC(reflect)
+SWIZZLE_FORWARD_FUNC(refract)
 SWIZZLE_FORWARD_FUNC(length)
 SWIZZLE_FORWARD_FUNC(distance)
 SWIZZLE_FORWARD_FUNC(dot)
 SWIZZLE_FORWARD_FUNC(normalize)
 SWIZZLE_FORWARD_FUNC(faceforward)
 SWIZZLE_FORWARD_FUNC(cross)
+SWIZZLE_FORWARD_FUNC(outerProduct)
+
+SWIZZLE_FORWARD_FUNC(floatBitsToInt)
+SWIZZLE_FORWARD_FUNC(floatBitsToUint)
+SWIZZLE_FORWARD_FUNC(intBitsToFloat)
+SWIZZLE_FORWARD_FUNC(uintBitsToFloat)
+SWIZZLE_FORWARD_FUNC(packUnorm4x8)
+SWIZZLE_FORWARD_FUNC(unpackUnorm4x8)
+SWIZZLE_FORWARD_FUNC(packHalf2x16)
+SWIZZLE_FORWARD_FUNC(unpackHalf2x16)
 
 SWIZZLE_FORWARD_FUNC(lessThan)
 SWIZZLE_FORWARD_FUNC(lessThanEqual)
@@ -22,20 +22,11 @@ namespace swizzle
             //! These can be incomplete types at this point.
             typedef std::array<ScalarType, Size> data_type;
 
+            //! Proxies of 2 or more components; single components are ScalarType.
             template <size_t... indices>
-            struct proxy_generator
-            {
-                typedef detail::indexed_proxy< vector<ScalarType, sizeof...(indices)>, data_type, indices...> type;
-            };
+            using proxy_type = detail::indexed_proxy< vector<ScalarType, sizeof...(indices)>, data_type, indices...>;
 
-            //! A factory of 1-component proxies.
-            template <size_t x>
-            struct proxy_generator<x>
-            {
-                typedef ScalarType type;
-            };
-
-            typedef detail::vector_base< Size, proxy_generator, data_type > base_type;
+            typedef detail::vector_base< Size, proxy_type, ScalarType, data_type > base_type;
         };
     }
 }
\ No newline at end of file
@@ -9,7 +9,11 @@
 
 #include <swizzle/glsl/vector.h>
 #include <swizzle/glsl/matrix.h>
-#include <swizzle/glsl/texture_functions.h>
+#include <swizzle/glsl/texture_sampler.h>
+#include <swizzle/glsl/texture_cache.h>
+#include <swizzle/glsl/pass_graph.h>
+#include <swizzle/glsl/post_process.h>
+#include <swizzle/glsl/uniform_scope.h>
 
 typedef swizzle::glsl::vector< float_type, 2 > vec2;
 typedef swizzle::glsl::vector< float_type, 3 > vec3;
@@ -24,32 +28,16 @@ typedef swizzle::glsl::matrix< swizzle::glsl::vector, vec4::scalar_type, 3, 3> m
 typedef swizzle::glsl::matrix< swizzle::glsl::vector, vec4::scalar_type, 4, 4> mat4;
 
 
-//! A really, really simplistic sampler using SDLImage
-struct SDL_Surface;
-class sampler2D : public swizzle::glsl::texture_functions::tag
-{
-public:
-    enum WrapMode
-    {
-        Clamp,
-        Repeat,
-        MirrorRepeat
-    };
-
-    typedef const vec2& tex_coord_type;
+typedef swizzle::glsl::basic_sampler2D<float_type> sampler2D;
+typedef swizzle::glsl::basic_sampler3D<float_type> sampler3D;
+typedef swizzle::glsl::basic_samplerCube<float_type> samplerCube;
 
-    sampler2D(const char* path, WrapMode wrapMode);
-    ~sampler2D();
-    vec4 sample(const vec2& coord);
+//! Maps the cached texture, decoding it with SDL_image first if there is no up-to-date cache file; if
+//! decoding is not possible, a checkerboard is returned.
+std::shared_ptr<const swizzle::glsl::texture_image> loadTexture(const char* path);
 
-private:
-    SDL_Surface *m_image;
-    WrapMode m_wrapMode;
-
-    // do not allow copies to be made
-    sampler2D(const sampler2D&);
-    sampler2D& operator=(const sampler2D&);
-};
+//! 1x1 transparent black, for samplers with nothing to sample yet.
+std::shared_ptr<const swizzle::glsl::texture_image> blankTexture();
 
 // this where the magic happens...
 namespace glsl_sandbox
@@ -77,20 +65,32 @@ namespace glsl_sandbox
         typedef const ::float_type& float_type;
     }
 
+    // types of uniforms; floats are lane-invariant, so that math on them does not need SIMD
+    namespace uniform_types
+    {
+        typedef ::uniform_float_type float_type;
+        typedef ::vec2 vec2;
+        typedef ::vec3 vec3;
+        typedef ::vec4 vec4;
+    }
+
     #include <swizzle/glsl/vector_functions.h>
 
     // constants shaders are using
-    float_type time = 1;
+    uniform_float_type time = 1;
     vec2 mouse(0, 0);
     vec2 resolution;
 
     // constants some shaders from shader toy are using
     vec2& iResolution = resolution;
-    float_type& iGlobalTime = time;
+    uniform_float_type& iGlobalTime = time;
     vec2& iMouse = mouse;
 
-    sampler2D diffuse("diffuse.png", sampler2D::Repeat);
-    sampler2D specular("specular.png", sampler2D::Repeat);
+    sampler2D diffuse(loadTexture("diffuse.png"), swizzle::glsl::wrap_mode::repeat, swizzle::glsl::texture_filter::linear_mipmap_linear, swizzle::glsl::texture_filter::linear);
+    sampler2D specular(loadTexture("specular.png"), swizzle::glsl::wrap_mode::repeat, swizzle::glsl::texture_filter::linear_mipmap_linear, swizzle::glsl::texture_filter::linear);
+
+    // output of BufferA of multi-pass shaders, as in Shadertoy; rebound every frame (see renderThread)
+    sampler2D iChannel0(blankTexture(), swizzle::glsl::wrap_mode::clamp, swizzle::glsl::texture_filter::linear, swizzle::glsl::texture_filter::linear);
 
     struct fragment_shader
     {
@@ -100,13 +100,15 @@ namespace glsl_sandbox
     };
 
     // change meaning of glsl keywords to match sandbox
-    #define uniform extern
+    #define uniform extern uniform_types::
     #define in in::
     #define out ref::
     #define inout ref::
     #define main fragment_shader::operator()
     #define float float_type   
     #define bool bool_type
+    // shaders may wrap uniform-only expressions with this to have them evaluated once per frame
+    #define uniform_scope(x) CXXSWIZZLE_UNIFORM_SCOPE(x)
     
     #pragma warning(push)
     #pragma warning(disable: 4244) // disable return implicit conversion warning
@@ -121,8 +123,28 @@ namespace glsl_sandbox
     //#include "shaders/water_turbulence.frag"
     #include "shaders/sky.frag"
 
+    // multi-pass shaders also need their BufferA shader, rendered into a float render target before the
+    // main one; BufferA sees its own previous frame as iChannel0
+    //#define BUFFER_A_SHADER "shaders/feedback_buffer_a.frag"
+    //#include "shaders/feedback.frag"
+
+#ifdef BUFFER_A_SHADER
+    namespace buffer_a
+    {
+        struct fragment_shader
+        {
+            vec2 gl_FragCoord;
+            vec4 gl_FragColor;
+            void operator()(void);
+        };
+
+        #include BUFFER_A_SHADER
+    }
+#endif
+
     // be a dear a clean up
     #pragma warning(pop)
+    #undef uniform_scope
     #undef bool
     #undef float
     #undef main
@@ -218,7 +240,64 @@ T* alignPtr(T* ptr)
     return reinterpret_cast<T*>((value + Align) & (~(Align - 1)));
 }
 
-//! Thread used for rendering; it invokes the shader
+//! Post-process stages for the screen, fused into its pixel loop; add some with e.g.
+//! post_process().then(post::exposure(1.5f)).then(post::tonemap_aces()).then(post::gamma()).then(post::dither())
+static const auto c_postProcess = swizzle::glsl::post_process();
+
+//! Runs shaders of a frame's passes on all the cores (one pass at a time unless they are independent).
+static void parallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+#if !defined(_DEBUG) && OMP_ENABLED
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(count); ++i)
+    {
+        func(static_cast<size_t>(i));
+    }
+}
+
+//! Renders row y of a render target with Shader, keeping colours as they are.
+template <class Shader>
+static void renderTargetRow(swizzle::glsl::render_target& target, int y, const raw_float_type& offsets)
+{
+    using ::swizzle::detail::static_for;
+
+    // check the comment in renderThread for explanation
+    float unalignedBlob[4 * (scalar_count + float_entries_align / sizeof(float))];
+    float* pr = alignPtr<float_entries_align>(unalignedBlob);
+    float* pg = alignPtr<float_entries_align>(pr + scalar_count);
+    float* pb = alignPtr<float_entries_align>(pg + scalar_count);
+    float* pa = alignPtr<float_entries_align>(pb + scalar_count);
+
+    Shader shader;
+    shader.gl_FragCoord.y = static_cast<float>(y);
+
+    int width = static_cast<int>(target.width());
+    int limitX = width - static_cast<int>(scalar_count);
+    for (int x = 0; !g_cancelDraw && x < width; x += scalar_count)
+    {
+        // same as with the screen: redraw some pixels rather than go past the end
+        if (x > limitX)
+        {
+            x = limitX;
+        }
+
+        shader.gl_FragCoord.x = static_cast<float>(x) + offsets;
+        shader();
+
+        store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.r), pr);
+        store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.g), pg);
+        store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.b), pb);
+        store_aligned(static_cast<raw_float_type>(shader.gl_FragColor.a), pa);
+
+        static_for<0, scalar_count>([&](size_t i)
+        {
+            target.store(static_cast<unsigned>(x) + static_cast<unsigned>(i), static_cast<unsigned>(y), pr[i], pg[i], pb[i], pa[i]);
+        });
+    }
+}
+
+//! Thread used for rendering; it invokes the shaders
 static int renderThread(void*)
 {
     using ::swizzle::detail::static_for;
@@ -237,80 +316,105 @@ static int renderThread(void*)
 
         load_aligned(offsets, aligned);
     }
-   
 
-    while (true)
+    SDL_Surface* bmp = g_surface.get();
+
+    // passes of a frame; the one drawing on the screen goes last
+    swizzle::glsl::pass_graph graph;
+    std::vector<size_t> screenInputs;
+
+#ifdef BUFFER_A_SHADER
+    auto bufferA = std::make_shared<swizzle::glsl::render_target>(bmp->w, bmp->h);
+    auto bindBufferA = [bufferA]()
     {
-        auto bmp = g_surface.get();
+        glsl_sandbox::iChannel0 = sampler2D(bufferA->front(), swizzle::glsl::wrap_mode::clamp, swizzle::glsl::texture_filter::linear, swizzle::glsl::texture_filter::linear);
+    };
+    {
+        swizzle::glsl::pass_graph::pass pass = { "BufferA", bufferA, 0, bindBufferA,
+            [bufferA, &offsets](unsigned y) { renderTargetRow<glsl_sandbox::buffer_a::fragment_shader>(*bufferA, y, offsets); }, {} };
+        screenInputs.push_back(graph.add(pass));
+    }
+#else
+    std::function<void()> bindBufferA;
+#endif
 
-#if !defined(_DEBUG) && OMP_ENABLED
-#pragma omp parallel 
+    swizzle::glsl::pass_graph::pass screenPass = { "Image", nullptr, 0, bindBufferA, [&](unsigned row)
+    {
+        // check the comment above for explanation
+        unsigned unalignedBlob[3 * (scalar_count + uint_entries_align / sizeof(unsigned))];
+        unsigned* pr = alignPtr<uint_entries_align>(unalignedBlob);
+        unsigned* pg = alignPtr<uint_entries_align>(pr + scalar_count);
+        unsigned* pb = alignPtr<uint_entries_align>(pg + scalar_count);
+
+        if (g_cancelDraw)
         {
-            int thredsCount = omp_get_num_threads();
-            int threadNum = omp_get_thread_num();
+            return;
+        }
 
-            int heightStep = thredsCount;
-            int heightStart = threadNum;
-            int heightEnd = bmp->h;
-#else
+        glsl_sandbox::fragment_shader shader;
+        int y = static_cast<int>(row);
+        shader.gl_FragCoord.y = static_cast<float>(bmp->h - 1 - y);
+
+        uint8_t * ptr = reinterpret_cast<uint8_t*>(bmp->pixels) + y * bmp->pitch;
+
+        int limitX = bmp->w - scalar_count;
+        for (int x = 0; x < bmp->w; x += scalar_count)
         {
-            int heightStep = 1;
-            int heightStart = 0;
-            int heightEnd = bmp->h;
-#endif
-            // check the comment above for explanation
-            unsigned unalignedBlob[3 * (scalar_count + uint_entries_align / sizeof(unsigned))];
-            unsigned* pr = alignPtr<uint_entries_align>(unalignedBlob);
-            unsigned* pg = alignPtr<uint_entries_align>(pr + scalar_count);
-            unsigned* pb = alignPtr<uint_entries_align>(pg + scalar_count);
-
-            glsl_sandbox::fragment_shader shader;
-  
-            for (int y = heightStart; !g_cancelDraw && y < heightEnd; y += heightStep)
+            // since we are likely moving by more than one pixel,
+            // this will shift x and ptr left in case of width and scalar_count
+            // not being aligned; will redraw up to (scalar_count-1) pixels,
+            // but well, what you gonna do.
+            if (x > limitX)
             {
-                shader.gl_FragCoord.y = static_cast<float>(bmp->h - 1 - y);
+                ptr -= 3 * (x - limitX);
+                x = limitX;
+            }
 
-                uint8_t * ptr = reinterpret_cast<uint8_t*>(bmp->pixels) + y * bmp->pitch;
+            shader.gl_FragCoord.x = static_cast<float>(x) + offsets;
 
-                int limitX = bmp->w - scalar_count;
-                for (int x = 0; x < bmp->w; x += scalar_count)
-                {
-                    // since we are likely moving by more than one pixel,
-                    // this will shift x and ptr left in case of width and scalar_count
-                    // not being aligned; will redraw up to (scalar_count-1) pixels,
-                    // but well, what you gonna do.
-                    if (x > limitX)
-                    {
-                        ptr -= 3 * (x - limitX);
-                        x = limitX;
-                    }
+            // vvvvvvvvvvvvvvvvvvvvvvvvvv
+            // THE SHADER IS INVOKED HERE
+            // ^^^^^^^^^^^^^^^^^^^^^^^^^^
+            shader();
 
-                    shader.gl_FragCoord.x = static_cast<float>(x) + offsets;
-                    
-                    // vvvvvvvvvvvvvvvvvvvvvvvvvv
-                    // THE SHADER IS INVOKED HERE
-                    // ^^^^^^^^^^^^^^^^^^^^^^^^^^
-                    shader();
+            // tonemapping, gamma etc. run here, while the batch is still in registers
+            c_postProcess(shader.gl_FragColor, shader.gl_FragCoord);
 
-                    // convert to [0;255]
-                    auto color = glsl_sandbox::clamp(shader.gl_FragColor, c_zero, c_one);
-                    color *= 255 + 0.5f;
+            // convert to [0;255]
+            auto color = glsl_sandbox::clamp(shader.gl_FragColor, c_zero, c_one);
+            color *= 255 + 0.5f;
 
-                    // save in the bitmap
-                    store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.r)), pr);
-                    store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.g)), pg);
-                    store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.b)), pb);
+            // save in the bitmap
+            store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.r)), pr);
+            store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.g)), pg);
+            store_aligned(static_cast<uint_type>(static_cast<raw_float_type>(color.b)), pb);
 
-                    static_for<0, scalar_count>([&](size_t i)
-                    {
-                        *ptr++ = static_cast<uint8_t>(pr[i]);
-                        *ptr++ = static_cast<uint8_t>(pg[i]);
-                        *ptr++ = static_cast<uint8_t>(pb[i]);
-                    });
-                }
+            static_for<0, scalar_count>([&](size_t i)
+            {
+                *ptr++ = static_cast<uint8_t>(pr[i]);
+                *ptr++ = static_cast<uint8_t>(pg[i]);
+                *ptr++ = static_cast<uint8_t>(pb[i]);
+            });
+        }
+    }, screenInputs };
+    size_t screen = graph.add(screenPass);
+
+    while (true)
+    {
+        // the surface gets recreated on resize; render targets follow its size
+        bmp = g_surface.get();
+        graph[screen].rows = bmp->h;
+        for (size_t i = 0; i < graph.size(); ++i)
+        {
+            auto& target = graph[i].target;
+            if (target && (target->width() != static_cast<unsigned>(bmp->w) || target->height() != static_cast<unsigned>(bmp->h)))
+            {
+                target->resize(bmp->w, bmp->h);
             }
         }
 
+        graph.render_frame(parallelFor);
+
         ScopedLock lock(g_frameHandshakeMutex);
         if ( g_quit )
         {
@@ -401,6 +505,7 @@ extern "C" int main(int argc, char* argv[])
             // update shader value
             glsl_sandbox::resolution.x = static_cast<float>(w);
             glsl_sandbox::resolution.y = static_cast<float>(h);
+            swizzle::glsl::uniform_scope::next_frame();
         };
 
         // initial setup
@@ -529,6 +634,7 @@ extern "C" int main(int argc, char* argv[])
                         // transfer variables (resolution is transfered elsewhere)
                         glsl_sandbox::time = time;
                         glsl_sandbox::mouse = mousePosition / vec2(screen->w, screen->h);
+                        swizzle::glsl::uniform_scope::next_frame();
                         // reset flags
                         g_cancelDraw = g_frameReady = false;
                         SDL_CondSignal( m_frameReceivedEvent.get() );
@@ -568,116 +674,52 @@ extern "C" int main(int argc, char* argv[])
 }
 
 
-sampler2D::sampler2D( const char* path, WrapMode wrapMode ) 
-    : m_wrapMode(wrapMode)
-    , m_image(nullptr)
-{
-#ifdef SDLIMAGE_FOUND
-    m_image = IMG_Load(path);
-    if (!m_image)
-    {
-        std::cerr << "WARNING: Failed to load texture " << path << "\n";
-        std::cerr << "  SDL_Image message: " << IMG_GetError() << "\n";
-    }
-#else
-    std::cerr << "WARNING: Texture " << path << " won't be loaded, SDL_image was not found.\n";
-#endif
+swizzle::glsl::texture_image decodeTexture(const char* path);
 
+std::shared_ptr<const swizzle::glsl::texture_image> loadTexture(const char* path)
+{
+    // cache files end up in the working directory
+    static const swizzle::glsl::texture_cache cache(".");
+    return cache.load(path, [path]() { return decodeTexture(path); });
 }
 
-sampler2D::~sampler2D()
+std::shared_ptr<const swizzle::glsl::texture_image> blankTexture()
 {
-    if ( m_image )
-    {
-        SDL_FreeSurface(m_image);
-        m_image = nullptr;
-    }
+    return std::make_shared<swizzle::glsl::texture_image>(1, 1, std::vector<swizzle::glsl::texture_image::texel_type>(1, 0u));
 }
 
-vec4 sampler2D::sample( const vec2& coord )
+swizzle::glsl::texture_image decodeTexture(const char* path)
 {
-    using namespace glsl_sandbox;
-    vec2 uv;
-    switch (m_wrapMode)
+#ifdef SDLIMAGE_FOUND
+    auto image = makeUnique<SDL_Surface>(SDL_FreeSurface);
+    image.reset(IMG_Load(path));
+    if (image)
     {
-    case Repeat:
-        uv = mod(coord, 1);
-        break;
-    case MirrorRepeat:
-        uv = abs(mod(coord - 1, 2) - 1);
-        break;
-    case Clamp:
-    default:
-        uv = clamp(coord, 0, 1);
-        break;
+        auto& format = *image->format;
+        swizzle::glsl::pixel_format pixelFormat = { format.BytesPerPixel, format.Rmask, format.Gmask, format.Bmask, format.Amask };
+        swizzle::glsl::texture_image result(image->pixels, image->w, image->h, image->pitch, pixelFormat);
+        result.generate_mipmaps();
+        result.set_layout(swizzle::glsl::texture_layout::tiled);
+        return result;
     }
+    std::cerr << "WARNING: Failed to load texture " << path << "\n";
+    std::cerr << "  SDL_Image message: " << IMG_GetError() << "\n";
+#else
+    std::cerr << "WARNING: Texture " << path << " won't be loaded, SDL_image was not found.\n";
+#endif
 
-    // OGL uses left-bottom corner as origin...
-    uv.y = 1 - uv.y;
-
-    if ( !m_image )
+    // 2x2 checkers; red & green, big enough not to get blurred by filtering
+    const unsigned size = 64;
+    std::vector<unsigned> texels(size * size);
+    for (unsigned y = 0; y < size; ++y)
     {
-        // checkers
-        auto s = step(0.5f, uv);
-        auto m2 = abs(s.x - s.y);
-        return mix(vec4(1, 0, 0, 1), vec4(0, 1, 0, 1), m2);
-        /*if (uv_x < 0.5 && uv_y < 0.5 || uv_x > 0.5 && uv_y > 0.5)
+        for (unsigned x = 0; x < size; ++x)
         {
-            return vec4(1, 0, 0, 1);
+            texels[y * size + x] = (x < size / 2) == (y < size / 2) ? 0xff00ff00u : 0xff0000ffu;
         }
-        else
-        {
-            return vec4(0, 1, 0, 1);
-        }*/
     }
-    else
-    {
-        uint_type x = static_cast<uint_type>(static_cast<raw_float_type>(uv.x * (m_image->w - 1) + 0.5));
-        uint_type y = static_cast<uint_type>(static_cast<raw_float_type>(uv.y * (m_image->h - 1) + 0.5));
-
-        auto& format = *m_image->format;
-        uint_type index = (y * m_image->pitch + x * format.BytesPerPixel);
-
-        // stack-alloc blob for storing indices and color components
-        uint8_t unalignedBlob[5 * (scalar_count * sizeof(unsigned) + uint_entries_align)];
-        unsigned* pindex = alignPtr<uint_entries_align>(reinterpret_cast<unsigned*>(unalignedBlob));
-        unsigned* pr = alignPtr<uint_entries_align>(pindex + scalar_count);
-        unsigned* pg = alignPtr<uint_entries_align>(pr + scalar_count);
-        unsigned* pb = alignPtr<uint_entries_align>(pg + scalar_count);
-        unsigned* pa = alignPtr<uint_entries_align>(pb + scalar_count);
-
-        store_aligned(index, pindex);
-        
-        // fill the buffers
-        swizzle::detail::static_for<0, scalar_count>([&](size_t i)
-        {
-            auto pixelPtr = static_cast<uint8_t*>(m_image->pixels) + pindex[i];
-            
-            uint32_t pixel = 0;
-            for (size_t i = 0; i < format.BytesPerPixel; ++i)
-            {
-                pixel |= (pixelPtr[i] << (i * 8));
-            }
-
-            pr[i] = (pixel & format.Rmask) >> format.Rshift;
-            pg[i] = (pixel & format.Gmask) >> format.Gshift;
-            pb[i] = (pixel & format.Bmask) >> format.Bshift;
-            pa[i] = format.Amask ? ((pixel & format.Amask) >> format.Ashift) : 255;
-        });
-
-        // load data
-        uint_type r, g, b, a;
-        load_aligned(r, pr);
-        load_aligned(g, pg);
-        load_aligned(b, pb);
-        load_aligned(a, pa);
-
-        vec4 result;
-        result.r = static_cast<raw_float_type>(r);
-        result.g = static_cast<raw_float_type>(g);
-        result.b = static_cast<raw_float_type>(b);
-        result.a = static_cast<raw_float_type>(a);
-
-        return clamp(result / 255.0f, c_zero, c_one);
-    }
-}
\ No newline at end of file
+    swizzle::glsl::texture_image result(size, size, std::move(texels));
+    result.generate_mipmaps();
+    result.set_layout(swizzle::glsl::texture_layout::tiled);
+    return result;
+}
@@ -0,0 +1,9 @@
+// Image pass of a two-pass shader: colours the trail rendered into BufferA (see feedback_buffer_a.frag)
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy / iResolution.xy;
+
+    float trail = texture(iChannel0, uv).r;
+    gl_FragColor = vec4(trail, trail * trail, 0.25 + 0.5 * trail * trail * trail, 1.0);
+}
@@ -0,0 +1,13 @@
+// BufferA of feedback.frag: a dot circling the screen, leaving a fading trail behind; iChannel0 is
+// this very buffer as it was in the previous frame
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy / iResolution.xy;
+
+    vec2 centre = vec2(0.5) + 0.35 * vec2(cos(iGlobalTime), sin(iGlobalTime * 1.3));
+    float d = length((uv - centre) * vec2(iResolution.x / iResolution.y, 1.0));
+
+    vec4 previous = texture(iChannel0, uv);
+    gl_FragColor = max(previous * 0.97, vec4(1.0 - smoothstep(0.0, 0.05, d)));
+}
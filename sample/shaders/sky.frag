@@ -8,6 +8,11 @@ uniform float time;
 uniform vec2 mouse;
 uniform vec2 resolution;
 
+// the sandbox evaluates these once per frame
+#ifndef uniform_scope
+#define uniform_scope(x) (x)
+#endif
+
 // Star Nest by Pablo Romn Andrioli
 // Modified a lot.
 
@@ -38,8 +43,8 @@ void main(void)
 	
 	float a2=time*speed+.25;
 	float a1=0.0;
-	mat2 rot1=mat2(cos(a1),sin(a1),-sin(a1),cos(a1));
-	mat2 rot2=mat2(cos(a2),sin(a2),-sin(a2),cos(a2));
+	mat2 rot1=uniform_scope(mat2(cos(a1),sin(a1),-sin(a1),cos(a1)));
+	mat2 rot2=uniform_scope(mat2(cos(a2),sin(a2),-sin(a2),cos(a2)));
 	dir.xz*=rot1;
 	dir.xy*=rot2;
 	
@@ -10,6 +10,7 @@
 #include <swizzle/glsl/scalar_support.h>
 
 typedef swizzle::glsl::vc_float<> float_type;
+typedef swizzle::glsl::vc_uniform_float<> uniform_float_type;
 typedef float_type::internal_type raw_float_type;
 typedef Vc::uint_v uint_type;
 
@@ -2,10 +2,11 @@
 // Copyright (c) 2013, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
 #pragma once
 
+// scalar support needs to come first, or else two-phase lookup won't see the functions it adds
+#include <swizzle/glsl/scalar_support.h>
 #include <swizzle/glsl/vector.h>
 #include <swizzle/glsl/matrix.h>
 #include <swizzle/glsl/vector_functions.h>
-#include <swizzle/glsl/scalar_support.h>
 
 typedef swizzle::glsl::vector< float, 1 > vec1;
 typedef swizzle::glsl::vector< float, 2 > vec2;
@@ -45,6 +46,7 @@ typedef swizzle::glsl::matrix< swizzle::glsl::vector, double, 4, 4> dmat4;
 typedef swizzle::glsl::matrix< swizzle::glsl::vector, double, 2, 4> dmat2x4;
 
 
+#include <algorithm>
 #include <array>
 #include <limits>
 
@@ -5,6 +5,7 @@
 #include <array>
 #include <limits>
 #include "setup.h"
+#include <swizzle/glsl/uniform_scope.h>
 
 
 template <class TVec, class TScalar>
@@ -211,4 +212,51 @@ BOOST_AUTO_TEST_CASE(vec4_test_construct)
     BOOST_ASSERT( are_equal(vec4(v4.w, v4.w, v4.w, v4.x), vec4(v4.w, v4.wwxx)) );
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(constant_construction)
+{
+    // scalar vectors and matrices are literal types
+    constexpr vec2 v2(1, 2.5);
+    constexpr vec3 v3(3);
+    constexpr vec4 table[] = { vec4(1, 0, 0, 1), vec4(0, 1, 0, 1) };
+    constexpr mat2 m2 = mat2(1.6, -1.2, 1.2, 1.6);
+    constexpr mat3 m3(2);
+
+    static_assert(v2[0] == 1 && v2[1] == 2.5f, "");
+    static_assert(v3[2] == 3, "");
+    static_assert(table[1][1] == 1 && table[1][3] == 1, "");
+    static_assert(m2[1][0] == 1.2f && m2.cell(1, 0) == -1.2f, "");
+    static_assert(m3[1][1] == 2 && m3[1][0] == 0, "");
+
+    // runtime construction gives same results
+    BOOST_CHECK( v2 == vec2(vec2(1, 0).x, 2.5f) );
+    BOOST_CHECK( m2 == mat2(vec2(1.6f, -1.2f), vec2(1.2f, 1.6f)) );
+    BOOST_CHECK( m3 == mat3(vec3(2, 0, 0), vec3(0, 2, 0), vec3(0, 0, 2)) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(UniformScope)
+
+BOOST_AUTO_TEST_CASE(evaluated_once_per_frame)
+{
+    int evaluations = 0;
+    float time = 0;
+    auto rotation = [&]() -> mat2
+    {
+        return CXXSWIZZLE_UNIFORM_SCOPE((++evaluations, mat2(cos(time), sin(time), -sin(time), cos(time))));
+    };
+
+    swizzle::glsl::uniform_scope::next_frame();
+    BOOST_CHECK( rotation() == mat2(1) );
+    BOOST_CHECK( rotation() == mat2(1) );
+    BOOST_CHECK( evaluations == 1 );
+
+    // stale until the next frame
+    time = 1;
+    BOOST_CHECK( rotation() == mat2(1) );
+    swizzle::glsl::uniform_scope::next_frame();
+    BOOST_CHECK( rotation()[0] == vec2(cos(1.0f), sin(1.0f)) );
+    BOOST_CHECK( evaluations == 2 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
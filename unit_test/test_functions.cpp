@@ -0,0 +1,181 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include "setup.h"
+
+namespace
+{
+    const float c_eps = 0.0001f;
+
+    template <class TVec>
+    bool are_near(const TVec& a, const TVec& b)
+    {
+        return are_equal(a, b, [](float x, float y) -> bool { return std::abs(x - y) < c_eps; });
+    }
+
+    bool are_near(float a, float b)
+    {
+        return std::abs(a - b) < c_eps;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(Functions)
+
+BOOST_AUTO_TEST_CASE(geometric)
+{
+    vec3 a(1, 2, 3);
+    vec3 b(4, -5, 6);
+
+    BOOST_CHECK( are_near(dot(a, b), 12.0f) );
+    BOOST_CHECK( are_near(length(a), std::sqrt(14.0f)) );
+    BOOST_CHECK( are_near(distance(a, b), std::sqrt(9.0f + 49.0f + 9.0f)) );
+    BOOST_CHECK( are_near(normalize(a), a / std::sqrt(14.0f)) );
+    BOOST_CHECK( are_near(length(normalize(b)), 1.0f) );
+
+    // scalars are one-component vectors
+    BOOST_CHECK( are_near(dot(2.0f, 3.0f), 6.0f) );
+    BOOST_CHECK( are_near(length(-2.0f), 2.0f) );
+    BOOST_CHECK( are_near(distance(1.0f, 4.0f), 3.0f) );
+}
+
+BOOST_AUTO_TEST_CASE(reflect_refract_faceforward)
+{
+    vec3 n(0, 1, 0);
+    vec3 i = normalize(vec3(1, -1, 0));
+
+    BOOST_CHECK( are_near(reflect(i, n), normalize(vec3(1, 1, 0))) );
+
+    // eta == 1 means no refraction at all
+    BOOST_CHECK( are_near(refract(i, n, 1.0f), i) );
+
+    // bending towards the normal
+    vec3 r = refract(i, n, 0.5f);
+    BOOST_CHECK( are_near(length(r), 1.0f) );
+    BOOST_CHECK( r.x < i.x && r.y < 0 );
+
+    // total internal reflection
+    BOOST_CHECK( are_near(refract(i, n, 2.0f), vec3(0)) );
+
+    BOOST_CHECK( are_near(faceforward(n, i, n), n) );
+    BOOST_CHECK( are_near(faceforward(n, -i, n), -n) );
+    BOOST_CHECK( are_near(faceforward(n, vec3(1, 0, 0), n), -n) );
+}
+
+BOOST_AUTO_TEST_CASE(rounding)
+{
+    vec4 a(-1.5f, -0.5f, 0.5f, 2.5f);
+
+    BOOST_CHECK( trunc(a) == vec4(-1, 0, 0, 2) );
+    BOOST_CHECK( roundEven(a) == vec4(-2, 0, 0, 2) );
+    BOOST_CHECK( round(vec2(0.4f, 1.6f)) == vec2(0, 2) );
+    BOOST_CHECK( fma(a, vec4(2), vec4(1)) == vec4(-2, 0, 2, 6) );
+
+    vec4 i;
+    BOOST_CHECK( are_near(modf(vec4(1.25f, -1.25f, 3, 0.5f), i), vec4(0.25f, -0.25f, 0, 0.5f)) );
+    BOOST_CHECK( i == vec4(1, -1, 3, 0) );
+
+    // scalars and proxies as out parameters
+    float f;
+    BOOST_CHECK( are_near(modf(2.5f, f), 0.5f) && f == 2.0f );
+    modf(vec2(3.5f, 4.5f), i.yx);
+    BOOST_CHECK( i == vec4(4, 3, 3, 0) );
+}
+
+BOOST_AUTO_TEST_CASE(nan_and_inf)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    vec4 a(0, inf, -inf, nan);
+
+    BOOST_CHECK( isnan(a) == bvec4(false, false, false, true) );
+    BOOST_CHECK( isinf(a) == bvec4(false, true, true, false) );
+    BOOST_CHECK( isinf(inf) && !isnan(inf) );
+}
+
+BOOST_AUTO_TEST_CASE(bits)
+{
+    BOOST_CHECK( floatBitsToInt(1.0f) == 0x3f800000 );
+    BOOST_CHECK( floatBitsToInt(vec2(-2.0f, 0.0f)) == ivec2(static_cast<int>(0xc0000000), 0) );
+    BOOST_CHECK( floatBitsToUint(-2.0f) == 0xc0000000u );
+    BOOST_CHECK( intBitsToFloat(ivec2(0x3f800000, 0x40400000)) == vec2(1, 3) );
+    BOOST_CHECK( uintBitsToFloat(0x3f800000u) == 1.0f );
+
+    BOOST_CHECK( packUnorm4x8(vec4(0, 1, 0.5f, 2)) == 0xff80ff00u );
+    BOOST_CHECK( are_near(unpackUnorm4x8(0xff80ff00u), vec4(0, 1, 128.0f / 255.0f, 1)) );
+
+    BOOST_CHECK( packHalf2x16(vec2(1, -2)) == 0xc0003c00u );
+    BOOST_CHECK( unpackHalf2x16(0xc0003c00u) == vec2(1, -2) );
+    // rounding to nearest even, overflow, denormals
+    BOOST_CHECK( (packHalf2x16(vec2(1.0f + 1.0f / 2048, 1.0f + 3.0f / 2048)) & 0xffffu) == 0x3c00u );
+    BOOST_CHECK( (packHalf2x16(vec2(1.0f + 1.0f / 2048, 1.0f + 3.0f / 2048)) >> 16) == 0x3c02u );
+    BOOST_CHECK( packHalf2x16(vec2(100000, 0)) == 0x7c00u );
+    BOOST_CHECK( unpackHalf2x16(0x0001u).x == std::ldexp(1.0f, -24) );
+    BOOST_CHECK( packHalf2x16(vec2(std::ldexp(1.0f, -24), 0)) == 0x0001u );
+}
+
+BOOST_AUTO_TEST_CASE(matrix_functions)
+{
+    mat3 op = outerProduct(vec3(1, 2, 3), vec3(4, 5, 6));
+    BOOST_CHECK( op[0] == vec3(4, 8, 12) && op[2] == vec3(6, 12, 18) );
+
+    // 2 rows, 3 columns
+    mat2x3 m23(1, 2, 3, 4, 5, 6);
+    mat3x2 t = transpose(m23);
+    BOOST_CHECK( t[0] == vec3(1, 3, 5) && t[1] == vec3(2, 4, 6) );
+
+    mat2 m2(4, 3, 6, 3);
+    BOOST_CHECK( are_near(determinant(m2), -6.0f) );
+    mat2 id2 = m2 * inverse(m2);
+    BOOST_CHECK( are_near(id2[0], vec2(1, 0)) && are_near(id2[1], vec2(0, 1)) );
+
+    mat3 m3(2, 0, 1, 1, 3, 2, 1, 1, 2);
+    BOOST_CHECK( are_near(determinant(m3), 6.0f) );
+    mat3 id3 = inverse(m3) * m3;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        vec3 expected(0);
+        expected[i] = 1;
+        BOOST_CHECK( are_near(id3[i], expected) );
+    }
+
+    mat4 m4(1, 0, 2, 0,  0, 3, 0, 1,  1, 0, 1, 0,  0, 2, 0, 1);
+    BOOST_CHECK( are_near(determinant(m4), -1.0f) );
+    BOOST_CHECK( are_near(determinant(transpose(m4)), -1.0f) );
+    mat4 id4 = m4 * inverse(m4);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        vec4 expected(0);
+        expected[i] = 1;
+        BOOST_CHECK( are_near(id4[i], expected) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(matrix_products)
+{
+    mat3 m(2, 0, 1, 1, 3, 2, 1, 1, 2);
+    vec3 v(1, -2, 3);
+
+    // columns scaled by v's components
+    BOOST_CHECK( m * v == vec3(3, -3, 3) );
+    BOOST_CHECK( v * m == vec3(5, 1, 5) );
+    BOOST_CHECK( transpose_mul(m, v) == transpose(m) * v );
+    BOOST_CHECK( transpose_mul(m, v.zyx) == v.zyx * m );
+
+    mat3 n(1, 2, 3, 4, 5, 6, 7, 8, 9);
+    mat3 mn = m * n;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        BOOST_CHECK( mn[i] == m * n[i] );
+    }
+    BOOST_CHECK( transpose_mul(m, n) == transpose(m) * n );
+
+    // rotation + translation
+    mat3x4 affine(0, 1, 0,  -1, 0, 0,  0, 0, 1,  10, 20, 30);
+    BOOST_CHECK( transform_point(affine, vec3(1, 2, 3)) == vec3(8, 21, 33) );
+    BOOST_CHECK( transform_point(affine, v) == (mat4(affine) * vec4(v, 1)).xyz );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
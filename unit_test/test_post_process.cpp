@@ -0,0 +1,120 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include "setup.h"
+#include <swizzle/glsl/post_process.h>
+
+namespace
+{
+    const float c_eps = 0.0001f;
+
+    bool are_near(const vec4& a, const vec4& b)
+    {
+        return are_equal(a, b, [](float x, float y) -> bool { return std::abs(x - y) < c_eps; });
+    }
+
+    using namespace swizzle::glsl;
+}
+
+BOOST_AUTO_TEST_SUITE(PostProcess)
+
+BOOST_AUTO_TEST_CASE(stages)
+{
+    vec2 coord(3, 7);
+    vec4 color;
+
+    color = vec4(0.5f, 1.0f, 2.0f, 0.25f);
+    post::exposure(2.0f)(color, coord);
+    BOOST_CHECK( are_near(color, vec4(1.0f, 2.0f, 4.0f, 0.25f)) );
+
+    post::tint(1.0f, 0.5f, 0.25f)(color, coord);
+    BOOST_CHECK( are_near(color, vec4(1.0f, 1.0f, 1.0f, 0.25f)) );
+
+    color = vec4(1.0f, 3.0f, 0.0f, 1.0f);
+    post::tonemap_reinhard()(color, coord);
+    BOOST_CHECK( are_near(color, vec4(0.5f, 0.75f, 0.0f, 1.0f)) );
+
+    // the fit goes through 0 and saturates
+    color = vec4(0.0f, 1.0f, 100.0f, 1.0f);
+    post::tonemap_aces()(color, coord);
+    BOOST_CHECK( std::abs(color.x) < c_eps && std::abs(color.y - 2.54f / 3.16f) < c_eps && color.z > 1.0f && color.z < 1.04f );
+
+    color = vec4(0.25f, 1.0f, -1.0f, 0.5f);
+    post::gamma(2.0f)(color, coord);
+    BOOST_CHECK( are_near(color, vec4(0.5f, 1.0f, 0.0f, 0.5f)) );
+
+    // no saturation makes grey of the luma; contrast scales around 0.5
+    color = vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    post::grade(0.0f)(color, coord);
+    BOOST_CHECK( are_near(color, vec4(0.2126f, 0.2126f, 0.2126f, 1.0f)) );
+    color = vec4(0.75f, 0.5f, 0.25f, 1.0f);
+    post::grade(1.0f, 2.0f)(color, coord);
+    BOOST_CHECK( are_near(color, vec4(1.0f, 0.5f, 0.0f, 1.0f)) );
+}
+
+BOOST_AUTO_TEST_CASE(dither)
+{
+    const float amplitude = 1.0f / 255.0f;
+    post::dither d;
+
+    double sum = 0;
+    bool varies = false;
+    for (int y = 0; y < 32; ++y)
+    {
+        for (int x = 0; x < 32; ++x)
+        {
+            vec4 color(0.5f, 0.5f, 0.5f, 1.0f);
+            d(color, vec2(static_cast<float>(x), static_cast<float>(y)));
+
+            // same offset for all the channels, within half of the amplitude
+            float offset = color.x - 0.5f;
+            BOOST_CHECK( std::abs(offset) <= amplitude * 0.5f + 1e-6f );
+            BOOST_CHECK( color.y == color.x && color.z == color.x && color.w == 1.0f );
+            varies |= std::abs(offset) > amplitude * 0.25f;
+            sum += offset;
+        }
+    }
+
+    BOOST_CHECK( varies );
+    BOOST_CHECK( std::abs(sum / 1024) < amplitude * 0.05 );
+}
+
+BOOST_AUTO_TEST_CASE(chain)
+{
+    vec2 coord(0, 0);
+
+    // empty chain leaves colours alone
+    vec4 color(2.0f, -1.0f, 0.5f, 0.5f);
+    post_process()(color, coord);
+    BOOST_CHECK( are_near(color, vec4(2.0f, -1.0f, 0.5f, 0.5f)) );
+
+    // stages run in order of then()
+    auto scaleThenGamma = post_process().then(post::exposure(4.0f)).then(post::gamma(2.0f));
+    auto gammaThenScale = post_process().then(post::gamma(2.0f)).then(post::exposure(4.0f));
+    static_assert(decltype(scaleThenGamma)::stage_count == 2, "two stages");
+
+    color = vec4(0.25f, 0.25f, 0.25f, 1.0f);
+    scaleThenGamma(color, coord);
+    BOOST_CHECK( are_near(color, vec4(1.0f, 1.0f, 1.0f, 1.0f)) );
+
+    color = vec4(0.25f, 0.25f, 0.25f, 1.0f);
+    gammaThenScale(color, coord);
+    BOOST_CHECK( are_near(color, vec4(2.0f, 2.0f, 2.0f, 1.0f)) );
+
+    // same as calling stages one by one
+    auto full = post_process().then(post::exposure(1.5f)).then(post::tonemap_aces()).then(post::grade(1.2f, 1.1f)).then(post::gamma()).then(post::dither());
+    vec4 fused(0.3f, 0.6f, 1.2f, 1.0f);
+    vec4 separate = fused;
+    vec2 at(17, 5);
+    full(fused, at);
+    post::exposure(1.5f)(separate, at);
+    post::tonemap_aces()(separate, at);
+    post::grade(1.2f, 1.1f)(separate, at);
+    post::gamma()(separate, at);
+    post::dither()(separate, at);
+    BOOST_CHECK( are_equal(fused, separate) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
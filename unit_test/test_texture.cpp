@@ -0,0 +1,831 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "setup.h"
+#include <swizzle/glsl/texture_sampler.h>
+#include <swizzle/glsl/texture_cache.h>
+#include <swizzle/glsl/compressed_texture_sampler.h>
+#include <swizzle/glsl/pass_graph.h>
+#include <cstdio>
+
+using swizzle::glsl::texture_image;
+using swizzle::glsl::pixel_format;
+using swizzle::glsl::wrap_mode;
+using swizzle::glsl::texture_filter;
+using swizzle::glsl::texture_layout;
+using swizzle::glsl::texture_format;
+using swizzle::glsl::texture_target;
+using swizzle::glsl::texture_cache;
+using swizzle::glsl::compressed_texture_image;
+using swizzle::glsl::compressed_format;
+using swizzle::glsl::render_target;
+using swizzle::glsl::pass_graph;
+
+typedef swizzle::glsl::basic_sampler2D<float> sampler2D;
+typedef swizzle::glsl::basic_sampler3D<float> sampler3D;
+typedef swizzle::glsl::basic_samplerCube<float> samplerCube;
+typedef swizzle::glsl::basic_compressed_sampler2D<float> compressed_sampler2D;
+
+namespace
+{
+    //! 4x2, each texel has its x in red and y in green (as in 0..255 / 255).
+    std::shared_ptr<const texture_image> make_coords_texture()
+    {
+        std::vector<unsigned> texels;
+        for (unsigned y = 0; y < 2; ++y)
+        {
+            for (unsigned x = 0; x < 4; ++x)
+            {
+                texels.push_back(x | (y << 8) | 0xff000000u);
+            }
+        }
+        return std::make_shared<texture_image>(4, 2, texels);
+    }
+
+    vec4 texel(float x, float y)
+    {
+        return vec4(x / 255.0f, y / 255.0f, 0, 1);
+    }
+
+    vec4 unpack(unsigned texel)
+    {
+        return vec4(texel & 0xff, (texel >> 8) & 0xff, (texel >> 16) & 0xff, texel >> 24) / 255.0f;
+    }
+
+    //! Writes bits LSB first, as BCn blocks are laid out.
+    struct bit_writer
+    {
+        std::vector<uint8_t> bytes;
+        unsigned position;
+
+        explicit bit_writer(size_t size)
+            : bytes(size)
+            , position(0)
+        {}
+
+        bit_writer& operator()(unsigned value, unsigned bits)
+        {
+            for (unsigned i = 0; i < bits; ++i, ++position)
+            {
+                bytes[position / 8] |= ((value >> i) & 1u) << (position % 8);
+            }
+            return *this;
+        }
+    };
+
+    //! Samples the centre of each texel with nearest filtering.
+    template <class Func>
+    void for_each_texel(const std::shared_ptr<const compressed_texture_image>& image, Func func)
+    {
+        compressed_sampler2D sampler(image, wrap_mode::clamp);
+        for (unsigned y = 0; y < image->height(); ++y)
+        {
+            for (unsigned x = 0; x < image->width(); ++x)
+            {
+                func(x, y, texture(sampler, vec2((x + 0.5f) / image->width(), (y + 0.5f) / image->height())));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(Texture)
+
+BOOST_AUTO_TEST_CASE(decoding)
+{
+    // 2x2 BGR, top-down, rows padded to 8 bytes
+    const uint8_t bgr[] =
+    {
+        1, 2, 3,  4, 5, 6,  0, 0,
+        7, 8, 9,  10, 11, 12,  0, 0
+    };
+    pixel_format format = { 3, 0xff0000u, 0xff00u, 0xffu, 0 };
+    texture_image image(bgr, 2, 2, 8, format);
+
+    // bottom-up, RGBA, opaque
+    BOOST_CHECK_EQUAL( image.texel(0, 0), 0xff070809u );
+    BOOST_CHECK_EQUAL( image.texel(1, 0), 0xff0a0b0cu );
+    BOOST_CHECK_EQUAL( image.texel(0, 1), 0xff010203u );
+    BOOST_CHECK_EQUAL( image.texel(1, 1), 0xff040506u );
+
+    // narrow channels get expanded
+    const uint16_t rgb565[] = { 0xf800u, 0x07e0u, 0x0010u };
+    pixel_format format565 = { 2, 0xf800u, 0x07e0u, 0x001fu, 0 };
+    texture_image image565(rgb565, 3, 1, sizeof(rgb565), format565);
+    BOOST_CHECK_EQUAL( image565.texel(0, 0), 0xff0000ffu );
+    BOOST_CHECK_EQUAL( image565.texel(1, 0), 0xff00ff00u );
+    BOOST_CHECK_EQUAL( image565.texel(2, 0), 0xff840000u );
+
+    BOOST_CHECK_THROW( texture_image(2, 2, std::vector<unsigned>(3)), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(nearest)
+{
+    sampler2D sampler(make_coords_texture(), wrap_mode::clamp);
+
+    BOOST_CHECK( texture(sampler, vec2(0.125f, 0.25f)) == texel(0, 0) );
+    BOOST_CHECK( texture(sampler, vec2(0.374f, 0.74f)) == texel(1, 1) );
+    BOOST_CHECK( texture(sampler, vec2(0.376f, 0.74f)) == texel(1, 1) );
+    BOOST_CHECK( texture(sampler, vec2(0.9f, 0.1f)) == texel(3, 0) );
+
+    // edges
+    BOOST_CHECK( texture(sampler, vec2(1, 1)) == texel(3, 1) );
+    BOOST_CHECK( texture(sampler, vec2(-5, 7)) == texel(0, 1) );
+
+    BOOST_CHECK_THROW( sampler2D(std::make_shared<texture_image>(), wrap_mode::clamp), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(wrapping)
+{
+    sampler2D repeat(make_coords_texture(), wrap_mode::repeat);
+    BOOST_CHECK( texture(repeat, vec2(1.125f, 0.25f)) == texel(0, 0) );
+    BOOST_CHECK( texture(repeat, vec2(-0.125f, -0.25f)) == texel(3, 1) );
+
+    sampler2D mirror(make_coords_texture(), wrap_mode::mirror_repeat);
+    BOOST_CHECK( texture(mirror, vec2(0.125f, 0.25f)) == texel(0, 0) );
+    BOOST_CHECK( texture(mirror, vec2(1.125f, 1.25f)) == texel(3, 1) );
+    BOOST_CHECK( texture(mirror, vec2(-0.125f, -0.25f)) == texel(0, 0) );
+    BOOST_CHECK( texture(mirror, vec2(2.125f, 0.25f)) == texel(0, 0) );
+}
+
+BOOST_AUTO_TEST_CASE(mipmaps)
+{
+    // 3x2; odd sizes get clamped
+    texture_image image(3, 2, std::vector<unsigned>{ 0, 4, 8,  4, 8, 12 });
+    image.generate_mipmaps();
+
+    BOOST_REQUIRE_EQUAL( image.levels(), 2u );
+    BOOST_CHECK_EQUAL( image.width(1), 1u );
+    BOOST_CHECK_EQUAL( image.height(1), 1u );
+    BOOST_CHECK_EQUAL( image.level(1).offset, 6u );
+    BOOST_CHECK_EQUAL( image.texel(0, 0, 1), 4u );
+
+    texture_image square(4, 4, std::vector<unsigned>(16, 0x40404040u));
+    square.generate_mipmaps();
+    BOOST_CHECK_EQUAL( square.levels(), 3u );
+    BOOST_CHECK_EQUAL( square.texel(0, 0, 2), 0x40404040u );
+}
+
+BOOST_AUTO_TEST_CASE(linear)
+{
+    sampler2D sampler(make_coords_texture(), wrap_mode::clamp, texture_filter::linear, texture_filter::linear);
+
+    // texel centres
+    BOOST_CHECK( texture(sampler, vec2(0.125f, 0.25f)) == texel(0, 0) );
+    BOOST_CHECK( texture(sampler, vec2(0.625f, 0.75f)) == texel(2, 1) );
+    // halfway between texels
+    BOOST_CHECK( are_equal(texture(sampler, vec2(0.25f, 0.5f)), texel(0.5f, 0.5f), [](float a, float b) { return std::abs(a - b) < 1.0e-6f; }) );
+    // clamped
+    BOOST_CHECK( texture(sampler, vec2(0, 0)) == texel(0, 0) );
+
+    sampler2D repeat(make_coords_texture(), wrap_mode::repeat, texture_filter::linear, texture_filter::linear);
+    BOOST_CHECK( are_equal(texture(repeat, vec2(0, 0.25f)), texel(1.5f, 0), [](float a, float b) { return std::abs(a - b) < 1.0e-6f; }) );
+}
+
+BOOST_AUTO_TEST_CASE(lod)
+{
+    // level 0 texel sampled is black, level 1 is grey
+    auto image = std::make_shared<texture_image>(2, 2, std::vector<unsigned>{ 0, 0xffffffffu, 0xffffffffu, 0xffffffffu });
+    image->generate_mipmaps();
+    const vec4 black(0);
+    const vec4 grey(191 / 255.0f);
+
+    sampler2D nearest(image, wrap_mode::repeat, texture_filter::nearest_mipmap_nearest, texture_filter::nearest);
+    sampler2D linear(image, wrap_mode::repeat, texture_filter::linear_mipmap_linear, texture_filter::linear);
+    sampler2D no_mips(image, wrap_mode::repeat, texture_filter::linear, texture_filter::linear);
+
+    vec2 uv(0.25f, 0.25f);
+
+    // scalars have no lod of their own, so bias alone picks the level
+    BOOST_CHECK( texture(nearest, uv) == black );
+    BOOST_CHECK( texture(nearest, uv, 1.0f) == grey );
+    BOOST_CHECK( textureLod(nearest, uv, 0.4f) == black );
+    BOOST_CHECK( textureLod(nearest, uv, 0.6f) == grey );
+    BOOST_CHECK( textureLod(nearest, uv, 5.0f) == grey );
+    BOOST_CHECK( are_equal(textureLod(linear, uv, 0.25f), grey * 0.25f, [](float a, float b) { return std::abs(a - b) < 1.0e-6f; }) );
+    BOOST_CHECK( textureLod(linear, uv, -1.0f) == black );
+    BOOST_CHECK( textureLod(no_mips, uv, 1.0f) == black );
+
+    BOOST_CHECK_THROW( sampler2D(image, wrap_mode::clamp, texture_filter::linear, texture_filter::linear_mipmap_linear), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(texture_api)
+{
+    sampler2D sampler(make_coords_texture(), wrap_mode::clamp);
+
+    BOOST_CHECK( textureOffset(sampler, vec2(0.125f, 0.25f), ivec2(1, 1)) == texel(1, 1) );
+    BOOST_CHECK( textureOffset(sampler, vec2(0.125f, 0.25f), ivec2(-1, 0), 0.0f) == texel(0, 0) );
+    BOOST_CHECK( texelFetch(sampler, vec2(2, 1), 0) == texel(2, 1) );
+    BOOST_CHECK( texelFetch(sampler, vec2(7, -1), 0) == texel(3, 0) );
+    BOOST_CHECK( textureSize(sampler, 0) == ivec2(4, 2) );
+    // (0, 1), (1, 1), (1, 0), (0, 0)
+    BOOST_CHECK( textureGather(sampler, vec2(0.25f, 0.5f)) == vec4(0, 1, 1, 0) / 255.0f );
+    BOOST_CHECK( textureGather(sampler, vec2(0.25f, 0.5f), 1) == vec4(1, 1, 0, 0) / 255.0f );
+    BOOST_CHECK( textureGather(sampler, vec2(0.25f, 0.5f), 3) == vec4(1) );
+
+    // same as in the lod case: level 0 texel sampled is black, level 1 is grey
+    auto image = std::make_shared<texture_image>(2, 2, std::vector<unsigned>{ 0, 0xffffffffu, 0xffffffffu, 0xffffffffu });
+    image->generate_mipmaps();
+    sampler2D mipmapped(image, wrap_mode::repeat, texture_filter::nearest_mipmap_nearest, texture_filter::nearest);
+    const vec4 black(0);
+    const vec4 grey(191 / 255.0f);
+    vec2 uv(0.25f, 0.25f);
+
+    // the larger of the derivatives counts
+    BOOST_CHECK( textureGrad(mipmapped, uv, vec2(0.25f, 0), vec2(0, 0.25f)) == black );
+    BOOST_CHECK( textureGrad(mipmapped, uv, vec2(0.25f, 0), vec2(0, 1)) == grey );
+    BOOST_CHECK( texelFetch(mipmapped, vec2(0, 0), 1) == grey );
+    BOOST_CHECK( textureSize(mipmapped, 1) == ivec2(1, 1) );
+    BOOST_CHECK( textureSize(mipmapped, 7) == ivec2(1, 1) );
+}
+
+BOOST_AUTO_TEST_CASE(volume)
+{
+    // 2x2x2: x in red, z in green
+    std::vector<float> rgba;
+    for (unsigned z = 0; z < 2; ++z)
+    {
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            rgba.insert(rgba.end(), { static_cast<float>(i % 2), static_cast<float>(z), 0.0f, 1.0f });
+        }
+    }
+    auto image = std::make_shared<texture_image>(texture_target::texture_3d, 2, 2, 2, rgba, texture_format::rgba32f);
+
+    sampler3D nearest(image, wrap_mode::clamp);
+    BOOST_CHECK( texture(nearest, vec3(0.75f, 0.25f, 0.25f)) == vec4(1, 0, 0, 1) );
+    BOOST_CHECK( texture(nearest, vec3(0.25f, 0.25f, 0.75f)) == vec4(0, 1, 0, 1) );
+    BOOST_CHECK( textureOffset(nearest, vec3(0.25f, 0.25f, 0.25f), ivec3(1, 0, 1)) == vec4(1, 1, 0, 1) );
+    BOOST_CHECK( texelFetch(nearest, vec3(1, 0, 1), 0) == vec4(1, 1, 0, 1) );
+
+    sampler3D linear(image, wrap_mode::clamp, texture_filter::linear, texture_filter::linear);
+    BOOST_CHECK( texture(linear, vec3(0.25f, 0.25f, 0.5f)) == vec4(0, 0.5f, 0, 1) );
+    BOOST_CHECK( texture(linear, vec3(0.5f, 0.25f, 0.25f)) == vec4(0.5f, 0, 0, 1) );
+    sampler3D repeat(image, wrap_mode::repeat, texture_filter::linear, texture_filter::linear);
+    BOOST_CHECK( texture(repeat, vec3(0.25f, 0.25f, 0)) == vec4(0, 0.5f, 0, 1) );
+
+    // levels shrink in depth too
+    auto mipmapped = std::make_shared<texture_image>(*image);
+    mipmapped->generate_mipmaps();
+    BOOST_REQUIRE_EQUAL( mipmapped->levels(), 2u );
+    BOOST_CHECK_EQUAL( mipmapped->depth(1), 1u );
+    sampler3D mips(mipmapped, wrap_mode::clamp, texture_filter::nearest_mipmap_nearest);
+    BOOST_CHECK( textureLod(mips, vec3(0.25f), 1.0f) == vec4(0.5f, 0.5f, 0, 1) );
+    BOOST_CHECK( textureGrad(mips, vec3(0.25f), vec3(0, 0, 1), vec3(0)) == vec4(0.5f, 0.5f, 0, 1) );
+    BOOST_CHECK( textureSize(mips, 0) == ivec3(2, 2, 2) );
+    BOOST_CHECK( textureSize(mips, 1) == ivec3(1, 1, 1) );
+
+    BOOST_CHECK_THROW( sampler3D(make_coords_texture(), wrap_mode::clamp), std::invalid_argument );
+    BOOST_CHECK_THROW( texture_image(texture_target::texture_2d, 2, 2, 2, rgba, texture_format::rgba32f), std::invalid_argument );
+
+    // slices survive caching
+    texture_cache cache(".");
+    const std::string source = "no such dir/volume texture";
+    std::remove(cache.cache_path(source).c_str());
+    cache.load(source, [&]() { return *mipmapped; });
+    auto cached = cache.load(source, [&]() { return *mipmapped; });
+    BOOST_CHECK( cached->borrowed() );
+    BOOST_CHECK( cached->target() == texture_target::texture_3d );
+    BOOST_CHECK( textureLod(sampler3D(cached, wrap_mode::clamp, texture_filter::nearest_mipmap_nearest), vec3(0.75f), 0.0f) == vec4(1, 1, 0, 1) );
+    std::remove(cache.cache_path(source).c_str());
+}
+
+BOOST_AUTO_TEST_CASE(cube)
+{
+    // 2x2 faces: face index in red, x and y in green and blue
+    std::vector<float> rgba;
+    for (unsigned face = 0; face < 6; ++face)
+    {
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            rgba.insert(rgba.end(), { static_cast<float>(face), static_cast<float>(i % 2), static_cast<float>(i / 2), 1.0f });
+        }
+    }
+    auto image = std::make_shared<texture_image>(texture_target::texture_cube, 2, 2, 6, rgba, texture_format::rgba32f);
+    samplerCube sampler(image);
+
+    BOOST_CHECK( texture(sampler, vec3(1, 0.5f, 0.5f)) == vec4(0, 0, 0, 1) );
+    BOOST_CHECK( texture(sampler, vec3(1, -0.5f, -0.5f)) == vec4(0, 1, 1, 1) );
+    BOOST_CHECK( texture(sampler, vec3(-1, -0.5f, -0.5f)) == vec4(1, 0, 1, 1) );
+    BOOST_CHECK( texture(sampler, vec3(0.5f, 1, 0.5f)) == vec4(2, 1, 1, 1) );
+    BOOST_CHECK( texture(sampler, vec3(0.5f, -1, 0.5f)) == vec4(3, 1, 0, 1) );
+    BOOST_CHECK( texture(sampler, vec3(0.5f, 0.5f, 2)) == vec4(4, 1, 0, 1) );
+    BOOST_CHECK( texture(sampler, vec3(0.5f, -0.5f, -1)) == vec4(5, 0, 1, 1) );
+    BOOST_CHECK( textureGather(sampler, vec3(1, 0, 0), 1) == vec4(0, 1, 1, 0) );
+    // ties between major axes go to x, then y
+    BOOST_CHECK( texture(sampler, vec3(1, 1, 0.5f)) == vec4(0, 0, 0, 1) );
+    BOOST_CHECK( texture(sampler, vec3(-1, 0.5f, -1)) == vec4(1, 0, 0, 1) );
+    BOOST_CHECK( texture(sampler, vec3(0.5f, 1, 1)) == vec4(2, 1, 1, 1) );
+
+    // faces do not shrink in number
+    auto mipmapped = std::make_shared<texture_image>(*image);
+    mipmapped->generate_mipmaps();
+    BOOST_REQUIRE_EQUAL( mipmapped->levels(), 2u );
+    BOOST_CHECK_EQUAL( mipmapped->depth(1), 6u );
+    samplerCube mips(mipmapped, texture_filter::nearest_mipmap_nearest);
+    BOOST_CHECK( textureLod(mips, vec3(0, 0, -1), 1.0f) == vec4(5, 0.5f, 0.5f, 1) );
+    BOOST_CHECK( textureGrad(mips, vec3(0, 0, -1), vec3(2, 0, 0), vec3(0)) == vec4(5, 0.5f, 0.5f, 1) );
+    BOOST_CHECK( textureSize(mips, 1) == ivec2(1, 1) );
+
+    BOOST_CHECK_THROW( samplerCube(make_coords_texture(), texture_filter::nearest), std::invalid_argument );
+    BOOST_CHECK_THROW( texture_image(texture_target::texture_cube, 2, 1, 6, std::vector<float>(48), texture_format::rgba32f), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(tiled)
+{
+    // 6x5, so that tiles on the edges are partial
+    std::vector<unsigned> texels(30);
+    for (unsigned i = 0; i < texels.size(); ++i)
+    {
+        texels[i] = i * 0x01020304u;
+    }
+    auto linear = std::make_shared<texture_image>(6, 5, texels);
+    linear->generate_mipmaps();
+    auto tiled = std::make_shared<texture_image>(*linear);
+    tiled->set_layout(texture_layout::tiled);
+
+    BOOST_CHECK( tiled->layout() == texture_layout::tiled );
+    BOOST_CHECK_EQUAL( tiled->index(1, 1), 5u );
+    BOOST_CHECK_EQUAL( tiled->index(4, 0), 16u );
+    BOOST_CHECK_EQUAL( tiled->index(0, 4), 32u );
+    BOOST_CHECK_EQUAL( tiled->level(1).offset, 64u );
+
+    BOOST_REQUIRE_EQUAL( tiled->levels(), linear->levels() );
+    for (unsigned level = 0; level < linear->levels(); ++level)
+    {
+        for (unsigned y = 0; y < linear->height(level); ++y)
+        {
+            for (unsigned x = 0; x < linear->width(level); ++x)
+            {
+                BOOST_CHECK_EQUAL( tiled->texel(x, y, level), linear->texel(x, y, level) );
+            }
+        }
+    }
+
+    // mipmaps generated in tiled layout are the same
+    auto retiled = std::make_shared<texture_image>(6, 5, texels);
+    retiled->set_layout(texture_layout::tiled);
+    retiled->generate_mipmaps();
+    BOOST_CHECK_EQUAL( retiled->texel(1, 0, 1), linear->texel(1, 0, 1) );
+
+    sampler2D a(linear, wrap_mode::mirror_repeat, texture_filter::linear_mipmap_linear, texture_filter::linear);
+    sampler2D b(tiled, wrap_mode::mirror_repeat, texture_filter::linear_mipmap_linear, texture_filter::linear);
+    for (float v = -1.0f; v < 2.0f; v += 0.13f)
+    {
+        for (float u = -1.0f; u < 2.0f; u += 0.11f)
+        {
+            BOOST_CHECK( textureLod(a, vec2(u, v), u + v) == textureLod(b, vec2(u, v), u + v) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(formats)
+{
+    // 5x3, so that r8 texels do not end on a word boundary
+    std::vector<float> rgba;
+    for (unsigned i = 0; i < 15; ++i)
+    {
+        rgba.insert(rgba.end(), { i / 16.0f, 0.5f, 1.0f - i / 16.0f, 0.25f });
+    }
+    const vec4 expected(3 / 16.0f, 0.5f, 13 / 16.0f, 0.25f);
+    const vec2 uv(0.7f, 0.1f);
+
+    for (texture_format format : { texture_format::rgba32f, texture_format::rgba16f, texture_format::r8, texture_format::rgba8 })
+    {
+        auto image = std::make_shared<texture_image>(5, 3, rgba, format);
+        BOOST_CHECK( image->format() == format );
+        sampler2D sampler(image, wrap_mode::clamp);
+
+        switch (format)
+        {
+        case texture_format::rgba32f:
+        case texture_format::rgba16f:
+            // all exact in halves
+            BOOST_CHECK( texture(sampler, uv) == expected );
+            break;
+        case texture_format::r8:
+            BOOST_CHECK_CLOSE( texture(sampler, uv).x, expected.x, 0.5f );
+            BOOST_CHECK( vec3(texture(sampler, uv).yzw) == vec3(0, 0, 1) );
+            break;
+        default:
+            BOOST_CHECK( are_equal(texture(sampler, uv), expected, [](float a, float b) { return std::abs(a - b) <= 0.5f / 255.0f + 1.0e-6f; }) );
+            break;
+        }
+
+        // mipmaps and layout do not depend on the format
+        texture_image tiled(*image);
+        tiled.set_layout(texture_layout::tiled);
+        tiled.generate_mipmaps();
+        image->generate_mipmaps();
+        BOOST_REQUIRE_EQUAL( tiled.levels(), 3u );
+        for (unsigned y = 0; y < 3; ++y)
+        {
+            for (unsigned x = 0; x < 5; ++x)
+            {
+                BOOST_CHECK_EQUAL( tiled.texel(x, y), image->texel(x, y) );
+            }
+        }
+        BOOST_CHECK_EQUAL( tiled.texel(1, 0, 1), image->texel(1, 0, 1) );
+    }
+
+    // conversions
+    texture_image converted(5, 3, rgba, texture_format::rgba32f);
+    converted.set_format(texture_format::rgba16f);
+    BOOST_CHECK( converted.read(3, 0)[2] == 13 / 16.0f );
+    converted.set_format(texture_format::r8);
+    BOOST_CHECK_EQUAL( converted.texel(4, 2), 0xff0000dfu );
+
+    BOOST_CHECK_THROW( texture_image(2, 2, std::vector<float>(15), texture_format::rgba32f), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(large)
+{
+    // more texels than float can address exactly; single channel, so that it takes just 16 MB
+    const unsigned width = 4096, height = 4097;
+    auto level = texture_image::make_level(width, height, 1, 0, texture_layout::linear);
+    auto words = std::make_shared<std::vector<unsigned>>((texture_image::level_size(level) + 3) / 4 + 1);
+    auto image = std::make_shared<texture_image>(texture_target::texture_2d, std::vector<texture_image::level_info>{ level },
+        texture_layout::linear, texture_format::r8, words, words->data());
+    BOOST_REQUIRE( texture_image::level_size(level) > (1u << 24) );
+
+    auto value = [](unsigned x) { return (x * 7 + 3) & 0xff; };
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(words->data()) + static_cast<size_t>(height - 1) * width;
+    for (unsigned x = 0; x < width; ++x)
+    {
+        bytes[x] = static_cast<unsigned char>(value(x));
+    }
+
+    sampler2D sampler(image, wrap_mode::clamp);
+    for (unsigned x : { 0u, 1u, 2u, 4093u, 4094u, 4095u })
+    {
+        float expected = value(x) / 255.0f;
+        BOOST_CHECK_CLOSE( texelFetch(sampler, vec2(x, height - 1), 0).x, expected, 0.001f );
+        BOOST_CHECK_CLOSE( texture(sampler, vec2((x + 0.5f) / width, (height - 0.5f) / height)).x, expected, 0.001f );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cache)
+{
+    // the source does not exist, so it gets a zero stamp
+    const std::string source = "no such dir/cached texture.png";
+    texture_cache cache(".");
+    const std::string path = cache.cache_path(source);
+    BOOST_CHECK_EQUAL( path.substr(0, 21), "./cached_texture.png-" );
+    std::remove(path.c_str());
+
+    unsigned decoded = 0;
+    auto decode = [&]()
+    {
+        ++decoded;
+        texture_image image(6, 5, std::vector<float>(120, 0.5f), texture_format::rgba16f);
+        image.generate_mipmaps();
+        image.set_layout(texture_layout::tiled);
+        return image;
+    };
+
+    auto first = cache.load(source, decode);
+    auto second = texture_cache(".").load(source, decode);
+    BOOST_CHECK_EQUAL( decoded, 1u );
+    BOOST_CHECK( second->borrowed() );
+    BOOST_CHECK( second->format() == texture_format::rgba16f );
+    BOOST_CHECK( second->layout() == texture_layout::tiled );
+    BOOST_REQUIRE_EQUAL( second->levels(), 3u );
+    BOOST_CHECK_EQUAL( second->level(2).offset, first->level(2).offset );
+    BOOST_CHECK_EQUAL( second->texel(5, 4), first->texel(5, 4) );
+    sampler2D sampler(second, wrap_mode::repeat);
+    BOOST_CHECK( texture(sampler, vec2(0.3f, 0.6f)) == vec4(0.5f) );
+
+    // modifying a copy makes its texels owned
+    texture_image copy(*second);
+    copy.set_layout(texture_layout::linear);
+    BOOST_CHECK( !copy.borrowed() );
+    BOOST_CHECK_EQUAL( copy.texel(5, 4), first->texel(5, 4) );
+
+    // broken files get replaced
+    second.reset();
+    first.reset();
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    BOOST_REQUIRE( file );
+    std::fputs("junk", file);
+    std::fclose(file);
+    BOOST_CHECK( cache.load(source, decode)->borrowed() );
+    BOOST_CHECK_EQUAL( decoded, 2u );
+
+    // so do files with levels not matching the layout; here the middle one reaches past the texels
+    const uint64_t middle_offset = cache.load(source, decode)->level(1).offset;
+    BOOST_CHECK_EQUAL( decoded, 2u );
+    file = std::fopen(path.c_str(), "r+b");
+    BOOST_REQUIRE( file );
+    // the header is 56 bytes, levels are 32 bytes each and their offsets are 16 bytes in
+    const long offset_position = 56 + 1 * 32 + 16;
+    uint64_t offset = 0;
+    BOOST_REQUIRE( std::fseek(file, offset_position, SEEK_SET) == 0 && std::fread(&offset, sizeof(offset), 1, file) == 1 );
+    BOOST_REQUIRE_EQUAL( offset, middle_offset );
+    offset += 1 << 20;
+    BOOST_REQUIRE( std::fseek(file, offset_position, SEEK_SET) == 0 && std::fwrite(&offset, sizeof(offset), 1, file) == 1 );
+    std::fclose(file);
+    auto reloaded = cache.load(source, decode);
+    BOOST_CHECK_EQUAL( decoded, 3u );
+    BOOST_CHECK_EQUAL( reloaded->level(1).offset, middle_offset );
+    reloaded.reset();
+
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(texel_cache)
+{
+    std::vector<float> rgba(13 * 11 * 4);
+    for (size_t i = 0; i < rgba.size(); ++i)
+    {
+        rgba[i] = static_cast<float>(i % 17) / 16.0f;
+    }
+
+    for (texture_format format : { texture_format::rgba8, texture_format::r8, texture_format::rgba16f })
+    {
+        for (texture_layout layout : { texture_layout::linear, texture_layout::tiled })
+        {
+            auto image = std::make_shared<texture_image>(13, 11, rgba, format);
+            image->generate_mipmaps();
+            image->set_layout(layout);
+
+            sampler2D direct(image, wrap_mode::repeat, texture_filter::linear_mipmap_linear, texture_filter::linear);
+            sampler2D cached(image, wrap_mode::repeat, texture_filter::linear_mipmap_linear, texture_filter::linear);
+            cached.set_texel_cache(true);
+            for (float v = -0.5f; v < 1.5f; v += 0.07f)
+            {
+                for (float u = -0.5f; u < 1.5f; u += 0.05f)
+                {
+                    BOOST_CHECK( textureLod(cached, vec2(u, v), u * 2.0f) == textureLod(direct, vec2(u, v), u * 2.0f) );
+                }
+            }
+        }
+    }
+
+    // a bilinear footprint within a tile: a miss, then hits (a lookup per texel)
+    auto image = std::make_shared<texture_image>(8, 8, std::vector<float>(256, 0.5f), texture_format::rgba16f);
+    image->set_layout(texture_layout::tiled);
+    sampler2D sampler(image, wrap_mode::clamp, texture_filter::linear, texture_filter::linear);
+    sampler.set_texel_cache(true);
+    texture_image::cache_stats() = swizzle::detail::block_cache_stats();
+    BOOST_CHECK( texture(sampler, vec2(0.25f, 0.25f)) == vec4(0.5f) );
+    BOOST_CHECK_EQUAL( texture_image::cache_stats().misses, 1u );
+    BOOST_CHECK_EQUAL( texture_image::cache_stats().hits, 3u );
+    BOOST_CHECK_EQUAL( texture_image::cache_stats().hit_rate(), 3 / 4.0 );
+
+    // modified copies do not hit stale blocks: texel 4 is (4, 0) when linear, (0, 1) when tiled
+    std::vector<float> xs;
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        xs.insert(xs.end(), { static_cast<float>(i % 8), 0.0f, 0.0f, 1.0f });
+    }
+    texture_image linear(8, 8, xs, texture_format::rgba32f);
+    BOOST_CHECK_EQUAL( linear.cached_texel(4)[0], 4.0f );
+    texture_image tiled(linear);
+    tiled.set_layout(texture_layout::tiled);
+    BOOST_CHECK_EQUAL( tiled.cached_texel(4)[0], 0.0f );
+}
+
+BOOST_AUTO_TEST_CASE(passes)
+{
+    // a counts frames (feedback), b scales a's output of the same frame, c reads b; d is independent
+    auto a = std::make_shared<render_target>(4, 2);
+    auto b = std::make_shared<render_target>(4, 2);
+    auto d = std::make_shared<render_target>(3, 5);
+    std::unique_ptr<sampler2D> a_input, b_input;
+    std::vector<float> seen(2);
+
+    pass_graph graph;
+    pass_graph::pass pass_a = { "a", a, 0, [&]() { a_input.reset(new sampler2D(a->front(), wrap_mode::clamp)); },
+        [&](unsigned y)
+        {
+            for (unsigned x = 0; x < 4; ++x)
+            {
+                vec4 previous = texelFetch(*a_input, vec2(x, y), 0);
+                a->store(x, y, previous.x + 1, 0, 0, 1);
+            }
+        }, {} };
+    size_t index_a = graph.add(pass_a);
+    pass_graph::pass pass_b = { "b", b, 0, [&]() { a_input.reset(new sampler2D(a->front(), wrap_mode::clamp)); },
+        [&](unsigned y)
+        {
+            for (unsigned x = 0; x < 4; ++x)
+            {
+                b->store(x, y, texelFetch(*a_input, vec2(x, y), 0).x * 10, 0, 0, 1);
+            }
+        }, { index_a } };
+    size_t index_b = graph.add(pass_b);
+    pass_graph::pass pass_c = { "c", nullptr, 2, [&]() { b_input.reset(new sampler2D(b->front(), wrap_mode::clamp)); },
+        [&](unsigned y) { seen[y] = texelFetch(*b_input, vec2(3, y), 0).x; }, { index_b } };
+    size_t index_c = graph.add(pass_c);
+    pass_graph::pass pass_d = { "d", d, 0, nullptr, [&](unsigned y) { d->store(0, y, 1, 1, 1, 1); }, {} };
+    size_t index_d = graph.add(pass_d);
+
+    BOOST_REQUIRE_EQUAL( graph.waves().size(), 3u );
+    BOOST_CHECK( graph.waves()[0] == (std::vector<size_t>{ index_a, index_d }) );
+    BOOST_CHECK( graph.waves()[1] == std::vector<size_t>(1, index_b) );
+    BOOST_CHECK( graph.waves()[2] == std::vector<size_t>(1, index_c) );
+
+    graph.render_frame();
+    BOOST_CHECK( seen == (std::vector<float>{ 10, 10 }) );
+
+    // rows of a wave in any order
+    size_t calls = 0;
+    graph.render_frame([&](size_t count, const std::function<void(size_t)>& func)
+    {
+        ++calls;
+        for (size_t i = count; i-- > 0;)
+        {
+            func(i);
+        }
+    });
+    BOOST_CHECK_EQUAL( calls, 3u );
+    BOOST_CHECK( seen == (std::vector<float>{ 20, 20 }) );
+    BOOST_CHECK_EQUAL( d->front()->read(0, 4)[0], 1.0f );
+    BOOST_CHECK_EQUAL( b->front()->read(2, 1)[0], 20.0f );
+
+    pass_graph::pass cyclic = { "cyclic", nullptr, 1, nullptr, [](unsigned) {}, { 7 } };
+    BOOST_CHECK_THROW( graph.add(cyclic), std::invalid_argument );
+    BOOST_CHECK_THROW( render_target(0, 1), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(bc1)
+{
+    // red and blue, indices 0, 1, 2, 3 in every row
+    bit_writer block(8);
+    block(0xf800u, 16)(0x001fu, 16)(0xe4e4e4e4u, 32);
+    auto image = std::make_shared<compressed_texture_image>(compressed_format::bc1, 4, 4, 1, block.bytes.data(), 8);
+
+    for_each_texel(image, [&](unsigned x, unsigned y, const vec4& color)
+    {
+        const vec4 expected[] = { vec4(1, 0, 0, 1), vec4(0, 0, 1, 1), vec4(2 / 3.0f, 0, 1 / 3.0f, 1), vec4(1 / 3.0f, 0, 2 / 3.0f, 1) };
+        BOOST_CHECK( are_equal(color, expected[x], [](float a, float b) { return std::abs(a - b) < 1.0e-6f; }) );
+        BOOST_CHECK( are_equal(color, unpack(image->texel(x, y)), [](float a, float b) { return std::abs(a - b) <= 0.5f / 255.0f; }) );
+    });
+
+    // endpoints swapped: 1 colour in between and transparent black
+    bit_writer swapped(8);
+    swapped(0x001fu, 16)(0xf800u, 16)(0xe4e4e4e4u, 32);
+    image = std::make_shared<compressed_texture_image>(compressed_format::bc1, 4, 4, 1, swapped.bytes.data(), 8);
+    for_each_texel(image, [&](unsigned x, unsigned, const vec4& color)
+    {
+        const vec4 expected[] = { vec4(0, 0, 1, 1), vec4(1, 0, 0, 1), vec4(0.5f, 0, 0.5f, 1), vec4(0) };
+        BOOST_CHECK( color == expected[x] );
+    });
+
+    BOOST_CHECK_THROW( compressed_texture_image(compressed_format::bc1, 5, 4, 1, block.bytes.data(), 8), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(bc4)
+{
+    // 8 value mode; index of a texel is its number (mod 8), rows top-down
+    bit_writer block(8);
+    block(200, 8)(10, 8);
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        block(i % 8, 3);
+    }
+    // 6 value mode with the extremes
+    bit_writer block6(8);
+    block6(10, 8)(200, 8);
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        block6(i % 8, 3);
+    }
+
+    std::vector<uint8_t> blocks(block.bytes);
+    blocks.insert(blocks.end(), block6.bytes.begin(), block6.bytes.end());
+    auto image = std::make_shared<compressed_texture_image>(compressed_format::bc4, 8, 4, 1, blocks.data(), blocks.size());
+
+    for_each_texel(image, [&](unsigned x, unsigned y, const vec4& color)
+    {
+        unsigned index = ((3 - y) * 4 + x % 4) % 8;
+        float expected;
+        if (x < 4)
+        {
+            const float values[] = { 200, 10, 1210 / 7.0f, 1020 / 7.0f, 830 / 7.0f, 640 / 7.0f, 450 / 7.0f, 260 / 7.0f };
+            expected = values[index] / 255.0f;
+        }
+        else
+        {
+            const float values[] = { 10, 200, 48, 86, 124, 162, 0, 255 };
+            expected = values[index] / 255.0f;
+        }
+        BOOST_CHECK_CLOSE( color.x, expected, 1.0e-4f );
+        BOOST_CHECK( vec3(color.yzw) == vec3(0, 0, 1) );
+        BOOST_CHECK( std::abs(color.x - unpack(image->texel(x, y)).x) <= 0.5f / 255.0f );
+    });
+}
+
+BOOST_AUTO_TEST_CASE(bc7)
+{
+    // mode 6: single subset, RGBA 7 bits plus a p-bit per endpoint, 4 bit indices
+    bit_writer mode6(16);
+    mode6(1u << 6, 7);
+    mode6(127, 7)(0, 7)(0, 7)(127, 7)(64, 7)(64, 7)(127, 7)(127, 7);
+    mode6(1, 1)(0, 1);
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        mode6(i, i == 0 ? 3 : 4);
+    }
+
+    // mode 1: two subsets (partition 13: the top half is the first subset), shared p-bits, 3 bit indices
+    bit_writer mode1(16);
+    mode1(1u << 1, 2)(13, 6);
+    mode1(63, 6)(0, 6)(0, 6)(0, 6);
+    mode1(0, 6)(0, 6)(0, 6)(63, 6);
+    mode1(0, 6)(0, 6)(0, 6)(0, 6);
+    mode1(1, 1)(1, 1);
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        // anchors (0 and 15) have 2 bits only
+        mode1(i == 0 || i == 15 ? 3 : 7, i == 0 || i == 15 ? 2 : 3);
+    }
+
+    // mode 5: rotation swapping red and alpha, separate 2 bit colour and alpha indices
+    bit_writer mode5(16);
+    mode5(1u << 5, 6)(1, 2);
+    mode5(0, 7)(127, 7)(0, 7)(0, 7)(0, 7)(0, 7);
+    mode5(255, 8)(0, 8);
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        mode5(3, i == 0 ? 1 : 2);
+    }
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        mode5(0, i == 0 ? 1 : 2);
+    }
+
+    std::vector<uint8_t> blocks(mode6.bytes);
+    blocks.insert(blocks.end(), mode1.bytes.begin(), mode1.bytes.end());
+    blocks.insert(blocks.end(), mode5.bytes.begin(), mode5.bytes.end());
+    auto image = std::make_shared<compressed_texture_image>(compressed_format::bc7, 12, 4, 1, blocks.data(), blocks.size());
+
+    const unsigned weights[] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    for_each_texel(image, [&](unsigned x, unsigned y, const vec4& color)
+    {
+        unsigned i = (3 - y) * 4 + x % 4;
+        vec4 expected;
+        if (x < 4)
+        {
+            // endpoints with p-bits: red 255 -> 0, green 1 -> 254, blue 129 -> 128, alpha 255 -> 254
+            auto lerp = [&](unsigned a, unsigned b) { return static_cast<float>(((64 - weights[i]) * a + weights[i] * b + 32) >> 6) / 255.0f; };
+            expected = vec4(lerp(255, 0), lerp(1, 254), lerp(129, 128), lerp(255, 254));
+        }
+        else if (x < 8)
+        {
+            // with p-bits, endpoints are red 255 -> 2 in the top half and green 2 -> 255 in the bottom one, the rest 2
+            unsigned w = i == 0 || i == 15 ? 27 : 64;
+            unsigned fade = ((64 - w) * 255 + w * 2 + 32) >> 6;
+            unsigned rise = ((64 - w) * 2 + w * 255 + 32) >> 6;
+            expected = (i < 8 ? vec4(fade, 2, 2, 255) : vec4(2, rise, 2, 255)) / 255.0f;
+        }
+        else
+        {
+            // red of the second endpoint and alpha of the first, swapped; the anchor's index is 1 instead of 3
+            expected = vec4(1, 0, 0, i == 0 ? 84 / 255.0f : 1);
+        }
+        BOOST_CHECK( color == expected );
+        BOOST_CHECK( color == unpack(image->texel(x, y)) );
+    });
+}
+
+BOOST_AUTO_TEST_CASE(compressed_mipmaps)
+{
+    // 6x5: 2x2 blocks, then 3x2 and 1x1 levels of a block each; partial blocks and flipped rows everywhere
+    for (compressed_format format : { compressed_format::bc1, compressed_format::bc4, compressed_format::bc7 })
+    {
+        std::vector<uint8_t> blocks(format == compressed_format::bc7 ? 6 * 16 : 6 * 8);
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            blocks[i] = static_cast<uint8_t>(i * 97 + 13);
+        }
+        auto image = std::make_shared<compressed_texture_image>(format, 6, 5, 3, blocks.data(), blocks.size());
+        BOOST_CHECK_EQUAL( image->level(2).offset, 5u );
+
+        compressed_sampler2D sampler(image, wrap_mode::clamp, texture_filter::nearest_mipmap_nearest);
+        compressed_sampler2D cached(image, wrap_mode::clamp, texture_filter::nearest_mipmap_nearest);
+        cached.set_texel_cache(true);
+        for (unsigned level = 0; level < 3; ++level)
+        {
+            for (unsigned y = 0; y < image->height(level); ++y)
+            {
+                for (unsigned x = 0; x < image->width(level); ++x)
+                {
+                    vec2 uv((x + 0.5f) / image->width(level), (y + 0.5f) / image->height(level));
+                    vec4 expected = unpack(image->texel(x, y, level));
+                    if (format == compressed_format::bc4)
+                    {
+                        expected = vec4(expected.x, 0, 0, 1);
+                    }
+                    BOOST_CHECK( are_equal(textureLod(sampler, uv, static_cast<float>(level)), expected, [](float a, float b) { return std::abs(a - b) <= 0.5f / 255.0f; }) );
+                    BOOST_CHECK( textureLod(cached, uv, static_cast<float>(level)) == expected );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+// CxxSwizzle
+// Copyright (c) 2013-2015, Piotr Gwiazdowski <gwiazdorrr+github at gmail.com>
+
+#include <boost/test/unit_test.hpp>
+#include <type_traits>
+#include "setup.h"
+#include <swizzle/detail/primitive_wrapper.h>
+#include <swizzle/detail/uniform_wrapper.h>
+
+// A varying of a single lane stands in for SIMD types, so that uniforms can be tested without Vc.
+typedef swizzle::detail::primitive_wrapper<double, float> varying_float;
+typedef swizzle::detail::uniform_wrapper<varying_float> uniform_float;
+
+namespace
+{
+    float value_of(const varying_float& x)
+    {
+        return static_cast<float>(static_cast<double>(x));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(Uniforms)
+
+BOOST_AUTO_TEST_CASE(uniforms_stay_scalar)
+{
+    uniform_float a(3), b(2);
+
+    static_assert(std::is_same<decltype(a + b), uniform_float>::value, "uniform + uniform is uniform");
+    static_assert(std::is_same<decltype(a * 2.0f), uniform_float>::value, "uniform * literal is uniform");
+    static_assert(std::is_same<decltype(2.0f - a), uniform_float>::value, "literal - uniform is uniform");
+    static_assert(std::is_same<decltype(a < b), bool>::value, "comparisons of uniforms are real bools");
+
+    BOOST_CHECK( static_cast<float>(a + b) == 5 );
+    BOOST_CHECK( static_cast<float>(a - b) == 1 );
+    BOOST_CHECK( static_cast<float>(a * b) == 6 );
+    BOOST_CHECK( static_cast<float>(a / b) == 1.5f );
+    BOOST_CHECK( static_cast<float>(a * 2.0f) == 6 );
+    BOOST_CHECK( static_cast<float>(2.0f - a) == -1 );
+
+    uniform_float c = a;
+    c += b;
+    c *= b;
+    BOOST_CHECK( static_cast<float>(c) == 10 );
+}
+
+BOOST_AUTO_TEST_CASE(mixed_arithmetic)
+{
+    uniform_float u(3);
+    varying_float v(2.0f);
+
+    static_assert(std::is_same<decltype(u + v), varying_float>::value, "uniform + varying is varying");
+    static_assert(std::is_same<decltype(v + u), varying_float>::value, "varying + uniform is varying");
+
+    BOOST_CHECK( value_of(u + v) == 5 );
+    BOOST_CHECK( value_of(v + u) == 5 );
+    BOOST_CHECK( value_of(u - v) == 1 );
+    BOOST_CHECK( value_of(v - u) == -1 );
+    BOOST_CHECK( value_of(u * v) == 6 );
+    BOOST_CHECK( value_of(v * u) == 6 );
+    BOOST_CHECK( value_of(u / v) == 1.5f );
+    BOOST_CHECK( value_of(v / u) == 2.0f / 3 );
+}
+
+BOOST_AUTO_TEST_CASE(mixed_comparisons)
+{
+    uniform_float u(3);
+    varying_float less(2.0f), same(3.0f), greater(4.0f);
+
+    static_assert(std::is_same<decltype(u <= less), varying_float::bool_type>::value, "uniform <= varying is a varying bool");
+    static_assert(std::is_same<decltype(less == u), varying_float::bool_type>::value, "varying == uniform is a varying bool");
+
+    BOOST_CHECK( (u > less) && !(u > same) && !(less > u) && (greater > u) );
+    BOOST_CHECK( (u < greater) && !(u < same) && !(greater < u) && (less < u) );
+    BOOST_CHECK( (u >= less) && (u >= same) && !(u >= greater) );
+    BOOST_CHECK( (greater >= u) && (same >= u) && !(less >= u) );
+    BOOST_CHECK( (u <= greater) && (u <= same) && !(u <= less) );
+    BOOST_CHECK( (less <= u) && (same <= u) && !(greater <= u) );
+    BOOST_CHECK( (u == same) && !(u == less) );
+    BOOST_CHECK( (same == u) && !(greater == u) );
+    BOOST_CHECK( (u != less) && !(u != same) );
+    BOOST_CHECK( (greater != u) && !(same != u) );
+}
+
+BOOST_AUTO_TEST_CASE(uniform_branch)
+{
+    uniform_float time(2), threshold(1);
+    varying_float x(5.0f);
+
+    // a condition of uniforms alone is a plain bool, so the same path is taken for all the lanes
+    varying_float result = x;
+    if (time > threshold)
+    {
+        result = x * time;
+    }
+    else
+    {
+        result = x - time;
+    }
+    BOOST_CHECK( value_of(result) == 10 );
+
+    if (time * 0.25f >= threshold)
+    {
+        result = x;
+    }
+    BOOST_CHECK( value_of(result) == 10 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()